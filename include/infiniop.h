@@ -3,17 +3,25 @@
 
 #include "infiniop/handle.h"
 #include "infiniop/ops/add.h"
+#include "infiniop/ops/add_rms_norm.h"
 #include "infiniop/ops/attention.h"
 #include "infiniop/ops/causal_softmax.h"
 #include "infiniop/ops/clip.h"
 #include "infiniop/ops/conv.h"
+#include "infiniop/ops/gather.h"
 #include "infiniop/ops/gemm.h"
+#include "infiniop/ops/kv_cache_attention.h"
+#include "infiniop/ops/layer_norm.h"
 #include "infiniop/ops/mul.h"
 #include "infiniop/ops/random_sample.h"
 #include "infiniop/ops/rearrange.h"
 #include "infiniop/ops/relu.h"
 #include "infiniop/ops/rms_norm.h"
+#include "infiniop/ops/rms_norm_quant.h"
 #include "infiniop/ops/rope.h"
+#include "infiniop/ops/rope_kv_cache.h"
+#include "infiniop/ops/scatter.h"
+#include "infiniop/ops/softmax.h"
 #include "infiniop/ops/sub.h"
 #include "infiniop/ops/swiglu.h"
 #include "infiniop/tensor_descriptor.h"
@@ -11,6 +11,27 @@ __C __export infiniStatus_t infiniopCreateCausalSoftmaxDescriptor(
     infiniopTensorDescriptor_t y_desc,
     infiniopTensorDescriptor_t x_desc);
 
+/**
+ * Causal softmax with optional sliding-window and bias masking.
+ *
+ * - bias_desc: optional additive bias with the dtype of x, shaped [seq_len, total_seq_len]
+ *   or [batch, seq_len, total_seq_len]; pass null for no bias.
+ * - scale: multiplies x before the bias is added, e.g. to fold the 1/sqrt(head_dim) of attention in.
+ * - window: number of most recent positions (including itself) each row attends to, 0 for unlimited.
+ *   Positions outside the window are skipped and written as 0.
+ * - alibi_max_bias: adds the ALiBi bias slope * (j - i) with per-head slopes derived from this
+ *   maximum bias, treating the batch dimension as heads; 0 disables ALiBi.
+ */
+__C __export infiniStatus_t infiniopCreateCausalSoftmaxExDescriptor(
+    infiniopHandle_t handle,
+    infiniopCausalSoftmaxDescriptor_t *desc_ptr,
+    infiniopTensorDescriptor_t y_desc,
+    infiniopTensorDescriptor_t x_desc,
+    infiniopTensorDescriptor_t bias_desc,
+    float scale,
+    size_t window,
+    float alibi_max_bias);
+
 __C __export infiniStatus_t infiniopGetCausalSoftmaxWorkspaceSize(infiniopCausalSoftmaxDescriptor_t desc, size_t *size);
 
 __C __export infiniStatus_t infiniopCausalSoftmax(
@@ -21,6 +42,15 @@ __C __export infiniStatus_t infiniopCausalSoftmax(
     const void *x,
     void *stream);
 
+__C __export infiniStatus_t infiniopCausalSoftmaxEx(
+    infiniopCausalSoftmaxDescriptor_t desc,
+    void *workspace,
+    size_t workspace_size,
+    void *y,
+    const void *x,
+    const void *bias,
+    void *stream);
+
 __C __export infiniStatus_t infiniopDestroyCausalSoftmaxDescriptor(infiniopCausalSoftmaxDescriptor_t desc);
 
 #endif
@@ -5,6 +5,33 @@
 
 typedef struct InfiniopDescriptor *infiniopConvDescriptor_t;
 
+/// How the weights passed to `infiniopConv` change between calls.
+typedef enum {
+    /// The weights may change between calls and are preprocessed on every call.
+    INFINIOP_CONV_WEIGHT_HINT_DEFAULT = 0,
+    /// The weights at a given address are not modified between calls.
+    /// Backends may keep preprocessed weights (packed GEMM panels, Winograd
+    /// filter transforms) in the descriptor and reuse them while the address
+    /// stays the same.
+    INFINIOP_CONV_WEIGHT_HINT_CONSTANT = 1,
+} infiniopConvWeightHint_t;
+
+/// Activation applied to the convolution output after the bias is added.
+typedef enum {
+    INFINIOP_CONV_ACTIVATION_NONE = 0,
+    /// max(x, 0)
+    INFINIOP_CONV_ACTIVATION_RELU = 1,
+    /// x * sigmoid(x)
+    INFINIOP_CONV_ACTIVATION_SILU = 2,
+} infiniopConvActivation_t;
+
+/// Creates an `n`-D convolution descriptor.
+/// `x` and `y` must be contiguous, either channels-first (NCHW) or
+/// channels-last (NHWC, with dims still ordered [batch, channels, spatial...]);
+/// both use the same layout. `w` is a contiguous
+/// [out_channels, in_channels / groups, kernel...] tensor. `groups` splits the
+/// channels into independent groups: 1 for an ordinary convolution,
+/// in_channels for a depthwise one.
 __C __export infiniStatus_t infiniopCreateConvDescriptor(infiniopHandle_t handle,
                                                          infiniopConvDescriptor_t *desc_ptr,
                                                          infiniopTensorDescriptor_t y_desc,
@@ -14,7 +41,16 @@ __C __export infiniStatus_t infiniopCreateConvDescriptor(infiniopHandle_t handle
                                                          void *pads,
                                                          void *strides,
                                                          void *dilations,
-                                                         size_t n);
+                                                         size_t n,
+                                                         size_t groups);
+
+/// Sets the weight hint used by later calls to `infiniopConv`.
+/// Setting a hint discards any weights cached under the previous one.
+__C __export infiniStatus_t infiniopSetConvWeightHint(infiniopConvDescriptor_t desc, infiniopConvWeightHint_t hint);
+
+/// Sets the activation fused into later calls to `infiniopConv`.
+/// Returns `INFINI_STATUS_NOT_IMPLEMENTED` if the backend cannot fuse it.
+__C __export infiniStatus_t infiniopSetConvActivation(infiniopConvDescriptor_t desc, infiniopConvActivation_t activation);
 
 __C __export infiniStatus_t infiniopGetConvWorkspaceSize(infiniopConvDescriptor_t desc, size_t *size);
 
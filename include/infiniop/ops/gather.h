@@ -0,0 +1,35 @@
+#ifndef __INFINIOP_GATHER_API_H__
+#define __INFINIOP_GATHER_API_H__
+
+#include "../operator_descriptor.h"
+
+typedef struct InfiniopDescriptor *infiniopGatherDescriptor_t;
+
+/**
+ * Index select along `axis`: y[..., i, ...] = x[..., indices[i], ...].
+ *
+ * - indices_desc: 1-D I32 or I64 tensor of n indices into dimension `axis` of x.
+ * - y has the shape of x except that dimension `axis` has length n.
+ * - axis: negative values count from the end.
+ *
+ * Typical use is token embedding lookup with x = [vocab, hidden] and axis = 0.
+ * `infiniopGather` returns INFINI_STATUS_BAD_PARAM, without writing y, if any index is out of range.
+ */
+__C __export infiniStatus_t infiniopCreateGatherDescriptor(
+    infiniopHandle_t handle,
+    infiniopGatherDescriptor_t *desc_ptr,
+    infiniopTensorDescriptor_t y_desc,
+    infiniopTensorDescriptor_t x_desc,
+    infiniopTensorDescriptor_t indices_desc,
+    int axis);
+
+__C __export infiniStatus_t infiniopGather(
+    infiniopGatherDescriptor_t desc,
+    void *y,
+    const void *x,
+    const void *indices,
+    void *stream);
+
+__C __export infiniStatus_t infiniopDestroyGatherDescriptor(infiniopGatherDescriptor_t desc);
+
+#endif
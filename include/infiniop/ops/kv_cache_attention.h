@@ -0,0 +1,58 @@
+#ifndef __INFINIOP_KV_CACHE_ATTENTION_API_H__
+#define __INFINIOP_KV_CACHE_ATTENTION_API_H__
+
+#include "../operator_descriptor.h"
+
+typedef struct InfiniopDescriptor *infiniopKVCacheAttentionDescriptor_t;
+
+/**
+ * Attention over a KV cache with the cache-append step fused in.
+ *
+ * - out:     [seq_len, n_q_head, head_dim]
+ * - q:       [n_q_head, seq_len, head_dim]
+ * - k, v:    [n_kv_head, seq_len, head_dim]
+ * - k_cache: [n_kv_head, cache_len, head_dim], cache_len >= pos + seq_len
+ * - v_cache: [n_kv_head, cache_len, head_dim]
+ *
+ * The caches either share the dtype of q, or are quantized (I8 or F8 E4M3).
+ * Quantized caches need F32 scale tensors k_scale/v_scale of shape [n_kv_head, cache_len]:
+ * a zero stride on the last dimension selects a static per-head scale, otherwise a
+ * per-token scale is computed and written when new tokens are appended.
+ * Scale descriptors must be null for unquantized caches.
+ *
+ * window limits each token to the most recent `window` cache positions (0 for unlimited);
+ * cache blocks outside the window are skipped. alibi_max_bias > 0 adds ALiBi biases with
+ * per-head slopes over the query heads.
+ */
+__C __export infiniStatus_t infiniopCreateKVCacheAttentionDescriptor(infiniopHandle_t handle,
+                                                                     infiniopKVCacheAttentionDescriptor_t *desc_ptr,
+                                                                     infiniopTensorDescriptor_t out_desc,
+                                                                     infiniopTensorDescriptor_t q_desc,
+                                                                     infiniopTensorDescriptor_t k_desc,
+                                                                     infiniopTensorDescriptor_t v_desc,
+                                                                     infiniopTensorDescriptor_t k_cache_desc,
+                                                                     infiniopTensorDescriptor_t v_cache_desc,
+                                                                     infiniopTensorDescriptor_t k_scale_desc,
+                                                                     infiniopTensorDescriptor_t v_scale_desc,
+                                                                     size_t pos,
+                                                                     size_t window,
+                                                                     float alibi_max_bias);
+
+__C __export infiniStatus_t infiniopGetKVCacheAttentionWorkspaceSize(infiniopKVCacheAttentionDescriptor_t desc, size_t *size);
+
+__C __export infiniStatus_t infiniopKVCacheAttention(infiniopKVCacheAttentionDescriptor_t desc,
+                                                     void *workspace,
+                                                     size_t workspace_size,
+                                                     void *out,
+                                                     const void *q,
+                                                     const void *k,
+                                                     const void *v,
+                                                     void *k_cache,
+                                                     void *v_cache,
+                                                     void *k_scale,
+                                                     void *v_scale,
+                                                     void *stream);
+
+__C __export infiniStatus_t infiniopDestroyKVCacheAttentionDescriptor(infiniopKVCacheAttentionDescriptor_t desc);
+
+#endif
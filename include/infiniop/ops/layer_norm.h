@@ -0,0 +1,45 @@
+#ifndef __INFINIOP_LAYER_NORM_API_H__
+#define __INFINIOP_LAYER_NORM_API_H__
+
+#include "../operator_descriptor.h"
+
+typedef struct InfiniopDescriptor *infiniopLayerNormDescriptor_t;
+
+/**
+ * Layer normalization over the last dimension, with an optional fused residual add:
+ *
+ *   h = residual ? (residual_out = x + residual) : x
+ *   y = (h - mean(h)) / sqrt(var(h) + epsilon) * w + b
+ *
+ * Activation/weight dtypes follow infiniopCreateRMSNormDescriptor; b has the dtype and shape of w.
+ * b_desc may be null for no bias. residual_desc and residual_out_desc are both null or both given,
+ * with the dtype and shape of x; residual_out may alias x or residual.
+ */
+__C __export infiniStatus_t infiniopCreateLayerNormDescriptor(
+    infiniopHandle_t handle,
+    infiniopLayerNormDescriptor_t *desc_ptr,
+    infiniopTensorDescriptor_t y_desc,
+    infiniopTensorDescriptor_t residual_out_desc,
+    infiniopTensorDescriptor_t x_desc,
+    infiniopTensorDescriptor_t residual_desc,
+    infiniopTensorDescriptor_t w_desc,
+    infiniopTensorDescriptor_t b_desc,
+    float epsilon);
+
+__C __export infiniStatus_t infiniopGetLayerNormWorkspaceSize(infiniopLayerNormDescriptor_t desc, size_t *size);
+
+__C __export infiniStatus_t infiniopLayerNorm(
+    infiniopLayerNormDescriptor_t desc,
+    void *workspace,
+    size_t workspace_size,
+    void *y,
+    void *residual_out,
+    const void *x,
+    const void *residual,
+    const void *w,
+    const void *b,
+    void *stream);
+
+__C __export infiniStatus_t infiniopDestroyLayerNormDescriptor(infiniopLayerNormDescriptor_t desc);
+
+#endif
@@ -5,6 +5,10 @@
 
 typedef struct InfiniopDescriptor *infiniopRandomSampleDescriptor_t;
 
+/**
+ * Samples token ids from logits. probs is either a contiguous [voc] vector with a scalar result,
+ * or [batch, voc] (contiguous rows) with a [batch] result to sample every row in one call.
+ */
 __C __export infiniStatus_t infiniopCreateRandomSampleDescriptor(
     infiniopHandle_t handle,
     infiniopRandomSampleDescriptor_t *desc_ptr,
@@ -27,6 +31,47 @@ __C __export infiniStatus_t infiniopRandomSample(
     float temperature,
     void *stream);
 
+// Logit processing of one row, applied while the logits are scanned. Zero-initialise to disable
+// everything. Each raw logit x gets, in order:
+//   x += bias;  x = x > 0 ? x / repetition_penalty : x * repetition_penalty (tokens seen only);
+//   x -= frequency_penalty * count + presence_penalty (tokens seen only);  x /= temperature
+// min_p then drops tokens whose probability is below min_p times that of the most likely token.
+typedef struct {
+    // Previously generated token ids, repeats count towards the frequency penalty.
+    const int *token_ids;
+    size_t num_tokens;
+    // 0 or 1 disables the repetition penalty.
+    float repetition_penalty;
+    float frequency_penalty;
+    float presence_penalty;
+    // Sparse logit bias: bias_values[i] is added to the logit of bias_token_ids[i].
+    const int *bias_token_ids;
+    const float *bias_values;
+    size_t num_bias;
+    float min_p;
+} infiniopLogitsProcessor_t;
+
+/**
+ * Batched sampling with per-row parameters. random_val, topp, topk and temperature are arrays of
+ * batch elements in the memory of the descriptor's device. A row whose random_val, topp or
+ * temperature is 0, or whose topk is 1, takes the argmax, so greedy and stochastic rows can be
+ * mixed in one call. infiniopRandomSample applies the same parameters to every row.
+ * processors is null or an array of batch logit processors, whose token id lists live in the
+ * same memory; processing also applies to argmax rows.
+ */
+__C __export infiniStatus_t infiniopRandomSampleBatched(
+    infiniopRandomSampleDescriptor_t desc,
+    void *workspace,
+    size_t workspace_size,
+    void *result,
+    const void *probs,
+    const float *random_val,
+    const float *topp,
+    const int *topk,
+    const float *temperature,
+    const infiniopLogitsProcessor_t *processors,
+    void *stream);
+
 __C __export infiniStatus_t infiniopDestroyRandomSampleDescriptor(
     infiniopRandomSampleDescriptor_t desc);
 
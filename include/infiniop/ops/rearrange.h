@@ -5,12 +5,33 @@
 
 typedef struct InfiniopDescriptor *infiniopRearrangeDescriptor_t;
 
+/// Store policy for the destination of a rearrange.
+typedef enum {
+    /// Stream (bypass the cache) when the destination is larger than the
+    /// library threshold, which can be overridden by the
+    /// `INFINI_STREAMING_THRESHOLD` environment variable (in bytes).
+    INFINIOP_REARRANGE_HINT_DEFAULT = 0,
+    /// Always stream: the destination will not be read again soon.
+    INFINIOP_REARRANGE_HINT_STREAMING = 1,
+    /// Never stream: the destination is consumed right away.
+    INFINIOP_REARRANGE_HINT_CACHED = 2,
+} infiniopRearrangeHint_t;
+
+/// Creates a descriptor copying `src` into the layout of `dst`.
+/// On CPU, `dst` and `src` may have different floating-point dtypes
+/// (F16, BF16 or F32); elements are converted during the copy.
 __C __export infiniStatus_t infiniopCreateRearrangeDescriptor(
     infiniopHandle_t handle,
     infiniopRearrangeDescriptor_t *desc_ptr,
     infiniopTensorDescriptor_t dst,
     infiniopTensorDescriptor_t src);
 
+/// Sets the store policy used by later calls to `infiniopRearrange`.
+/// Backends without streaming stores ignore the hint.
+__C __export infiniStatus_t infiniopSetRearrangeHint(
+    infiniopRearrangeDescriptor_t desc,
+    infiniopRearrangeHint_t hint);
+
 __C __export infiniStatus_t infiniopRearrange(
     infiniopRearrangeDescriptor_t desc,
     void *dst,
@@ -0,0 +1,40 @@
+#ifndef __INFINIOP_RMS_NORM_QUANT_API_H__
+#define __INFINIOP_RMS_NORM_QUANT_API_H__
+
+#include "../operator_descriptor.h"
+
+typedef struct InfiniopDescriptor *infiniopRMSNormQuantDescriptor_t;
+
+/**
+ * RMS normalization with per-row symmetric quantization of the output:
+ *
+ *   n = x / sqrt(mean(x^2) + epsilon) * w
+ *   scale[i] = max(|n[i]|) / QMAX,  y[i] = round(n[i] / scale[i])
+ *
+ * x/w follow infiniopCreateRMSNormDescriptor. y has the shape of x with dtype I8 (QMAX = 127)
+ * or F8 e4m3 (QMAX = 448); scale is an F32 tensor of shape [batch].
+ */
+__C __export infiniStatus_t infiniopCreateRMSNormQuantDescriptor(
+    infiniopHandle_t handle,
+    infiniopRMSNormQuantDescriptor_t *desc_ptr,
+    infiniopTensorDescriptor_t y_desc,
+    infiniopTensorDescriptor_t scale_desc,
+    infiniopTensorDescriptor_t x_desc,
+    infiniopTensorDescriptor_t w_desc,
+    float epsilon);
+
+__C __export infiniStatus_t infiniopGetRMSNormQuantWorkspaceSize(infiniopRMSNormQuantDescriptor_t desc, size_t *size);
+
+__C __export infiniStatus_t infiniopRMSNormQuant(
+    infiniopRMSNormQuantDescriptor_t desc,
+    void *workspace,
+    size_t workspace_size,
+    void *y,
+    void *scale,
+    const void *x,
+    const void *w,
+    void *stream);
+
+__C __export infiniStatus_t infiniopDestroyRMSNormQuantDescriptor(infiniopRMSNormQuantDescriptor_t desc);
+
+#endif
@@ -5,6 +5,13 @@
 
 typedef struct InfiniopDescriptor *infiniopRoPEDescriptor_t;
 
+typedef enum {
+    // Rotates the interleaved pairs (x[2i], x[2i + 1]).
+    INFINIOP_ROPE_ALGO_GPT_J = 0,
+    // Rotates the half-split pairs (x[i], x[i + dhead / 2]).
+    INFINIOP_ROPE_ALGO_GPT_NEOX = 1,
+} infiniopRoPEAlgo_t;
+
 __C __export infiniStatus_t infiniopCreateRoPEDescriptor(
     infiniopHandle_t handle,
     infiniopRoPEDescriptor_t *desc_ptr,
@@ -14,6 +21,59 @@ __C __export infiniStatus_t infiniopCreateRoPEDescriptor(
     infiniopTensorDescriptor_t sin_table,
     infiniopTensorDescriptor_t cos_table);
 
+typedef enum {
+    INFINIOP_ROPE_SCALING_NONE = 0,
+    // Position interpolation: all frequencies are divided by factor.
+    INFINIOP_ROPE_SCALING_LINEAR = 1,
+    // NTK-aware scaling: base becomes theta * factor^(dhead / (dhead - 2)).
+    INFINIOP_ROPE_SCALING_NTK = 2,
+    // YaRN: high frequencies are kept, low frequencies are interpolated, with a linear ramp in between.
+    INFINIOP_ROPE_SCALING_YARN = 3,
+} infiniopRoPEScalingType_t;
+
+typedef struct {
+    infiniopRoPEScalingType_t type;
+    float factor;
+    // YaRN only: context length the model was trained with.
+    size_t original_max_position_embeddings;
+    // YaRN only: rotation counts bounding the ramp, 0 for the defaults 32 and 1.
+    float beta_fast, beta_slow;
+    // Multiplier applied to sin and cos, 0 for the default (0.1 * ln(factor) + 1 for YaRN, 1 otherwise).
+    float attention_factor;
+} infiniopRoPEScaling_t;
+
+/**
+ * RoPE without precomputed tables: the rotation angle pos * theta^(-2i / dhead) is computed
+ * in the kernel. scaling may be null for plain RoPE.
+ * Use infiniopRoPE with null sin_table and cos_table to run the descriptor.
+ */
+__C __export infiniStatus_t infiniopCreateRoPEThetaDescriptor(
+    infiniopHandle_t handle,
+    infiniopRoPEDescriptor_t *desc_ptr,
+    infiniopTensorDescriptor_t y,
+    infiniopTensorDescriptor_t x,
+    infiniopTensorDescriptor_t pos_ids,
+    float theta,
+    const infiniopRoPEScaling_t *scaling);
+
+/**
+ * RoPE with every option: sin_table and cos_table may both be null to compute the angles
+ * from theta and scaling as in infiniopCreateRoPEThetaDescriptor (theta is ignored otherwise),
+ * and algo selects how the dimensions of a head are paired.
+ * The tables are indexed by pair in both layouts: [table_len, dhead / 2].
+ */
+__C __export infiniStatus_t infiniopCreateRoPEExDescriptor(
+    infiniopHandle_t handle,
+    infiniopRoPEDescriptor_t *desc_ptr,
+    infiniopTensorDescriptor_t y,
+    infiniopTensorDescriptor_t x,
+    infiniopTensorDescriptor_t pos_ids,
+    infiniopTensorDescriptor_t sin_table,
+    infiniopTensorDescriptor_t cos_table,
+    float theta,
+    const infiniopRoPEScaling_t *scaling,
+    infiniopRoPEAlgo_t algo);
+
 __C __export infiniStatus_t infiniopGetRoPEWorkspaceSize(infiniopRoPEDescriptor_t desc, size_t *size);
 
 __C __export infiniStatus_t infiniopRoPE(
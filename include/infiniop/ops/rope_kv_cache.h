@@ -0,0 +1,73 @@
+#ifndef __INFINIOP_ROPE_KV_CACHE_API_H__
+#define __INFINIOP_ROPE_KV_CACHE_API_H__
+
+#include "../operator_descriptor.h"
+#include "rope.h"
+
+typedef struct InfiniopDescriptor *infiniopRoPEKVCacheDescriptor_t;
+
+/**
+ * RoPE on q and k fused with the KV-cache append.
+ *
+ * - q:       [seq_len, n_q_head, head_dim], rotated in place
+ * - k, v:    [seq_len, n_kv_head, head_dim], read only
+ * - k_cache: [n_kv_head, cache_len, head_dim], cache_len >= pos + seq_len
+ * - v_cache: [n_kv_head, cache_len, head_dim]
+ * - pos_ids, sin_table, cos_table: as in infiniopRoPE
+ *
+ * The rotated k and the unchanged v of token i are written to cache position pos + i.
+ * The cache layout matches infiniopAttention and infiniopKVCacheAttention.
+ */
+__C __export infiniStatus_t infiniopCreateRoPEKVCacheDescriptor(
+    infiniopHandle_t handle,
+    infiniopRoPEKVCacheDescriptor_t *desc_ptr,
+    infiniopTensorDescriptor_t q,
+    infiniopTensorDescriptor_t k,
+    infiniopTensorDescriptor_t v,
+    infiniopTensorDescriptor_t k_cache,
+    infiniopTensorDescriptor_t v_cache,
+    infiniopTensorDescriptor_t pos_ids,
+    infiniopTensorDescriptor_t sin_table,
+    infiniopTensorDescriptor_t cos_table,
+    size_t pos);
+
+/**
+ * infiniopCreateRoPEKVCacheDescriptor with the RoPE options of infiniopCreateRoPEExDescriptor:
+ * sin_table and cos_table may both be null to compute the angles from theta and scaling,
+ * and algo selects how the dimensions of a head are paired. q and k are rotated the same way.
+ */
+__C __export infiniStatus_t infiniopCreateRoPEKVCacheExDescriptor(
+    infiniopHandle_t handle,
+    infiniopRoPEKVCacheDescriptor_t *desc_ptr,
+    infiniopTensorDescriptor_t q,
+    infiniopTensorDescriptor_t k,
+    infiniopTensorDescriptor_t v,
+    infiniopTensorDescriptor_t k_cache,
+    infiniopTensorDescriptor_t v_cache,
+    infiniopTensorDescriptor_t pos_ids,
+    infiniopTensorDescriptor_t sin_table,
+    infiniopTensorDescriptor_t cos_table,
+    size_t pos,
+    float theta,
+    const infiniopRoPEScaling_t *scaling,
+    infiniopRoPEAlgo_t algo);
+
+__C __export infiniStatus_t infiniopGetRoPEKVCacheWorkspaceSize(infiniopRoPEKVCacheDescriptor_t desc, size_t *size);
+
+__C __export infiniStatus_t infiniopRoPEKVCache(
+    infiniopRoPEKVCacheDescriptor_t desc,
+    void *workspace,
+    size_t workspace_size,
+    void *q,
+    const void *k,
+    const void *v,
+    void *k_cache,
+    void *v_cache,
+    const void *pos_ids,
+    const void *sin_table,
+    const void *cos_table,
+    void *stream);
+
+__C __export infiniStatus_t infiniopDestroyRoPEKVCacheDescriptor(infiniopRoPEKVCacheDescriptor_t desc);
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef __INFINIOP_SCATTER_API_H__
+#define __INFINIOP_SCATTER_API_H__
+
+#include "../operator_descriptor.h"
+
+typedef struct InfiniopDescriptor *infiniopScatterDescriptor_t;
+
+/**
+ * Writes slices to indexed positions along `axis`: y[..., indices[i], ...] = x[..., i, ...].
+ *
+ * - y is updated in place; positions that are not indexed keep their values.
+ * - indices_desc: 1-D I32 or I64 tensor of n indices into dimension `axis` of y.
+ *   Indices must be unique, otherwise the result is unspecified.
+ * - x has the shape of y except that dimension `axis` has length n.
+ * - axis: negative values count from the end.
+ *
+ * Typical use is writing new K/V rows into arbitrary KV-cache slots.
+ * `infiniopScatter` returns INFINI_STATUS_BAD_PARAM, without writing y, if any index is out of range.
+ */
+__C __export infiniStatus_t infiniopCreateScatterDescriptor(
+    infiniopHandle_t handle,
+    infiniopScatterDescriptor_t *desc_ptr,
+    infiniopTensorDescriptor_t y_desc,
+    infiniopTensorDescriptor_t x_desc,
+    infiniopTensorDescriptor_t indices_desc,
+    int axis);
+
+__C __export infiniStatus_t infiniopScatter(
+    infiniopScatterDescriptor_t desc,
+    void *y,
+    const void *x,
+    const void *indices,
+    void *stream);
+
+__C __export infiniStatus_t infiniopDestroyScatterDescriptor(infiniopScatterDescriptor_t desc);
+
+#endif
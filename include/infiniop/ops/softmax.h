@@ -0,0 +1,40 @@
+#ifndef __INFINIOP_SOFTMAX_API_H__
+#define __INFINIOP_SOFTMAX_API_H__
+
+#include "../operator_descriptor.h"
+
+typedef struct InfiniopDescriptor *infiniopSoftmaxDescriptor_t;
+
+/**
+ * Softmax (or log-softmax) of x / temperature along `axis`.
+ *
+ * - mask_desc: optional mask with the shape of x (zero strides broadcast). A BOOL mask keeps
+ *   positions that are true; a mask of the dtype of x or F32 is added to the scaled logits.
+ *   Pass null for no mask. Fully masked rows produce 0 (or -inf for log-softmax).
+ * - axis: dimension to normalize over, negative values count from the end.
+ * - log: non-zero to output log-softmax.
+ */
+__C __export infiniStatus_t infiniopCreateSoftmaxDescriptor(
+    infiniopHandle_t handle,
+    infiniopSoftmaxDescriptor_t *desc_ptr,
+    infiniopTensorDescriptor_t y_desc,
+    infiniopTensorDescriptor_t x_desc,
+    infiniopTensorDescriptor_t mask_desc,
+    int axis,
+    float temperature,
+    int log);
+
+__C __export infiniStatus_t infiniopGetSoftmaxWorkspaceSize(infiniopSoftmaxDescriptor_t desc, size_t *size);
+
+__C __export infiniStatus_t infiniopSoftmax(
+    infiniopSoftmaxDescriptor_t desc,
+    void *workspace,
+    size_t workspace_size,
+    void *y,
+    const void *x,
+    const void *mask,
+    void *stream);
+
+__C __export infiniStatus_t infiniopDestroySoftmaxDescriptor(infiniopSoftmaxDescriptor_t desc);
+
+#endif
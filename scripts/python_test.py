@@ -13,15 +13,23 @@ def run_tests(args):
     failed = []
     for test in [
         "add.py",
+        "add_rms_norm.py",
         "attention.py",
         "causal_softmax.py",
         "clip.py",
+        "gather.py",
         "gemm.py",
+        "kv_cache_attention.py",
+        "layer_norm.py",
         "mul.py",
         "random_sample.py",
         "rearrange.py",
         "rms_norm.py",
+        "rms_norm_quant.py",
         "rope.py",
+        "rope_kv_cache.py",
+        "scatter.py",
+        "softmax.py",
         "sub.py",
         "swiglu.py",
     ]:
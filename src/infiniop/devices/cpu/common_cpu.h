@@ -3,6 +3,7 @@
 
 #include "../../../utils.h"
 #include "cpu_handle.h"
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
@@ -30,6 +31,178 @@ size_t getPaddedSize(size_t ndim, size_t *shape, const size_t *pads);
 // calculate the padded shape and store the result in padded_shape
 std::vector<size_t> getPaddedShape(size_t ndim, const size_t *shape, const size_t *pads);
 
+inline size_t maxThreads() {
+#ifdef ENABLE_OMP
+    return static_cast<size_t>(omp_get_max_threads());
+#else
+    return 1;
+#endif
+}
+
+inline size_t threadId() {
+#ifdef ENABLE_OMP
+    return static_cast<size_t>(omp_get_thread_num());
+#else
+    return 0;
+#endif
+}
+
+// 把一个元素转换成 float。半精度和 fp8 直接用无分支的位运算转换，不调用 utils::cast 中的外部函数，
+// 在循环中内联后可以向量化
+template <typename T>
+inline float loadFloat(const T &src) {
+    if constexpr (std::is_same<T, fp16_t>::value) {
+        uint32_t h = src._v,
+                 em = h & 0x7fff,
+                 bits = (em << 13) + ((127 - 15) << 23);
+        // 无穷和 NaN：指数位全 1
+        bits += em >= 0x7c00 ? (128 - 16) << 23 : 0;
+        // 非规格化数：先当作 2^-14 * (1 + m / 1024)，再减去 2^-14
+        uint32_t subnormal = em < 0x400 ? (127 - 14) << 23 : 0;
+        bits += subnormal ? 1 << 23 : 0;
+        float val, offset;
+        std::memcpy(&val, &bits, sizeof(val));
+        std::memcpy(&offset, &subnormal, sizeof(offset));
+        val -= offset;
+        std::memcpy(&bits, &val, sizeof(bits));
+        bits |= (h & 0x8000) << 16;
+        std::memcpy(&val, &bits, sizeof(val));
+        return val;
+    } else if constexpr (std::is_same<T, bf16_t>::value) {
+        uint32_t bits = uint32_t(src._v) << 16;
+        float val;
+        std::memcpy(&val, &bits, sizeof(val));
+        return val;
+    } else if constexpr (std::is_same<T, fp8_t>::value) {
+        // e4m3fn：非规格化数为 m * 2^-9，s.1111.111 为 NaN，没有无穷
+        uint32_t em = src._v & 0x7f,
+                 normal = (em << 20) + ((127 - 7) << 23);
+        float small = float(em) * (1.f / 512.f);
+        uint32_t subnormal;
+        std::memcpy(&subnormal, &small, sizeof(subnormal));
+        uint32_t sub_mask = -uint32_t(em < 0x08),
+                 nan_mask = -uint32_t(em == 0x7f),
+                 bits = (normal & ~sub_mask) | (subnormal & sub_mask);
+        bits = (bits & ~nan_mask) | (0x7fc00000u & nan_mask);
+        bits |= uint32_t(src._v & 0x80) << 24;
+        float val;
+        std::memcpy(&val, &bits, sizeof(val));
+        return val;
+    } else {
+        return utils::cast<float>(src);
+    }
+}
+
+// 把一个 float 转换成 T 写入 dst，与 utils::cast 的结果逐位一致，半精度和 fp8 同样可以向量化
+template <typename T>
+inline void storeFloat(T &dst, float src) {
+    if constexpr (std::is_same<T, fp16_t>::value) {
+        uint32_t f;
+        std::memcpy(&f, &src, sizeof(f));
+        uint32_t abs = f & 0x7fffffff;
+        int32_t e = int32_t(abs >> 23) - 127;
+        // 非规格化数（含下溢到 0）的单位是 2^-24，缩放后截断即得尾数，缩放是精确的。
+        // 先在整数上钳位保证转换不溢出，结果用掩码而不是条件选择合并，否则浮点转换不会被向量化
+        uint32_t small_bits = std::min(abs, 0x38800000u);
+        float small;
+        std::memcpy(&small, &small_bits, sizeof(small));
+        uint32_t subnormal = uint32_t(int32_t(small * 0x1p24f)),
+                 normal = (uint32_t(e + 15) << 10) | ((f & 0x7fffff) >> 13),
+                 // 无穷和 NaN
+                 h = abs > 0x7f800000 ? 0x7e00 : 0x7c00;
+        h = e < 16 ? normal : h;
+        uint32_t mask = -uint32_t(e < -14);
+        h = (subnormal & mask) | (h & ~mask);
+        dst._v = uint16_t(((f >> 16) & 0x8000) | h);
+    } else if constexpr (std::is_same<T, bf16_t>::value) {
+        uint32_t f;
+        std::memcpy(&f, &src, sizeof(f));
+        // 舍入到最近偶数
+        dst._v = uint16_t((f + 0x7fff + ((f >> 16) & 1)) >> 16);
+    } else if constexpr (std::is_same<T, fp8_t>::value) {
+        uint32_t f;
+        std::memcpy(&f, &src, sizeof(f));
+        uint32_t abs = f & 0x7fffffff;
+        // 小于 2^-6 时按非规格化数舍入：加上 2^23 后由浮点加法舍入到最近偶数，低位即为尾数，
+        // 舍入到 8 时恰好得到最小规格化数
+        uint32_t small_bits = std::min(abs, 0x3c800000u);
+        float small;
+        std::memcpy(&small, &small_bits, sizeof(small));
+        small = small * 512.f + 0x1p23f;
+        uint32_t subnormal;
+        std::memcpy(&subnormal, &small, sizeof(subnormal));
+        subnormal -= 0x4b000000;
+        // 规格化数保留 3 位尾数并舍入到最近偶数；超出范围饱和到 448，NaN 仍为 NaN
+        uint32_t normal = std::min(((abs + 0x7ffff + ((abs >> 20) & 1)) >> 20) - ((127 - 7) << 3), 0x7eu),
+                 sub_mask = -uint32_t(abs < 0x3c800000),
+                 sat_mask = -uint32_t(abs >= 0x43e00000),
+                 nan_mask = -uint32_t(abs > 0x7f800000),
+                 bits = (normal & ~sub_mask) | (subnormal & sub_mask);
+        bits = (bits & ~sat_mask) | (0x7eu & sat_mask);
+        bits = (bits & ~nan_mask) | (0x7fu & nan_mask);
+        dst._v = uint8_t(((f >> 24) & 0x80) | bits);
+    } else {
+        dst = utils::cast<T>(src);
+    }
+}
+
+// 把 len 个元素转换成 float 写入 dst
+template <typename T>
+inline void loadFloat(float *dst, const T *src, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        dst[i] = loadFloat(src[i]);
+    }
+}
+
+// 把 len 个 float 转换成 T 写入 dst
+template <typename T>
+inline void storeFloat(T *dst, const float *src, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        storeFloat(dst[i], src[i]);
+    }
+}
+
+// 与计算类型 Tcompute 之间的转换：float 计算时用上面内联的转换，double 计算时用 utils::cast
+template <typename Tcompute, typename T>
+inline Tcompute loadCompute(const T &src) {
+    if constexpr (std::is_same<Tcompute, float>::value) {
+        return loadFloat(src);
+    } else {
+        return utils::cast<Tcompute>(src);
+    }
+}
+
+template <typename T, typename Tcompute>
+inline void storeCompute(T &dst, Tcompute src) {
+    if constexpr (std::is_same<Tcompute, float>::value) {
+        storeFloat(dst, src);
+    } else {
+        dst = utils::cast<T>(src);
+    }
+}
+
+// 对称量化：q = encode(x / scale)，max 为量化类型能表示的最大绝对值
+template <typename Tq>
+struct Quant;
+
+template <>
+struct Quant<int8_t> {
+    static constexpr float max = 127.f;
+    static int8_t encode(float val) {
+        return static_cast<int8_t>(std::clamp(std::nearbyint(val), -max, max));
+    }
+};
+
+template <>
+struct Quant<fp8_t> {
+    static constexpr float max = 448.f;
+    static fp8_t encode(float val) {
+        fp8_t ans;
+        storeFloat(ans, val);
+        return ans;
+    }
+};
+
 } // namespace op::common_cpu
 
 #endif // __INFINIOP__COMMON_CPU_H__
@@ -0,0 +1,110 @@
+#include "add_rms_norm_cpu.h"
+#include "../../../devices/cpu/common_cpu.h"
+#include "../../../reduce/cpu/reduce.h"
+
+namespace op::add_rms_norm::cpu {
+
+Descriptor::~Descriptor() {}
+
+infiniStatus_t Descriptor::create(
+    infiniopHandle_t handle,
+    Descriptor **desc_ptr,
+    infiniopTensorDescriptor_t y_desc,
+    infiniopTensorDescriptor_t residual_out_desc,
+    infiniopTensorDescriptor_t a_desc,
+    infiniopTensorDescriptor_t b_desc,
+    infiniopTensorDescriptor_t w_desc,
+    float epsilon) {
+    auto result = AddRMSNormInfo::create(y_desc, residual_out_desc, a_desc, b_desc, w_desc, epsilon);
+    CHECK_RESULT(result);
+    auto info = result.take();
+    // 每个线程缓存一行残差相加的结果，归约和缩放之间不必再读一遍输入
+    auto workspace_size = op::common_cpu::maxThreads() * op::rms_norm::rowWorkspaceSize(info.dim(), info.norm.atype);
+    *desc_ptr = new Descriptor(nullptr, std::move(info), workspace_size, handle->device, handle->device_id);
+    return INFINI_STATUS_SUCCESS;
+}
+
+template <typename T, typename Tw, typename Tcompute>
+void addRMSNorm(
+    const AddRMSNormInfo &info,
+    Tcompute *workspace, size_t nthreads,
+    T *y, T *residual_out, const T *a, const T *b, const Tw *w) {
+
+    const size_t dim = info.dim();
+    const auto &norm = info.norm;
+
+#pragma omp parallel num_threads(nthreads)
+    {
+        Tcompute *h = workspace + op::common_cpu::threadId() * dim;
+
+#pragma omp for
+        for (ptrdiff_t i = 0; i < ptrdiff_t(info.batch()); i++) {
+            auto y_ = y + i * norm.y_strides[0];
+            auto r_ = residual_out + i * info.residual_out_strides[0];
+            auto a_ = a + i * norm.x_strides[0];
+            auto b_ = b + i * info.b_strides[0];
+
+            // residual_out = a + b，同时归约平方和；
+            // 归一化的输入取舍入到 T 之后的残差，与先做 add 再做 rms_norm 的结果一致
+            Tcompute ss = 0;
+            for (size_t j = 0; j < dim; j++) {
+                T sum;
+                op::common_cpu::storeCompute(sum, op::common_cpu::loadCompute<Tcompute>(a_[j]) + op::common_cpu::loadCompute<Tcompute>(b_[j]));
+                r_[j] = sum;
+                h[j] = op::common_cpu::loadCompute<Tcompute>(sum);
+                ss += h[j] * h[j];
+            }
+
+            // 1 / (sqrt(sum/dim + eps))
+            Tcompute rms = Tcompute(1) / std::sqrt(ss / Tcompute(dim) + Tcompute(norm.epsilon));
+
+            for (size_t j = 0; j < dim; j++) {
+                op::common_cpu::storeCompute(y_[j], h[j] * op::common_cpu::loadCompute<Tcompute>(w[j]) * rms);
+            }
+        }
+    }
+}
+
+infiniStatus_t Descriptor::calculate(
+    void *workspace, size_t workspace_size,
+    void *y,
+    void *residual_out,
+    const void *a,
+    const void *b,
+    const void *w,
+    void *stream) const {
+
+    if (workspace_size < _workspace_size) {
+        return INFINI_STATUS_INSUFFICIENT_WORKSPACE;
+    }
+    auto nthreads = _workspace_size / op::rms_norm::rowWorkspaceSize(_info.dim(), _info.norm.atype);
+
+#define CALCULATE(T, TW, TCOMPUTE)                         \
+    addRMSNorm(_info, (TCOMPUTE *)workspace, nthreads,     \
+               (T *)y, (T *)residual_out,                  \
+               (const T *)a, (const T *)b, (const TW *)w); \
+    return INFINI_STATUS_SUCCESS
+
+    switch (_info.norm.atype) {
+    case INFINI_DTYPE_F16:
+        if (_info.norm.wtype == INFINI_DTYPE_F32) {
+            CALCULATE(fp16_t, float, float);
+        }
+        CALCULATE(fp16_t, fp16_t, float);
+    case INFINI_DTYPE_BF16:
+        if (_info.norm.wtype == INFINI_DTYPE_F32) {
+            CALCULATE(bf16_t, float, float);
+        }
+        CALCULATE(bf16_t, bf16_t, float);
+    case INFINI_DTYPE_F32:
+        CALCULATE(float, float, float);
+    case INFINI_DTYPE_F64:
+        CALCULATE(double, double, double);
+    default:
+        return INFINI_STATUS_BAD_TENSOR_DTYPE;
+    }
+
+#undef CALCULATE
+}
+
+} // namespace op::add_rms_norm::cpu
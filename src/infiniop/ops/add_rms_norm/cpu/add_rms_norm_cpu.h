@@ -0,0 +1,8 @@
+#ifndef __ADD_RMS_NORM_CPU_H__
+#define __ADD_RMS_NORM_CPU_H__
+
+#include "../add_rms_norm.h"
+
+DESCRIPTOR(cpu)
+
+#endif // __ADD_RMS_NORM_CPU_H__
@@ -0,0 +1,52 @@
+#ifndef __ADD_RMS_NORM_INFO_H__
+#define __ADD_RMS_NORM_INFO_H__
+
+#include "../rms_norm/info.h"
+
+namespace op::add_rms_norm {
+
+class AddRMSNormInfo {
+    AddRMSNormInfo(op::rms_norm::RMSNormInfo norm) : norm(std::move(norm)) {}
+
+public:
+    // y = rms_norm(a + b) * w 的归一化部分，x 即 a
+    op::rms_norm::RMSNormInfo norm;
+    // residual_out = a + b
+    std::vector<ptrdiff_t> residual_out_strides;
+    std::vector<ptrdiff_t> b_strides;
+
+    size_t batch() const { return norm.shape[0]; }
+    size_t dim() const { return norm.dim(); }
+
+    static utils::Result<AddRMSNormInfo> create(
+        infiniopTensorDescriptor_t y_desc,
+        infiniopTensorDescriptor_t residual_out_desc,
+        infiniopTensorDescriptor_t a_desc,
+        infiniopTensorDescriptor_t b_desc,
+        infiniopTensorDescriptor_t w_desc,
+        float epsilon) {
+
+        // 数据类型和形状要求与 rms_norm 相同，但只支持二维且最后一维连续的张量
+        CHECK_OR_RETURN(y_desc->ndim() == 2, INFINI_STATUS_BAD_TENSOR_SHAPE);
+        auto result = op::rms_norm::RMSNormInfo::create(y_desc, a_desc, w_desc, epsilon);
+        CHECK_RESULT(result);
+
+        auto atype = y_desc->dtype();
+        CHECK_OR_RETURN(residual_out_desc->dtype() == atype && b_desc->dtype() == atype,
+                        INFINI_STATUS_BAD_TENSOR_DTYPE);
+        CHECK_SAME_SHAPE(y_desc->shape(), residual_out_desc->shape(), b_desc->shape());
+        CHECK_OR_RETURN(y_desc->dim(1) > 0, INFINI_STATUS_BAD_TENSOR_SHAPE);
+        CHECK_OR_RETURN(y_desc->stride(1) == 1 && a_desc->stride(1) == 1
+                            && residual_out_desc->stride(1) == 1 && b_desc->stride(1) == 1,
+                        INFINI_STATUS_BAD_TENSOR_STRIDES);
+
+        AddRMSNormInfo info(result.take());
+        info.residual_out_strides = residual_out_desc->strides();
+        info.b_strides = b_desc->strides();
+        return utils::Result<AddRMSNormInfo>(std::move(info));
+    }
+};
+
+} // namespace op::add_rms_norm
+
+#endif // __ADD_RMS_NORM_INFO_H__
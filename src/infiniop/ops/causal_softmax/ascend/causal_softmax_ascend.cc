@@ -37,10 +37,17 @@ infiniStatus_t Descriptor::create(
     infiniopHandle_t handle,
     Descriptor **desc_ptr,
     infiniopTensorDescriptor_t y_desc,
-    infiniopTensorDescriptor_t x_desc) {
+    infiniopTensorDescriptor_t x_desc,
+    infiniopTensorDescriptor_t bias_desc,
+    float scale,
+    size_t window,
+    float alibi_max_bias) {
     auto handle_ascend = reinterpret_cast<device::ascend::Handle *>(handle);
-    auto result = CausalSoftmaxInfo::create(y_desc, x_desc);
+    auto result = CausalSoftmaxInfo::create(y_desc, x_desc, bias_desc, scale, window, alibi_max_bias);
     CHECK_RESULT(result);
+    if (!result->isStrictCausal()) {
+        return INFINI_STATUS_NOT_IMPLEMENTED;
+    }
     CausalSoftmaxInfo info = result.take();
 
     aclOpExecutor *executor = nullptr;
@@ -113,7 +120,7 @@ infiniStatus_t Descriptor::create(
     return INFINI_STATUS_SUCCESS;
 }
 
-infiniStatus_t Descriptor::calculate(void *workspace, size_t workspace_size, void *y, const void *x, void *stream) const {
+infiniStatus_t Descriptor::calculate(void *workspace, size_t workspace_size, void *y, const void *x, const void *bias, void *stream) const {
     if (workspace_size < workspaceSize()) {
         return INFINI_STATUS_INSUFFICIENT_WORKSPACE;
     }
@@ -4,43 +4,64 @@
 #include "../../operator.h"
 #include "info.h"
 
-#define DESCRIPTOR(NAMESPACE)                                    \
-                                                                 \
-    namespace op::causal_softmax::NAMESPACE {                    \
-    class Descriptor final : public InfiniopDescriptor {         \
-        struct Opaque;                                           \
-        Opaque *_opaque;                                         \
-        CausalSoftmaxInfo _info;                                 \
-        size_t _workspace_size;                                  \
-                                                                 \
-        Descriptor(                                              \
-            Opaque *opaque,                                      \
-            CausalSoftmaxInfo info,                              \
-            size_t workspace_size,                               \
-            infiniDevice_t device_type,                          \
-            int device_id)                                       \
-            : InfiniopDescriptor{device_type, device_id},        \
-              _opaque(opaque),                                   \
-              _info(info),                                       \
-              _workspace_size(workspace_size) {}                 \
-                                                                 \
-    public:                                                      \
-        ~Descriptor();                                           \
-                                                                 \
-        size_t workspaceSize() const { return _workspace_size; } \
-                                                                 \
-        static infiniStatus_t create(                            \
-            infiniopHandle_t handle,                             \
-            Descriptor **desc_ptr,                               \
-            infiniopTensorDescriptor_t y_desc,                   \
-            infiniopTensorDescriptor_t x_desc);                  \
-                                                                 \
-        infiniStatus_t calculate(                                \
-            void *workspace, size_t workspace_size,              \
-            void *y,                                             \
-            const void *x,                                       \
-            void *stream) const;                                 \
-    };                                                           \
+#define DESCRIPTOR(NAMESPACE)                                                      \
+                                                                                   \
+    namespace op::causal_softmax::NAMESPACE {                                      \
+    class Descriptor final : public InfiniopDescriptor {                           \
+        struct Opaque;                                                             \
+        Opaque *_opaque;                                                           \
+        CausalSoftmaxInfo _info;                                                   \
+        size_t _workspace_size;                                                    \
+                                                                                   \
+        Descriptor(                                                                \
+            Opaque *opaque,                                                        \
+            CausalSoftmaxInfo info,                                                \
+            size_t workspace_size,                                                 \
+            infiniDevice_t device_type,                                            \
+            int device_id)                                                         \
+            : InfiniopDescriptor{device_type, device_id},                          \
+              _opaque(opaque),                                                     \
+              _info(info),                                                         \
+              _workspace_size(workspace_size) {}                                   \
+                                                                                   \
+    public:                                                                        \
+        ~Descriptor();                                                             \
+                                                                                   \
+        size_t workspaceSize() const { return _workspace_size; }                   \
+                                                                                   \
+        static infiniStatus_t create(                                              \
+            infiniopHandle_t handle,                                               \
+            Descriptor **desc_ptr,                                                 \
+            infiniopTensorDescriptor_t y_desc,                                     \
+            infiniopTensorDescriptor_t x_desc,                                     \
+            infiniopTensorDescriptor_t bias_desc,                                  \
+            float scale,                                                           \
+            size_t window,                                                         \
+            float alibi_max_bias);                                                 \
+                                                                                   \
+        static infiniStatus_t create(                                              \
+            infiniopHandle_t handle,                                               \
+            Descriptor **desc_ptr,                                                 \
+            infiniopTensorDescriptor_t y_desc,                                     \
+            infiniopTensorDescriptor_t x_desc) {                                   \
+            return create(handle, desc_ptr, y_desc, x_desc, nullptr, 1.f, 0, 0.f); \
+        }                                                                          \
+                                                                                   \
+        infiniStatus_t calculate(                                                  \
+            void *workspace, size_t workspace_size,                                \
+            void *y,                                                               \
+            const void *x,                                                         \
+            const void *bias,                                                      \
+            void *stream) const;                                                   \
+                                                                                   \
+        infiniStatus_t calculate(                                                  \
+            void *workspace, size_t workspace_size,                                \
+            void *y,                                                               \
+            const void *x,                                                         \
+            void *stream) const {                                                  \
+            return calculate(workspace, workspace_size, y, x, nullptr, stream);    \
+        }                                                                          \
+    };                                                                             \
     }
 
 #endif // CAUSAL_SOFTMAX_H
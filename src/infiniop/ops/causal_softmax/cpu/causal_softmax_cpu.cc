@@ -10,46 +10,95 @@ infiniStatus_t Descriptor::create(
     infiniopHandle_t handle,
     Descriptor **desc_ptr,
     infiniopTensorDescriptor_t y_desc,
-    infiniopTensorDescriptor_t x_desc) {
-    auto result = CausalSoftmaxInfo::create(y_desc, x_desc);
+    infiniopTensorDescriptor_t x_desc,
+    infiniopTensorDescriptor_t bias_desc,
+    float scale,
+    size_t window,
+    float alibi_max_bias) {
+    auto result = CausalSoftmaxInfo::create(y_desc, x_desc, bias_desc, scale, window, alibi_max_bias);
     CHECK_RESULT(result);
     *desc_ptr = new Descriptor(nullptr, result.take(), 0, handle->device, handle->device_id);
     return INFINI_STATUS_SUCCESS;
 }
 
+// 每次转换成 float 参与在线归约的元素数，保证中间结果留在 L1 中
+constexpr size_t BLOCK_SIZE = 256;
+
+// 连续的行中 j 维步长为 1，编译器可以向量化内层循环
+template <typename T, bool CONTIGUOUS>
+void causalSoftmaxRow(const CausalSoftmaxInfo *info, size_t batch, size_t i, T *y, const T *x, const T *bias) {
+    const ptrdiff_t y_stride_j = CONTIGUOUS ? 1 : info->y_stride_j,
+                    x_stride_j = CONTIGUOUS ? 1 : info->x_stride_j,
+                    bias_stride_j = CONTIGUOUS ? 1 : info->bias_stride_j;
+    T *y_ = y + batch * info->y_stride_b + i * info->y_stride_i;
+    const T *x_ = x + batch * info->x_stride_b + i * info->x_stride_i;
+    const T *bias_ = bias ? bias + batch * info->bias_stride_b + i * info->bias_stride_i : nullptr;
+
+    // 可见范围为 [begin, end)，窗口之外的位置不参与计算
+    size_t end = info->total_seq_len - info->seq_len + i + 1;
+    size_t begin = info->mask.begin(end - 1);
+    // batch 维视作注意力头
+    const float slope = info->mask.alibiSlope(batch, info->batch_size),
+                scale = info->scale;
+
+    // 把 [j, j + len) 的 logits 转成 float 写入 buf
+    auto logits = [&](float *buf, size_t j, size_t len) {
+        for (size_t k = 0; k < len; k++) {
+            buf[k] = op::common_cpu::loadFloat(x_[(j + k) * x_stride_j]) * scale;
+        }
+        if (bias_) {
+            for (size_t k = 0; k < len; k++) {
+                buf[k] += op::common_cpu::loadFloat(bias_[(j + k) * bias_stride_j]);
+            }
+        }
+        if (slope != 0.f) {
+            for (size_t k = 0; k < len; k++) {
+                buf[k] += slope * (float(j + k) - float(end - 1));
+            }
+        }
+    };
+
+    // 第一遍：在线计算最大值与指数和
+    float buf[BLOCK_SIZE];
+    op::common_cpu::reduce_op::SoftmaxStat stat;
+    for (size_t j = begin; j < end; j += BLOCK_SIZE) {
+        size_t len = std::min(BLOCK_SIZE, end - j);
+        logits(buf, j, len);
+        stat.update(buf, len);
+    }
+
+    // 第二遍：归一化写回，窗口之外写 0；可见位置全部被偏置掩盖（-inf）时 max 也是 -inf，整行写 0
+    const bool masked = stat.sum == 0.f;
+    for (size_t j = 0; j < (masked ? end : begin); j++) {
+        y_[j * y_stride_j] = utils::cast<T>(0.0f);
+    }
+    const float inv_sum = 1.0f / stat.sum;
+    for (size_t j = begin; j < end && !masked; j += BLOCK_SIZE) {
+        size_t len = std::min(BLOCK_SIZE, end - j);
+        logits(buf, j, len);
+        for (size_t k = 0; k < len; k++) {
+            op::common_cpu::storeFloat(y_[(j + k) * y_stride_j], op::common_cpu::fastExp(buf[k] - stat.max) * inv_sum);
+        }
+    }
+    for (size_t j = end; j < info->total_seq_len; j++) {
+        y_[j * y_stride_j] = utils::cast<T>(0.0f);
+    }
+}
+
 template <typename T>
-infiniStatus_t causal_softmax(const CausalSoftmaxInfo *info, T *y, const T *x) {
+infiniStatus_t causal_softmax(const CausalSoftmaxInfo *info, T *y, const T *x, const T *bias) {
+    bool contiguous = info->y_stride_j == 1
+                   && info->x_stride_j == 1
+                   && (bias == nullptr || info->bias_stride_j == 1);
+
 #pragma omp parallel for
     for (ptrdiff_t index = 0; index < ptrdiff_t(info->batch_size * info->seq_len); index++) {
         size_t batch = index / info->seq_len;
         size_t i = (index % info->seq_len);
-        ptrdiff_t y_offset = batch * info->y_stride_b + i * info->y_stride_i;
-        ptrdiff_t x_offset = batch * info->x_stride_b + i * info->x_stride_i;
-        T *y_ = y + y_offset;
-        const T *x_ = x + x_offset;
-
-        for (size_t j = info->total_seq_len - info->seq_len + i + 1; j < info->total_seq_len; j++) {
-            if constexpr (std::is_same<T, fp16_t>::value || std::is_same<T, bf16_t>::value) {
-                y_[j * info->y_stride_j] = utils::cast<T>(0.0f);
-            } else {
-                y_[j * info->y_stride_j] = 0.0f;
-            }
-        }
-        float val = op::common_cpu::reduce_op::max(x_, info->total_seq_len - info->seq_len + i + 1, info->x_stride_j);
-        for (size_t j = 0; j <= info->total_seq_len - info->seq_len + i; j++) {
-            if constexpr (std::is_same<T, fp16_t>::value || std::is_same<T, bf16_t>::value) {
-                y_[j * info->y_stride_j] = utils::cast<T>(std::exp(utils::cast<float>(x_[j * info->x_stride_j]) - val));
-            } else {
-                y_[j * info->y_stride_j] = std::exp(x_[j * info->x_stride_j] - val);
-            }
-        }
-        float sum = op::common_cpu::reduce_op::sum(y_, info->total_seq_len - info->seq_len + i + 1, info->y_stride_j);
-        for (size_t j = 0; j <= info->total_seq_len - info->seq_len + i; j++) {
-            if constexpr (std::is_same<T, fp16_t>::value || std::is_same<T, bf16_t>::value) {
-                y_[j * info->y_stride_j] = utils::cast<T>(utils::cast<float>(y_[j * info->y_stride_j]) / sum);
-            } else {
-                y_[j * info->y_stride_j] = y_[j * info->y_stride_j] / sum;
-            }
+        if (contiguous) {
+            causalSoftmaxRow<T, true>(info, batch, i, y, x, bias);
+        } else {
+            causalSoftmaxRow<T, false>(info, batch, i, y, x, bias);
         }
     }
 
@@ -60,14 +109,21 @@ infiniStatus_t Descriptor::calculate(
     void *workspace, size_t workspace_size,
     void *y,
     const void *x,
+    const void *bias,
     void *stream) const {
 
+    if (!_info.has_bias) {
+        bias = nullptr;
+    } else if (bias == nullptr) {
+        return INFINI_STATUS_NULL_POINTER;
+    }
+
     if (_info.dtype == INFINI_DTYPE_F16) {
-        CHECK_STATUS(causal_softmax<fp16_t>(&_info, (fp16_t *)y, (const fp16_t *)x));
+        CHECK_STATUS(causal_softmax<fp16_t>(&_info, (fp16_t *)y, (const fp16_t *)x, (const fp16_t *)bias));
     } else if (_info.dtype == INFINI_DTYPE_BF16) {
-        CHECK_STATUS(causal_softmax<bf16_t>(&_info, (bf16_t *)y, (const bf16_t *)x));
+        CHECK_STATUS(causal_softmax<bf16_t>(&_info, (bf16_t *)y, (const bf16_t *)x, (const bf16_t *)bias));
     } else if (_info.dtype == INFINI_DTYPE_F32) {
-        CHECK_STATUS(causal_softmax<float>(&_info, (float *)y, (const float *)x));
+        CHECK_STATUS(causal_softmax<float>(&_info, (float *)y, (const float *)x, (const float *)bias));
     } else {
         return INFINI_STATUS_BAD_TENSOR_DTYPE;
     }
@@ -3,10 +3,43 @@
 
 #include "../../../utils.h"
 #include "../../tensor.h"
+#include <cmath>
 #include <vector>
 
 namespace op::causal_softmax {
 
+// 因果掩码之外的可选掩码：滑动窗口与 ALiBi 偏置
+struct CausalMask {
+    // 每个位置最多能看到的 token 数（包括自身），0 表示不限制
+    size_t window;
+    // ALiBi 的最大偏置，0 表示不加 ALiBi 偏置
+    float alibi_max_bias;
+
+    bool enabled() const {
+        return window != 0 || alibi_max_bias != 0.f;
+    }
+
+    // 绝对位置为 pos 的 token 可见的范围为 [begin(pos), pos]
+    size_t begin(size_t pos) const {
+        return window == 0 || pos < window ? 0 : pos + 1 - window;
+    }
+
+    // 第 head 个头的 ALiBi 斜率，偏置为 slope * (j - pos)
+    float alibiSlope(size_t head, size_t n_head) const {
+        if (alibi_max_bias == 0.f) {
+            return 0.f;
+        }
+        // 头数不是 2 的幂时，多出的头插值到相邻的斜率序列上
+        size_t n_floor = size_t(1) << size_t(std::floor(std::log2(float(n_head))));
+        float m0 = std::exp2(-alibi_max_bias / n_floor),
+              m1 = std::exp2(-alibi_max_bias / 2 / n_floor);
+        if (head < n_floor) {
+            return std::pow(m0, float(head + 1));
+        }
+        return std::pow(m1, float(2 * (head - n_floor) + 1));
+    }
+};
+
 class CausalSoftmaxInfo {
     CausalSoftmaxInfo() = default;
 
@@ -24,7 +57,27 @@ public:
     ptrdiff_t x_stride_i;
     ptrdiff_t x_stride_j;
 
-    static utils::Result<CausalSoftmaxInfo> create(infiniopTensorDescriptor_t y_desc, infiniopTensorDescriptor_t x_desc) {
+    // softmax 之前乘到 x 上的缩放因子，用于融合注意力的 qk_alpha
+    float scale;
+    CausalMask mask;
+    // 可选的加性偏置，与 x 同类型，可在 batch 维广播
+    bool has_bias;
+    ptrdiff_t bias_stride_b;
+    ptrdiff_t bias_stride_i;
+    ptrdiff_t bias_stride_j;
+
+    // 仅有严格的因果掩码，且不缩放
+    bool isStrictCausal() const {
+        return scale == 1.f && !mask.enabled() && !has_bias;
+    }
+
+    static utils::Result<CausalSoftmaxInfo> create(
+        infiniopTensorDescriptor_t y_desc,
+        infiniopTensorDescriptor_t x_desc,
+        infiniopTensorDescriptor_t bias_desc = nullptr,
+        float scale = 1.f,
+        size_t window = 0,
+        float alibi_max_bias = 0.f) {
         auto dtype = y_desc->dtype();
         if (dtype != x_desc->dtype()) {
             return INFINI_STATUS_BAD_TENSOR_DTYPE;
@@ -59,6 +112,27 @@ public:
             batch_size = shape[0];
         }
 
+        CHECK_OR_RETURN(std::isfinite(scale), INFINI_STATUS_BAD_PARAM);
+        CHECK_OR_RETURN(std::isfinite(alibi_max_bias) && alibi_max_bias >= 0.f, INFINI_STATUS_BAD_PARAM);
+
+        ptrdiff_t bias_stride_b = 0,
+                  bias_stride_i = 0,
+                  bias_stride_j = 0;
+        if (bias_desc) {
+            CHECK_OR_RETURN(bias_desc->dtype() == dtype, INFINI_STATUS_BAD_TENSOR_DTYPE);
+            auto bias_ndim = bias_desc->ndim();
+            CHECK_OR_RETURN(bias_ndim == 2 || bias_ndim == ndim, INFINI_STATUS_BAD_TENSOR_SHAPE);
+            CHECK_OR_RETURN(bias_desc->dim(bias_ndim - 2) == seq_len
+                                && bias_desc->dim(bias_ndim - 1) == total_seq_len,
+                            INFINI_STATUS_BAD_TENSOR_SHAPE);
+            bias_stride_i = bias_desc->stride(bias_ndim - 2);
+            bias_stride_j = bias_desc->stride(bias_ndim - 1);
+            if (bias_ndim == 3) {
+                CHECK_OR_RETURN(bias_desc->dim(0) == batch_size, INFINI_STATUS_BAD_TENSOR_SHAPE);
+                bias_stride_b = bias_desc->stride(0);
+            }
+        }
+
         return utils::Result<CausalSoftmaxInfo>(CausalSoftmaxInfo{
             dtype,
             batch_size,
@@ -69,7 +143,13 @@ public:
             y_stride_j,
             x_stride_b,
             x_stride_i,
-            x_stride_j});
+            x_stride_j,
+            scale,
+            CausalMask{window, alibi_max_bias},
+            bias_desc != nullptr,
+            bias_stride_b,
+            bias_stride_i,
+            bias_stride_j});
     }
 };
 
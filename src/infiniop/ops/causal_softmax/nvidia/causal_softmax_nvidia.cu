@@ -31,9 +31,16 @@ infiniStatus_t Descriptor::create(
     infiniopHandle_t handle,
     Descriptor **desc_ptr,
     infiniopTensorDescriptor_t y_desc,
-    infiniopTensorDescriptor_t x_desc) {
-    auto info = CausalSoftmaxInfo::create(y_desc, x_desc);
+    infiniopTensorDescriptor_t x_desc,
+    infiniopTensorDescriptor_t bias_desc,
+    float scale,
+    size_t window,
+    float alibi_max_bias) {
+    auto info = CausalSoftmaxInfo::create(y_desc, x_desc, bias_desc, scale, window, alibi_max_bias);
     CHECK_RESULT(info);
+    if (!info->isStrictCausal()) {
+        return INFINI_STATUS_NOT_IMPLEMENTED;
+    }
     *desc_ptr = new Descriptor(
         new Opaque{reinterpret_cast<device::nvidia::Handle *>(handle)->internal()},
         info.take(), 0, handle->device, handle->device_id);
@@ -74,6 +81,7 @@ infiniStatus_t launchKernel(void *y, const void *x, infiniDtype_t dtype,
 infiniStatus_t Descriptor::calculate(void *workspace, size_t workspace_size,
                                      void *y,
                                      const void *x,
+                                     const void *bias,
                                      void *stream_) const {
     cudaStream_t stream = (cudaStream_t)stream_;
     if (_opaque->internal->maxThreadsPerBlock() == CUDA_BLOCK_SIZE_1024) {
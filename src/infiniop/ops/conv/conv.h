@@ -3,54 +3,67 @@
 
 #include "../../operator.h"
 #include "info.h"
+#include "infiniop/ops/conv.h"
+#include <atomic>
 
-#define DESCRIPTOR(NAMESPACE)                                    \
-                                                                 \
-    namespace op::conv::NAMESPACE {                              \
-    class Descriptor final : public InfiniopDescriptor {         \
-        struct Opaque;                                           \
-        Opaque *_opaque;                                         \
-        infiniDtype_t _dtype;                                    \
-        ConvInfo _info;                                          \
-        size_t _workspace_size;                                  \
-                                                                 \
-        Descriptor(                                              \
-            infiniDtype_t dtype,                                 \
-            ConvInfo info,                                       \
-            size_t workspace_size_,                              \
-            Opaque *opaque,                                      \
-            infiniDevice_t device_type,                          \
-            int device_id)                                       \
-            : InfiniopDescriptor{device_type, device_id},        \
-              _opaque(opaque),                                   \
-              _dtype(dtype),                                     \
-              _info(info),                                       \
-              _workspace_size(workspace_size_) {}                \
-                                                                 \
-    public:                                                      \
-        ~Descriptor();                                           \
-                                                                 \
-        size_t workspaceSize() const { return _workspace_size; } \
-                                                                 \
-        static infiniStatus_t create(                            \
-            infiniopHandle_t handle,                             \
-            Descriptor **desc_ptr,                               \
-            infiniopTensorDescriptor_t y,                        \
-            infiniopTensorDescriptor_t x,                        \
-            infiniopTensorDescriptor_t w,                        \
-            infiniopTensorDescriptor_t b,                        \
-            const void *pads,                                    \
-            const void *strides,                                 \
-            const void *dilations,                               \
-            size_t n);                                           \
-                                                                 \
-        infiniStatus_t calculate(                                \
-            void *workspace, size_t workspace_size,              \
-            void *y,                                             \
-            const void *x,                                       \
-            const void *w,                                       \
-            const void *bias,                                    \
-            void *stream) const;                                 \
-    };                                                           \
+#define DESCRIPTOR(NAMESPACE)                                                                  \
+                                                                                               \
+    namespace op::conv::NAMESPACE {                                                            \
+    class Descriptor final : public InfiniopDescriptor {                                       \
+        struct Opaque;                                                                         \
+        Opaque *_opaque;                                                                       \
+        infiniDtype_t _dtype;                                                                  \
+        ConvInfo _info;                                                                        \
+        size_t _workspace_size;                                                                \
+        std::atomic<infiniopConvWeightHint_t> _weight_hint{INFINIOP_CONV_WEIGHT_HINT_DEFAULT}; \
+        std::atomic<size_t> _weight_epoch{0};                                                  \
+        infiniopConvActivation_t _activation = INFINIOP_CONV_ACTIVATION_NONE;                  \
+                                                                                               \
+        Descriptor(                                                                            \
+            infiniDtype_t dtype,                                                               \
+            ConvInfo info,                                                                     \
+            size_t workspace_size_,                                                            \
+            Opaque *opaque,                                                                    \
+            infiniDevice_t device_type,                                                        \
+            int device_id)                                                                     \
+            : InfiniopDescriptor{device_type, device_id},                                      \
+              _opaque(opaque),                                                                 \
+              _dtype(dtype),                                                                   \
+              _info(info),                                                                     \
+              _workspace_size(workspace_size_) {}                                              \
+                                                                                               \
+    public:                                                                                    \
+        ~Descriptor();                                                                         \
+                                                                                               \
+        size_t workspaceSize() const { return _workspace_size; }                               \
+                                                                                               \
+        void setWeightHint(infiniopConvWeightHint_t hint) {                                    \
+            _weight_hint.store(hint);                                                          \
+            _weight_epoch.fetch_add(1);                                                        \
+        }                                                                                      \
+                                                                                               \
+        infiniStatus_t setActivation(infiniopConvActivation_t activation);                     \
+                                                                                               \
+        static infiniStatus_t create(                                                          \
+            infiniopHandle_t handle,                                                           \
+            Descriptor **desc_ptr,                                                             \
+            infiniopTensorDescriptor_t y,                                                      \
+            infiniopTensorDescriptor_t x,                                                      \
+            infiniopTensorDescriptor_t w,                                                      \
+            infiniopTensorDescriptor_t b,                                                      \
+            const void *pads,                                                                  \
+            const void *strides,                                                               \
+            const void *dilations,                                                             \
+            size_t n,                                                                          \
+            size_t groups);                                                                    \
+                                                                                               \
+        infiniStatus_t calculate(                                                              \
+            void *workspace, size_t workspace_size,                                            \
+            void *y,                                                                           \
+            const void *x,                                                                     \
+            const void *w,                                                                     \
+            const void *bias,                                                                  \
+            void *stream) const;                                                               \
+    };                                                                                         \
     }
 #endif // __CONV_H__
@@ -1,39 +1,415 @@
 #include "conv_cpu.h"
 #include "../../../devices/cpu/common_cpu.h"
+#include "conv_gemm.h"
+#include "conv_winograd.h"
 #include <algorithm>
+#include <cmath>
+#include <mutex>
 
 namespace op::conv::cpu {
 
-inline size_t calculatePaddedInputSize(const ConvInfo &info) {
+enum class ConvAlgo {
+    // 逐元素直接卷积
+    DIRECT,
+    // 隐式 im2col：按列块把输入展开到线程私有的打包缓冲中，再与打包好的权重做分块 GEMM
+    IM2COL_GEMM,
+    // 二维 3x3、步长和空洞为 1 的卷积，在 Winograd 变换域中对每个频点做一次 GEMM
+    WINOGRAD,
+    // 逐通道卷积（每组一个输入通道和一个输出通道），不经过 GEMM，直接在通道或输出位置上向量化
+    DEPTHWISE,
+};
+
+// 输出通道数或归约长度太小时，打包的开销无法被 GEMM 摊薄
+constexpr size_t GEMM_MIN_OUT_CHANNELS = gemm::MR;
+constexpr size_t GEMM_MIN_REDUCTION = 8;
+// 每个线程打包的输入块（KC x nc）大小上限
+constexpr size_t GEMM_PANEL_BYTES = 128 << 10;
+// 通道数太少时输入输出变换的开销超过节省的乘法
+constexpr size_t WINOGRAD_MIN_CHANNELS = 8;
+// 每轮变换的块在变换域中占用的空间（输入和输出）上限
+constexpr size_t WINOGRAD_CHUNK_BYTES = 4 << 20;
+// GEMM 阶段每个任务计算的块数
+constexpr size_t WINOGRAD_NC = 4 * gemm::NR;
+// 逐通道卷积每次在寄存器中累加的通道数（通道最后）或输出位置数（通道优先）
+constexpr size_t DEPTHWISE_BLOCK = 64;
+
+// 各算法在 fp32 中累加完一个输出块后统一收尾：加偏置、激活，再转换为输出类型写回，
+// 不需要 fp32 的输出副本，也不再单独遍历一遍输出
+template <typename Tdata>
+struct Epilogue {
+    const Tdata *bias;
+    infiniopConvActivation_t activation;
+
+    void operator()(Tdata *y, float value, size_t channel) const {
+        if (bias != nullptr) {
+            value += op::common_cpu::loadFloat(bias[channel]);
+        }
+        switch (activation) {
+        case INFINIOP_CONV_ACTIVATION_RELU:
+            value = std::max(value, 0.f);
+            break;
+        case INFINIOP_CONV_ACTIVATION_SILU:
+            value = value / (1.f + std::exp(-value));
+            break;
+        default:
+            break;
+        }
+        op::common_cpu::storeFloat(*y, value);
+    }
+};
+
+// 输出位置和卷积核位置到输入的映射：输入坐标 = 输出坐标 * stride - pad + 卷积核坐标 * dilation。
+// 填充不再复制到工作空间中，落在输入之外的元素按 0 处理：窗口完全在输入之内的输出位置直接按偏移读取，
+// 只有边缘的输出位置需要逐元素检查
+struct Window {
+    size_t ndim;
+    std::vector<ptrdiff_t> in_dims;
+    // 卷积核各位置在输入中的偏移和各维坐标（taps x ndim）
+    std::vector<ptrdiff_t> tap_offsets, tap_coords;
+    // 各输出位置的窗口起点在输入中的偏移和各维坐标（p x ndim），有填充时可能为负
+    std::vector<ptrdiff_t> p_offsets, p_coords;
+    // 窗口完全落在输入之内的输出位置
+    std::vector<uint8_t> p_interior;
+
+    // 输出位置 p 的卷积核第 t 个位置在前 dims 维上是否落在输入之内
+    bool inBounds(size_t p, size_t t, size_t dims) const {
+        const auto o = p_coords.data() + p * ndim,
+                   d = tap_coords.data() + t * ndim;
+        for (size_t i = 0; i < dims; ++i) {
+            const ptrdiff_t c = o[i] + d[i];
+            if (c < 0 || c >= in_dims[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+    bool inBounds(size_t p, size_t t) const { return inBounds(p, t, ndim); }
+};
+
+// 把卷积看作对每个样本的每组 Y_g (m x p) = W_g (m x k) * X_col_g (k x p)，
+// 其中 m = 每组输出通道数，k = 每组输入通道数 * 卷积核大小，p = 输出空间大小。
+// 通道最后布局下计算 Y_g^T = X_col_g^T * W_g^T，输出通道落在微内核的 NR 列上，与内存中连续的方向一致
+struct GemmPlan {
+    size_t m, k, p, groups;
+    bool channels_last;
+    // X_col_g[n] 第 i 行第 j 列的元素在输入中的偏移为
+    // n * x_batch_stride + g * x_group_stride + k_offsets[i] + window.p_offsets[j]，对应卷积核的第 k_taps[i] 个位置；
+    // 与之相乘的权重为 w[(g * m + 输出通道) * k + w_offsets[i]]
+    Window window;
+    std::vector<ptrdiff_t> k_offsets, w_offsets;
+    std::vector<size_t> k_taps;
+    size_t x_batch_stride, x_group_stride;
+    // 每个任务计算 mc 个输出通道、nc 个输出位置
+    size_t mc, nc;
+    size_t nthreads;
+
+    // 打包权重和输入块时每组的行数
+    size_t weightLanes() const { return channels_last ? gemm::NR : gemm::MR; }
+    size_t panelLanes() const { return channels_last ? gemm::MR : gemm::NR; }
+    size_t groupWeightSize() const { return gemm::roundUp(m, weightLanes()) * k; }
+    size_t weightSize() const { return groups * groupWeightSize(); }
+    size_t panelSize() const { return std::min(k, gemm::KC) * nc; }
+    // 归约维超过 KC 时，前面各 kc 块的部分和暂存在线程私有的 fp32 缓冲中，最后一块累加完再收尾
+    size_t partialSize() const { return k > gemm::KC ? mc * nc : 0; }
+    size_t scratchSize() const { return nthreads * (panelSize() + partialSize()); }
+};
+
+// F(m x m, 3 x 3)，所有样本的输出按 m x m 分块后统一编号，每轮变换 tc 个块
+struct WinogradPlan {
+    size_t m;
+    size_t c_in, c_out;
+    // 输入和输出的空间大小
+    size_t x_h, x_w, y_h, y_w;
+    size_t pad_h, pad_w;
+    size_t tiles_h, tiles_w, tiles;
+    size_t tc;
+
+    size_t alpha() const { return m + 2; }
+    // 变换后的权重：每个频点一个按 MR 行打包的 c_out x c_in 矩阵
+    size_t weightSize() const { return alpha() * alpha() * gemm::roundUp(c_out, gemm::MR) * c_in; }
+    // 每轮变换的输入 V（每个频点 c_in x tc）和输出 M（每个频点 c_out x tc）
+    size_t scratchSize() const { return alpha() * alpha() * (c_in + c_out) * tc; }
+};
+
+// 直接卷积只用于通道优先的布局
+struct DirectPlan {
+    Window window;
+    size_t x_batch_stride, x_channel_stride;
+};
+
+// y[n, c] = sum_t x[n, c, 输出位置 + 卷积核第 t 个位置] * w[c, t]
+struct DepthwisePlan {
+    size_t channels, taps, p;
+    bool channels_last;
+    Window window;
+    size_t x_batch_stride, x_channel_stride;
+    // 输出最内维的长度和步长，以及沿该维前进一个输出位置时输入偏移的增量
+    size_t width;
+    ptrdiff_t stride_w, x_width_stride;
+
+    // 转为 float 的权重，通道最后布局下按 [tap][channel] 存放，使通道方向连续
+    size_t weightSize() const { return channels * taps; }
+};
+
+struct ConvPlan {
+    ConvAlgo algo;
+    DirectPlan direct;
+    GemmPlan gemm;
+    WinogradPlan winograd;
+    DepthwisePlan depthwise;
+
+    // 预处理后的权重和其余工作空间，以 float 计
+    size_t weightSize() const {
+        switch (algo) {
+        case ConvAlgo::IM2COL_GEMM:
+            return gemm.weightSize();
+        case ConvAlgo::WINOGRAD:
+            return winograd.weightSize();
+        case ConvAlgo::DEPTHWISE:
+            return depthwise.weightSize();
+        default:
+            return 0;
+        }
+    }
+    size_t scratchSize() const {
+        switch (algo) {
+        case ConvAlgo::IM2COL_GEMM:
+            return gemm.scratchSize();
+        case ConvAlgo::WINOGRAD:
+            return winograd.scratchSize();
+        default:
+            return 0;
+        }
+    }
+};
+
+struct Descriptor::Opaque {
+    ConvPlan plan;
+    // 权重提示为 CONSTANT 时缓存预处理后的权重，权重地址或提示改变后重新计算
+    std::mutex mutex;
+    std::vector<float> weights;
+    const void *weights_key = nullptr;
+    size_t weights_epoch = 0;
+};
+
+inline std::vector<size_t> inputShape(const ConvInfo &info) {
     std::vector<size_t> shape(info.ndim() + 2);
     shape[0] = info.batch();
     shape[1] = info.in_channels();
     for (size_t i = 0; i < info.ndim(); ++i) {
         shape[i + 2] = info.input_dim(i);
     }
+    return shape;
+}
+
+// [batch, channels, 空间维...] 形状的连续张量的步长（以元素计），通道最后时通道维最内
+inline std::vector<ptrdiff_t> denseStrides(const std::vector<size_t> &shape, bool channels_last) {
+    std::vector<ptrdiff_t> strides(shape.size());
+    ptrdiff_t stride = 1;
+    if (channels_last) {
+        strides[1] = stride;
+        stride *= ptrdiff_t(shape[1]);
+    }
+    for (size_t i = shape.size(); i-- > 2;) {
+        strides[i] = stride;
+        stride *= ptrdiff_t(shape[i]);
+    }
+    if (!channels_last) {
+        strides[1] = stride;
+        stride *= ptrdiff_t(shape[1]);
+    }
+    strides[0] = stride;
+    return strides;
+}
 
-    return op::common_cpu::getPaddedSize(info.ndim() + 2, shape.data(), info.getPadsInfo());
+// x 的步长（以元素计），维度顺序为 [batch, channels, 空间维...]
+inline std::vector<ptrdiff_t> inputStrides(const ConvInfo &info) {
+    return denseStrides(inputShape(info), info.channels_last());
 }
 
-inline size_t calculateOutputSize(const ConvInfo &info) {
-    size_t size = info.batch() * info.out_channels();
+inline ConvAlgo selectAlgo(const ConvInfo &info) {
+    const size_t groups = info.groups(),
+                 c_in = info.in_channels() / groups,
+                 c_out = info.out_channels() / groups;
+    if (groups > 1 && c_in == 1 && c_out == 1) {
+        return ConvAlgo::DEPTHWISE;
+    }
+    // 通道最后布局由 GEMM 在通道方向上向量化
+    if (info.channels_last()) {
+        return ConvAlgo::IM2COL_GEMM;
+    }
+    size_t kernel_size = 1;
+    for (size_t i = 0; i < info.ndim(); ++i) {
+        kernel_size *= info.kernel_dim(i);
+    }
+    if (c_out < GEMM_MIN_OUT_CHANNELS || c_in * kernel_size < GEMM_MIN_REDUCTION) {
+        return ConvAlgo::DIRECT;
+    }
+    bool winograd = info.ndim() == 2
+                 && groups == 1
+                 && info.in_channels() >= WINOGRAD_MIN_CHANNELS
+                 && info.out_channels() >= WINOGRAD_MIN_CHANNELS;
     for (size_t i = 0; i < info.ndim(); ++i) {
-        size *= info.output_dim(i);
+        winograd = winograd
+                && info.kernel_dim(i) == 3
+                && info.stride_info(i) == 1
+                && info.dilation_info(i) == 1;
     }
-    return size;
+    return winograd ? ConvAlgo::WINOGRAD : ConvAlgo::IM2COL_GEMM;
 }
 
-inline bool needsPadding(const ConvInfo &info) {
-    const size_t *pads = info.getPadsInfo();
-    for (size_t i = 0; i < info.ndim(); ++i) {
-        if (pads[i] > 0) {
-            return true;
+WinogradPlan planWinograd(const ConvInfo &info) {
+    WinogradPlan plan;
+    plan.c_in = info.in_channels();
+    plan.c_out = info.out_channels();
+    plan.x_h = info.input_dim(0);
+    plan.x_w = info.input_dim(1);
+    plan.pad_h = info.pad_info(0);
+    plan.pad_w = info.pad_info(1);
+    plan.y_h = info.output_dim(0);
+    plan.y_w = info.output_dim(1);
+
+    // 选择变换域中乘法次数（块数 x 频点数）较少的块大小，输出较小时 F(2x2) 的边缘浪费更少
+    auto cost = [&](size_t m) {
+        return ((plan.y_h + m - 1) / m) * ((plan.y_w + m - 1) / m) * (m + 2) * (m + 2);
+    };
+    plan.m = cost(4) < cost(2) ? 4 : 2;
+
+    plan.tiles_h = (plan.y_h + plan.m - 1) / plan.m;
+    plan.tiles_w = (plan.y_w + plan.m - 1) / plan.m;
+    plan.tiles = info.batch() * plan.tiles_h * plan.tiles_w;
+
+    const size_t bytes_per_tile = plan.alpha() * plan.alpha() * (plan.c_in + plan.c_out) * sizeof(float);
+    plan.tc = std::min(gemm::roundUp(plan.tiles, gemm::NR),
+                       std::max(gemm::NR, WINOGRAD_CHUNK_BYTES / bytes_per_tile / gemm::NR * gemm::NR));
+
+    return plan;
+}
+
+// x_strides 为输入各维的步长
+Window makeWindow(const ConvInfo &info, const ptrdiff_t *x_strides) {
+    const size_t ndim = info.ndim();
+    size_t taps = 1;
+    for (size_t i = 0; i < ndim; ++i) {
+        taps *= info.kernel_dim(i);
+    }
+
+    Window window;
+    window.ndim = ndim;
+    window.in_dims.resize(ndim);
+    for (size_t i = 0; i < ndim; ++i) {
+        window.in_dims[i] = ptrdiff_t(info.input_dim(i));
+    }
+
+    window.tap_offsets.resize(taps);
+    window.tap_coords.resize(taps * ndim);
+    for (size_t t = 0; t < taps; ++t) {
+        size_t rem = t;
+        ptrdiff_t offset = 0;
+        for (size_t i = ndim; i-- > 0;) {
+            const ptrdiff_t c = ptrdiff_t(rem % info.kernel_dim(i) * info.dilation_info(i));
+            window.tap_coords[t * ndim + i] = c;
+            offset += c * x_strides[i + 2];
+            rem /= info.kernel_dim(i);
         }
+        window.tap_offsets[t] = offset;
     }
-    return false;
+
+    const size_t p = info.spatial_sizes();
+    window.p_offsets.resize(p);
+    window.p_coords.resize(p * ndim);
+    window.p_interior.resize(p);
+    for (size_t j = 0; j < p; ++j) {
+        size_t rem = j;
+        ptrdiff_t offset = 0;
+        bool interior = true;
+        for (size_t i = ndim; i-- > 0;) {
+            const ptrdiff_t c = ptrdiff_t(rem % info.output_dim(i) * info.stride_info(i)) - ptrdiff_t(info.pad_info(i));
+            window.p_coords[j * ndim + i] = c;
+            offset += c * x_strides[i + 2];
+            interior = interior
+                    && c >= 0
+                    && c + ptrdiff_t((info.kernel_dim(i) - 1) * info.dilation_info(i)) < window.in_dims[i];
+            rem /= info.output_dim(i);
+        }
+        window.p_offsets[j] = offset;
+        window.p_interior[j] = interior;
+    }
+
+    return window;
 }
 
-Descriptor::~Descriptor() = default;
+GemmPlan planGemm(const ConvInfo &info) {
+    const auto x_strides = inputStrides(info);
+
+    GemmPlan plan;
+    plan.window = makeWindow(info, x_strides.data());
+    const size_t kernel_size = plan.window.tap_offsets.size(),
+                 c_in = info.in_channels() / info.groups();
+    plan.groups = info.groups();
+    plan.channels_last = info.channels_last();
+    plan.m = info.out_channels() / plan.groups;
+    plan.k = c_in * kernel_size;
+    plan.p = info.spatial_sizes();
+    plan.x_batch_stride = x_strides[0];
+    plan.x_group_stride = c_in * x_strides[1];
+
+    // 归约维的顺序与输入在内存中的顺序一致：通道优先时为 (通道, 卷积核位置)，通道最后时为 (卷积核位置, 通道)
+    plan.k_offsets.resize(plan.k);
+    plan.w_offsets.resize(plan.k);
+    plan.k_taps.resize(plan.k);
+    for (size_t r = 0; r < plan.k; ++r) {
+        const size_t ci = plan.channels_last ? r % c_in : r / kernel_size,
+                     t = plan.channels_last ? r / c_in : r % kernel_size;
+        plan.k_offsets[r] = ptrdiff_t(ci) * x_strides[1] + plan.window.tap_offsets[t];
+        plan.w_offsets[r] = ptrdiff_t(ci * kernel_size + t);
+        plan.k_taps[r] = t;
+    }
+
+    // 输出位置的分块让打包的输入块留在 L2 中
+    const size_t lanes = plan.panelLanes();
+    const size_t nc_max = std::max(lanes, GEMM_PANEL_BYTES / sizeof(float) / std::min(plan.k, gemm::KC) / lanes * lanes);
+    plan.nc = std::min(nc_max, gemm::roundUp(plan.p, lanes));
+
+    // 样本、组和输出位置的分块不足以占满线程时，再按输出通道切分
+    plan.nthreads = op::common_cpu::maxThreads();
+    const size_t tasks = info.batch() * plan.groups * ((plan.p + plan.nc - 1) / plan.nc);
+    const size_t m_splits = std::max<size_t>(1, (plan.nthreads + tasks - 1) / tasks);
+    plan.mc = gemm::roundUp((plan.m + m_splits - 1) / m_splits, plan.weightLanes());
+
+    return plan;
+}
+
+DirectPlan planDirect(const ConvInfo &info) {
+    const auto x_strides = inputStrides(info);
+
+    DirectPlan plan;
+    plan.window = makeWindow(info, x_strides.data());
+    plan.x_batch_stride = x_strides[0];
+    plan.x_channel_stride = x_strides[1];
+    return plan;
+}
+
+DepthwisePlan planDepthwise(const ConvInfo &info) {
+    const auto x_strides = inputStrides(info);
+
+    DepthwisePlan plan;
+    plan.channels = info.out_channels();
+    plan.channels_last = info.channels_last();
+    plan.window = makeWindow(info, x_strides.data());
+    plan.taps = plan.window.tap_offsets.size();
+    plan.p = plan.window.p_offsets.size();
+    plan.x_batch_stride = x_strides[0];
+    plan.x_channel_stride = x_strides[1];
+    plan.width = info.output_dim(info.ndim() - 1);
+    plan.stride_w = ptrdiff_t(info.stride_info(info.ndim() - 1));
+    plan.x_width_stride = plan.stride_w * x_strides.back();
+    return plan;
+}
+
+Descriptor::~Descriptor() {
+    delete _opaque;
+}
 
 infiniStatus_t Descriptor::create(
     infiniopHandle_t handle_,
@@ -45,295 +421,552 @@ infiniStatus_t Descriptor::create(
     const void *pads,
     const void *strides,
     const void *dilations,
-    size_t n) {
+    size_t n,
+    size_t groups) {
     auto handle = reinterpret_cast<device::cpu::Handle *>(handle_);
     auto dtype = y_desc->dtype();
 
     CHECK_DTYPE(dtype, INFINI_DTYPE_F16, INFINI_DTYPE_F32, INFINI_DTYPE_BF16);
 
     auto result = ConvInfo::create(handle_, y_desc, x_desc, w_desc, b_desc,
-                                   pads, strides, dilations, n);
+                                   pads, strides, dilations, n, groups);
     CHECK_RESULT(result);
 
     size_t WorkSpaceSize = 0;
     const ConvInfo &info = result.take();
 
-    if (needsPadding(info)) {
-        WorkSpaceSize += calculatePaddedInputSize(info) * infiniSizeOf(dtype);
-    }
-
-    if (dtype == INFINI_DTYPE_F16 || dtype == INFINI_DTYPE_BF16) {
-        WorkSpaceSize += calculateOutputSize(info) * sizeof(float);
+    auto opaque = new Opaque;
+    auto &plan = opaque->plan;
+    plan.algo = selectAlgo(info);
+    switch (plan.algo) {
+    case ConvAlgo::IM2COL_GEMM:
+        plan.gemm = planGemm(info);
+        break;
+    case ConvAlgo::WINOGRAD:
+        plan.winograd = planWinograd(info);
+        break;
+    case ConvAlgo::DEPTHWISE:
+        plan.depthwise = planDepthwise(info);
+        break;
+    default:
+        plan.direct = planDirect(info);
+        break;
     }
+    // 工作空间依次存放预处理后的权重和所选算法的临时空间，填充由各算法在边缘处理，不占用工作空间
+    WorkSpaceSize += (plan.weightSize() + plan.scratchSize()) * sizeof(float);
 
     *desc_ptr = new Descriptor(
         dtype, std::move(info), WorkSpaceSize,
-        nullptr,
+        opaque,
         handle->device, handle->device_id);
     return INFINI_STATUS_SUCCESS;
 }
 
 template <typename Tdata>
-void fillPaddedInput(
+void applyConv(
     const ConvInfo &info,
+    const DirectPlan &plan,
+    const Epilogue<Tdata> &epilogue,
+    Tdata *y,
     const Tdata *x,
-    const size_t *padded_x_shape,
-    Tdata *padded_x,
-    size_t x_index,
-    size_t padded_x_index,
-    size_t ndim) {
-    size_t x_shape_val;
-    if (ndim == 0) {
-        x_shape_val = info.batch();
-    } else if (ndim == 1) {
-        x_shape_val = info.in_channels();
-    } else {
-        x_shape_val = info.input_dim(ndim - 2);
-    }
-
-    const auto padded_x_shape_val = padded_x_shape[ndim];
-    const auto x_base_index = x_index * x_shape_val;
-
-    size_t pad_offset = 0;
-    if (ndim >= 2 && x_shape_val != padded_x_shape_val) {
-        pad_offset = info.pad_info(ndim - 2);
-    }
+    const Tdata *w) {
+    const auto &window = plan.window;
+    const ptrdiff_t batch_size = static_cast<ptrdiff_t>(info.batch());
+    const ptrdiff_t out_channels = static_cast<ptrdiff_t>(info.out_channels());
+    const ptrdiff_t total_iterations = batch_size * out_channels;
+    const size_t taps = window.tap_offsets.size(),
+                 p = window.p_offsets.size(),
+                 group_in_channels = info.in_channels() / info.groups(),
+                 group_out_channels = info.out_channels() / info.groups();
 
-    const auto padded_x_base_index = padded_x_index * padded_x_shape_val + pad_offset;
+#pragma omp parallel for schedule(dynamic)
+    for (ptrdiff_t iter = 0; iter < total_iterations; ++iter) {
+        const size_t i = static_cast<size_t>(iter / out_channels); // batch index
+        const size_t j = static_cast<size_t>(iter % out_channels); // output channel index
+        const size_t group = j / group_out_channels;
 
-    for (size_t i = 0; i < x_shape_val; ++i) {
-        if (ndim == info.ndim() + 2 - 1) {
-            padded_x[padded_x_base_index + i] = x[x_base_index + i];
-        } else {
-            fillPaddedInput(info, x, padded_x_shape, padded_x,
-                            x_base_index + i, padded_x_base_index + i, ndim + 1);
+        const auto x_ = x + i * plan.x_batch_stride + group * group_in_channels * plan.x_channel_stride;
+        const auto w_ = w + j * group_in_channels * taps;
+        auto y_ = y + (i * info.out_channels() + j) * p;
+        for (size_t q = 0; q < p; ++q) {
+            // 窗口越过边缘时跳过落在填充区的卷积核位置
+            const bool interior = window.p_interior[q];
+            float sum = 0.f;
+            for (size_t k = 0; k < group_in_channels; ++k) {
+                const auto x_k = x_ + k * plan.x_channel_stride;
+                const auto w_k = w_ + k * taps;
+                for (size_t t = 0; t < taps; ++t) {
+                    if (interior || window.inBounds(q, t)) {
+                        sum += op::common_cpu::loadFloat(x_k[window.p_offsets[q] + window.tap_offsets[t]]) * op::common_cpu::loadFloat(w_k[t]);
+                    }
+                }
+            }
+            epilogue(y_ + q, sum, j);
         }
     }
 }
 
-template <typename Xdata, typename Ydata>
-void _applyConv(
-    const ConvInfo &info,
-    Ydata *y,
+// 把 X_col 的 [k0, k0 + kc) 行、[p0, p0 + nc) 列按 LANES 列一组打包成 [nc/LANES][kc][LANES]，不足的列补零。
+// 一组中有窗口越过输入边缘的输出位置时逐元素检查，落在填充区的元素写 0
+template <size_t LANES, typename Xdata>
+void packIm2col(
+    float *panel,
     const Xdata *x,
-    const Xdata *w,
-    const size_t *x_shape,
-    size_t x_index,
-    size_t w_index,
-    size_t y_index,
-    size_t ndim) {
-
-    size_t dim_size, kernel_size;
-    size_t dilation, stride;
-
-    if (ndim < 2) {
-        return;
-    } else {
-        dim_size = x_shape[ndim];
-        kernel_size = info.kernel_dim(ndim - 2);
-        dilation = info.dilation_info(ndim - 2);
-        stride = info.stride_info(ndim - 2);
-    }
-    if (stride == 0) {
-        std::cerr << "Error: stride cannot be zero." << std::endl;
-    }
-    const auto steps = (dim_size - dilation * (kernel_size - 1) - 1) / stride + 1;
-    x_index *= dim_size;
-    w_index *= kernel_size;
-    size_t y_stride;
-    if (ndim == 0) {
-        y_stride = info.out_channels();
-    } else if (ndim == 1) {
-        y_stride = 1;
-    } else {
-        y_stride = info.output_dim(ndim - 2);
-    }
-    y_index *= y_stride;
-    for (size_t i = 0; i < steps; ++i, ++y_index) {
-        for (size_t k = 0; k < kernel_size; ++k) {
-            const auto curr_x_index = x_index + i * stride + k * dilation;
-            const auto curr_w_index = w_index + k;
-            if (ndim == info.ndim() + 1) {
-                if constexpr (std::is_same<Xdata, fp16_t>::value || std::is_same<Xdata, bf16_t>::value) {
-                    y[y_index] += utils::cast<float>(x[curr_x_index]) * utils::cast<float>(w[curr_w_index]);
-                } else {
-                    y[y_index] += x[curr_x_index] * w[curr_w_index];
+    const GemmPlan &plan,
+    size_t k0, size_t kc,
+    size_t p0, size_t nc) {
+    const auto &window = plan.window;
+    for (size_t j = 0; j < nc; j += LANES) {
+        auto b = panel + j * kc;
+        const auto p_offsets = window.p_offsets.data() + p0 + j;
+        const auto p_interior = window.p_interior.data() + p0 + j;
+        const size_t n = std::min(LANES, nc - j);
+        const bool interior = std::all_of(p_interior, p_interior + n, [](uint8_t v) { return v != 0; });
+        for (size_t k = 0; k < kc; ++k, b += LANES) {
+            const auto x_ = x + plan.k_offsets[k0 + k];
+            size_t jj = 0;
+            if (interior) {
+                for (; jj < n; ++jj) {
+                    b[jj] = op::common_cpu::loadFloat(x_[p_offsets[jj]]);
                 }
             } else {
-                _applyConv(info, y, x, w, x_shape, curr_x_index, curr_w_index,
-                           y_index, ndim + 1);
+                const size_t t = plan.k_taps[k0 + k];
+                for (; jj < n; ++jj) {
+                    b[jj] = window.inBounds(p0 + j + jj, t) ? op::common_cpu::loadFloat(x_[p_offsets[jj]]) : 0.f;
+                }
+            }
+            for (; jj < LANES; ++jj) {
+                b[jj] = 0.f;
             }
         }
     }
 }
 
-template <typename Xdata, typename Ydata>
-void applyConv(
+template <typename Tdata>
+void convGemm(
     const ConvInfo &info,
-    Ydata *y,
-    const Xdata *x,
-    const Xdata *w,
-    const size_t *x_shape) {
-    const ptrdiff_t batch_size = static_cast<ptrdiff_t>(info.batch());
-    const ptrdiff_t out_channels = static_cast<ptrdiff_t>(info.out_channels());
-    const ptrdiff_t total_iterations = batch_size * out_channels;
+    const GemmPlan &plan,
+    const float *packed_w,
+    float *scratch,
+    const Epilogue<Tdata> &epilogue,
+    Tdata *y,
+    const Tdata *x) {
+    const size_t m = plan.m, k = plan.k, p = plan.p,
+                 out_channels = plan.groups * m;
 
-#pragma omp parallel for schedule(dynamic)
-    for (ptrdiff_t iter = 0; iter < total_iterations; ++iter) {
-        const ptrdiff_t i = iter / out_channels; // batch index
-        const ptrdiff_t j = iter % out_channels; // output channel index
+    const size_t m_blocks = (m + plan.mc - 1) / plan.mc,
+                 p_blocks = (p + plan.nc - 1) / plan.nc,
+                 tasks = info.batch() * plan.groups * p_blocks * m_blocks;
+
+#pragma omp parallel num_threads(plan.nthreads)
+    {
+        float *panel = scratch + op::common_cpu::threadId() * (plan.panelSize() + plan.partialSize()),
+              *partial = panel + plan.panelSize();
 
-        const size_t y_index = static_cast<size_t>(i) * info.out_channels() + static_cast<size_t>(j);
+#pragma omp for schedule(dynamic)
+        for (ptrdiff_t task = 0; task < ptrdiff_t(tasks); ++task) {
+            const size_t mb = task % m_blocks,
+                         pb = task / m_blocks % p_blocks,
+                         g = task / m_blocks / p_blocks % plan.groups,
+                         n = task / m_blocks / p_blocks / plan.groups;
+            const size_t m0 = mb * plan.mc,
+                         m1 = std::min(m, m0 + plan.mc),
+                         p0 = pb * plan.nc,
+                         nc = std::min(plan.nc, p - p0);
+            const auto x_ = x + n * plan.x_batch_stride + g * plan.x_group_stride;
+            const auto w_ = packed_w + g * plan.groupWeightSize();
 
-        // 内层循环：遍历输入通道
-        for (size_t k = 0; k < info.in_channels(); ++k) {
-            const size_t x_index = static_cast<size_t>(i) * info.in_channels() + k;
-            const size_t w_index = static_cast<size_t>(j) * info.in_channels() + k;
-            _applyConv(info, y, x, w, x_shape, x_index, w_index, y_index, 2);
+            // 每个 kc 块的输入只打包一次，供本任务的所有输出通道复用；
+            // 输出块在寄存器中累加，最后一个 kc 块之后直接收尾写入 y
+            float acc[gemm::MR][gemm::NR];
+            if (!plan.channels_last) {
+                const auto y_ = y + (n * out_channels + g * m) * p + p0;
+                for (size_t k0 = 0; k0 < k; k0 += gemm::KC) {
+                    const size_t kc = std::min(gemm::KC, k - k0);
+                    packIm2col<gemm::NR>(panel, x_, plan, k0, kc, p0, nc);
+                    for (size_t i = m0; i < m1; i += gemm::MR) {
+                        const auto a = w_ + (i / gemm::MR * k + k0) * gemm::MR;
+                        const size_t mm = std::min(gemm::MR, m1 - i);
+                        for (size_t j = 0; j < nc; j += gemm::NR) {
+                            const size_t nn = std::min(gemm::NR, nc - j);
+                            const auto part = partial + (i - m0) * plan.nc + j;
+                            gemm::microKernel(kc, a, panel + j * kc, acc);
+                            if (k0 > 0) {
+                                gemm::loadTile(acc, part, ptrdiff_t(plan.nc), mm, nn);
+                            }
+                            if (k0 + kc < k) {
+                                gemm::storeTile(acc, part, ptrdiff_t(plan.nc), mm, nn);
+                                continue;
+                            }
+                            for (size_t ii = 0; ii < mm; ++ii) {
+                                for (size_t jj = 0; jj < nn; ++jj) {
+                                    epilogue(y_ + (i + ii) * p + j + jj, acc[ii][jj], g * m + i + ii);
+                                }
+                            }
+                        }
+                    }
+                }
+            } else {
+                const auto y_ = y + (n * p + p0) * out_channels + g * m;
+                for (size_t k0 = 0; k0 < k; k0 += gemm::KC) {
+                    const size_t kc = std::min(gemm::KC, k - k0);
+                    packIm2col<gemm::MR>(panel, x_, plan, k0, kc, p0, nc);
+                    for (size_t j = m0; j < m1; j += gemm::NR) {
+                        const auto b = w_ + (j / gemm::NR * k + k0) * gemm::NR;
+                        const size_t nn = std::min(gemm::NR, m1 - j);
+                        for (size_t i = 0; i < nc; i += gemm::MR) {
+                            const size_t mm = std::min(gemm::MR, nc - i);
+                            const auto part = partial + i * plan.mc + (j - m0);
+                            gemm::microKernel(kc, panel + i * kc, b, acc);
+                            if (k0 > 0) {
+                                gemm::loadTile(acc, part, ptrdiff_t(plan.mc), mm, nn);
+                            }
+                            if (k0 + kc < k) {
+                                gemm::storeTile(acc, part, ptrdiff_t(plan.mc), mm, nn);
+                                continue;
+                            }
+                            for (size_t ii = 0; ii < mm; ++ii) {
+                                for (size_t jj = 0; jj < nn; ++jj) {
+                                    epilogue(y_ + (i + ii) * out_channels + j + jj, acc[ii][jj], g * m + j + jj);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
         }
     }
 }
 
-template <typename Xdata, typename Ydata>
-void _conv_cpu(
-    const ConvInfo &info,
-    void *workspace,
-    size_t workspace_size,
-    Ydata *y,
-    const Xdata *x,
-    const Xdata *w) {
-    if (needsPadding(info)) {
-        auto padded_x = reinterpret_cast<Xdata *>(workspace);
-        if constexpr (std::is_same<Xdata, fp16_t>::value) {
-            fp16_t zero_val = utils::cast<fp16_t>(0.0f);
-            std::fill(padded_x, padded_x + calculatePaddedInputSize(info), zero_val);
-        } else if constexpr (std::is_same<Xdata, bf16_t>::value) {
-            bf16_t zero_val = utils::cast<bf16_t>(0.0f);
-            std::fill(padded_x, padded_x + calculatePaddedInputSize(info), zero_val);
-        } else if constexpr (std::is_same<Xdata, float>::value) {
-            std::fill(padded_x, padded_x + calculatePaddedInputSize(info), 0.0f);
-        }
-        fillPaddedInput(info, x, info.getPaddedShape(), padded_x, 0, 0, 0);
-
-        applyConv(info, y, padded_x, w, info.getPaddedShape());
-    } else {
-        std::vector<size_t> shape(info.ndim() + 2);
-        shape[0] = info.batch();
-        shape[1] = info.in_channels();
-        for (size_t i = 0; i < info.ndim(); ++i) {
-            shape[i + 2] = info.input_dim(i);
-        }
-        applyConv(info, y, x, w, shape.data());
+template <typename Xdata>
+void depthwiseFilter(const DepthwisePlan &plan, float *weights, const Xdata *w) {
+    const size_t channels = plan.channels, taps = plan.taps;
+#pragma omp parallel for
+    for (ptrdiff_t index = 0; index < ptrdiff_t(channels * taps); ++index) {
+        const size_t c = index / taps,
+                     t = index % taps;
+        weights[plan.channels_last ? t * channels + c : index] = op::common_cpu::loadFloat(w[index]);
     }
 }
 
+// 通道最后时每个任务计算一个输出位置的 DEPTHWISE_BLOCK 个通道，
+// 通道优先时计算一个通道中一行（输出最内维）上的 DEPTHWISE_BLOCK 个位置，最内层循环都沿着输入中连续的方向
 template <typename Tdata>
-infiniStatus_t conv_cpu(
+void convDepthwise(
     const ConvInfo &info,
-    void *workspace,
-    size_t workspace_size,
-    void *y,
-    const void *x,
-    const void *w,
-    const void *bias) {
-    auto y_ptr = reinterpret_cast<Tdata *>(y);
-    auto x_ptr = reinterpret_cast<const Tdata *>(x);
-    auto w_ptr = reinterpret_cast<const Tdata *>(w);
-    auto output_size = calculateOutputSize(info);
-    if constexpr (std::is_same<Tdata, float>::value) {
-        std::fill(y_ptr, y_ptr + output_size, 0.0f);
+    const DepthwisePlan &plan,
+    const float *weights,
+    const Epilogue<Tdata> &epilogue,
+    Tdata *y,
+    const Tdata *x) {
+    const auto &window = plan.window;
+    const size_t channels = plan.channels, taps = plan.taps, p = plan.p;
+
+    if (plan.channels_last) {
+        const size_t blocks = (channels + DEPTHWISE_BLOCK - 1) / DEPTHWISE_BLOCK;
+#pragma omp parallel for
+        for (ptrdiff_t task = 0; task < ptrdiff_t(info.batch() * p * blocks); ++task) {
+            const size_t c0 = task % blocks * DEPTHWISE_BLOCK,
+                         j = task / blocks % p,
+                         n = task / blocks / p,
+                         cc = std::min(DEPTHWISE_BLOCK, channels - c0);
+            const auto x_ = x + n * plan.x_batch_stride + c0;
+            const bool interior = window.p_interior[j];
+            float acc[DEPTHWISE_BLOCK] = {};
+            for (size_t t = 0; t < taps; ++t) {
+                if (!interior && !window.inBounds(j, t)) {
+                    continue;
+                }
+                const auto x_t = x_ + window.p_offsets[j] + window.tap_offsets[t];
+                const auto w_t = weights + t * channels + c0;
+#pragma omp simd
+                for (size_t i = 0; i < cc; ++i) {
+                    acc[i] += op::common_cpu::loadFloat(x_t[i]) * w_t[i];
+                }
+            }
+            auto y_ = y + (n * p + j) * channels + c0;
+            for (size_t i = 0; i < cc; ++i) {
+                epilogue(y_ + i, acc[i], c0 + i);
+            }
+        }
     } else {
-        std::fill(y_ptr, y_ptr + output_size, static_cast<Tdata>(0));
-    }
-    _conv_cpu<Tdata, Tdata>(info, workspace, workspace_size, y_ptr, x_ptr, w_ptr);
-    if (bias != nullptr) {
-        auto bias_ptr = reinterpret_cast<const Tdata *>(bias);
+        const size_t width = plan.width,
+                     rows = p / width,
+                     blocks = (width + DEPTHWISE_BLOCK - 1) / DEPTHWISE_BLOCK;
 #pragma omp parallel for
-        for (ptrdiff_t i = 0; i < static_cast<ptrdiff_t>(output_size); ++i) {
-            size_t channel_idx = (i / info.spatial_sizes()) % info.out_channels();
-            y_ptr[i] += bias_ptr[channel_idx];
+        for (ptrdiff_t task = 0; task < ptrdiff_t(info.batch() * channels * rows * blocks); ++task) {
+            const size_t q0 = task % blocks * DEPTHWISE_BLOCK,
+                         r = task / blocks % rows,
+                         c = task / blocks / rows % channels,
+                         n = task / blocks / rows / channels,
+                         qc = std::min(DEPTHWISE_BLOCK, width - q0);
+            const size_t q = r * width + q0,
+                         last = window.ndim - 1;
+            const auto x_ = x + n * plan.x_batch_stride + c * plan.x_channel_stride;
+            // 同一行上窗口在输入之内的位置是连续的一段，首尾都在输入之内时整块都不需要检查
+            const bool interior = window.p_interior[q] && window.p_interior[q + qc - 1];
+            float acc[DEPTHWISE_BLOCK] = {};
+            for (size_t t = 0; t < taps; ++t) {
+                size_t i0 = 0, i1 = qc;
+                if (!interior) {
+                    if (!window.inBounds(q, t, last)) {
+                        continue;
+                    }
+                    // 第 i 个位置在输入最内维上的坐标为 base + i * stride_w，只累加落在 [0, in_w) 内的部分
+                    const ptrdiff_t base = window.p_coords[q * window.ndim + last] + window.tap_coords[t * window.ndim + last],
+                                    in_w = window.in_dims[last];
+                    i0 = base >= 0 ? 0 : size_t((plan.stride_w - 1 - base) / plan.stride_w);
+                    i1 = base >= in_w ? 0 : std::min(qc, size_t((in_w - 1 - base) / plan.stride_w + 1));
+                    if (i0 >= i1) {
+                        continue;
+                    }
+                }
+                const ptrdiff_t offset = window.p_offsets[q] + window.tap_offsets[t];
+                const float w_t = weights[c * taps + t];
+                if (plan.x_width_stride == 1) {
+                    const auto x_t = x_ + offset + ptrdiff_t(i0);
+                    auto acc_ = acc + i0;
+#pragma omp simd
+                    for (size_t i = 0; i < i1 - i0; ++i) {
+                        acc_[i] += op::common_cpu::loadFloat(x_t[i]) * w_t;
+                    }
+                } else {
+#pragma omp simd
+                    for (size_t i = i0; i < i1; ++i) {
+                        acc[i] += op::common_cpu::loadFloat(x_[offset + ptrdiff_t(i) * plan.x_width_stride]) * w_t;
+                    }
+                }
+            }
+            auto y_ = y + (n * channels + c) * p + r * width + q0;
+            for (size_t i = 0; i < qc; ++i) {
+                epilogue(y_ + i, acc[i], c);
+            }
         }
     }
-    return INFINI_STATUS_SUCCESS;
 }
 
-template <>
-infiniStatus_t conv_cpu<fp16_t>(
-    const ConvInfo &info,
-    void *workspace,
-    size_t workspace_size,
-    void *y,
-    const void *x,
-    const void *w,
-    const void *bias) {
-    auto y_float = reinterpret_cast<float *>(workspace);
-    auto x_half = reinterpret_cast<const fp16_t *>(x);
-    auto w_half = reinterpret_cast<const fp16_t *>(w);
-    auto output_size = calculateOutputSize(info);
-    std::fill(y_float, y_float + output_size, 0.0f);
+// 变换后的权重按频点存放，每个频点是一个按 MR 行打包的 c_out x c_in 矩阵
+template <size_t M, typename Xdata>
+void winogradFilter(const WinogradPlan &plan, float *u, const Xdata *w) {
+    constexpr size_t ALPHA = M + 2;
+    const size_t c_in = plan.c_in,
+                 rows = gemm::roundUp(plan.c_out, gemm::MR),
+                 u_stride = rows * c_in;
 
-    void *conv_workspace = y_float + output_size;
-    size_t conv_workspace_size = workspace_size - output_size * sizeof(float);
+#pragma omp parallel for
+    for (ptrdiff_t index = 0; index < ptrdiff_t(rows * c_in); ++index) {
+        const size_t co = index / c_in,
+                     ci = index % c_in;
+        float g[3][3][1] = {}, u_[ALPHA][ALPHA][1];
+        if (co < plan.c_out) {
+            const auto w_ = w + index * 9;
+            for (size_t i = 0; i < 9; ++i) {
+                g[i / 3][i % 3][0] = op::common_cpu::loadFloat(w_[i]);
+            }
+        }
+        winograd::filterTransform<M>(u_, g);
+        auto dst = u + (co / gemm::MR * c_in + ci) * gemm::MR + co % gemm::MR;
+        for (size_t e = 0; e < ALPHA * ALPHA; ++e) {
+            dst[e * u_stride] = u_[e / ALPHA][e % ALPHA][0];
+        }
+    }
+}
 
-    _conv_cpu<fp16_t, float>(info, conv_workspace, conv_workspace_size, y_float, x_half, w_half);
+// 依次处理 [t0, t0 + tc) 的块：输入变换、逐频点 GEMM、输出变换。
+// 变换以 NR 个块为一组，变换后的输入恰好是 GEMM 所需的 [kc][NR] 打包格式
+template <size_t M, typename Tdata>
+void convWinograd(
+    const WinogradPlan &plan,
+    const float *u,
+    float *scratch,
+    const Epilogue<Tdata> &epilogue,
+    Tdata *y,
+    const Tdata *x) {
+    constexpr size_t ALPHA = M + 2, NR = gemm::NR;
+    const size_t c_in = plan.c_in,
+                 c_out = plan.c_out,
+                 tc = plan.tc,
+                 tiles_per_image = plan.tiles_h * plan.tiles_w;
+    const float *u_ = u;
+    float *v = scratch,
+          *m = scratch + ALPHA * ALPHA * c_in * tc;
+
+    for (size_t t0 = 0; t0 < plan.tiles; t0 += tc) {
+        const size_t count = std::min(tc, plan.tiles - t0),
+                     panels = (count + NR - 1) / NR;
 
-    auto y_half = reinterpret_cast<fp16_t *>(y);
-    if (bias != nullptr) {
-        auto bias_half = reinterpret_cast<const fp16_t *>(bias);
 #pragma omp parallel for
-        for (ptrdiff_t i = 0; i < static_cast<ptrdiff_t>(output_size); ++i) {
-            size_t channel_idx = (i / info.spatial_sizes()) % info.out_channels();
-            float bias_value = utils::cast<float>(bias_half[channel_idx]);
-            y_float[i] += bias_value;
-            y_half[i] = utils::cast<fp16_t>(y_float[i]);
+        for (ptrdiff_t index = 0; index < ptrdiff_t(panels * c_in); ++index) {
+            const size_t panel = index / c_in,
+                         ci = index % c_in;
+            float d[ALPHA][ALPHA][NR], v_[ALPHA][ALPHA][NR];
+            for (size_t lane = 0; lane < NR; ++lane) {
+                const size_t t = panel * NR + lane;
+                // 块可能越过输入边缘落在填充区，只读取 [r0, r1) x [c0, c1) 内的元素，其余为 0
+                ptrdiff_t row = 0, col = 0, r0 = 0, r1 = 0, c0 = 0, c1 = 0;
+                const Tdata *x_ = nullptr;
+                if (t < count) {
+                    const size_t n = (t0 + t) / tiles_per_image,
+                                 th = (t0 + t) % tiles_per_image / plan.tiles_w,
+                                 tw = (t0 + t) % tiles_per_image % plan.tiles_w;
+                    row = ptrdiff_t(th * M) - ptrdiff_t(plan.pad_h);
+                    col = ptrdiff_t(tw * M) - ptrdiff_t(plan.pad_w);
+                    r0 = std::max<ptrdiff_t>(0, -row);
+                    r1 = std::clamp<ptrdiff_t>(ptrdiff_t(plan.x_h) - row, 0, ALPHA);
+                    c0 = std::max<ptrdiff_t>(0, -col);
+                    c1 = std::clamp<ptrdiff_t>(ptrdiff_t(plan.x_w) - col, 0, ALPHA);
+                    x_ = x + (n * c_in + ci) * plan.x_h * plan.x_w;
+                }
+                for (ptrdiff_t r = 0; r < ptrdiff_t(ALPHA); ++r) {
+                    for (ptrdiff_t c = 0; c < ptrdiff_t(ALPHA); ++c) {
+                        d[r][c][lane] = r >= r0 && r < r1 && c >= c0 && c < c1
+                                          ? op::common_cpu::loadFloat(x_[(row + r) * ptrdiff_t(plan.x_w) + col + c])
+                                          : 0.f;
+                    }
+                }
+            }
+            winograd::inputTransform<M, NR>(v_, d);
+            auto dst = v + (panel * c_in + ci) * NR;
+            for (size_t e = 0; e < ALPHA * ALPHA; ++e) {
+                std::copy_n(v_[e / ALPHA][e % ALPHA], NR, dst + e * tc * c_in);
+            }
         }
-    } else {
+
+        // 每个频点 M_e (c_out x count) = U_e (c_out x c_in) * V_e (c_in x count)，所有频点的 GEMM 并行执行
+        const size_t width = panels * NR,
+                     groups = (width + WINOGRAD_NC - 1) / WINOGRAD_NC;
+#pragma omp parallel for schedule(dynamic)
+        for (ptrdiff_t task = 0; task < ptrdiff_t(ALPHA * ALPHA * groups); ++task) {
+            const size_t e = task / groups,
+                         j0 = task % groups * WINOGRAD_NC,
+                         j1 = std::min(width, j0 + WINOGRAD_NC);
+            const auto a_e = u_ + e * gemm::roundUp(c_out, gemm::MR) * c_in;
+            const auto b_e = v + e * tc * c_in;
+            const auto c_e = m + e * c_out * tc;
+            for (size_t k0 = 0; k0 < c_in; k0 += gemm::KC) {
+                const size_t kc = std::min(gemm::KC, c_in - k0);
+                for (size_t i = 0; i < c_out; i += gemm::MR) {
+                    const auto a = a_e + (i / gemm::MR * c_in + k0) * gemm::MR;
+                    const size_t mm = std::min(gemm::MR, c_out - i);
+                    for (size_t j = j0; j < j1; j += NR) {
+                        float acc[gemm::MR][NR];
+                        gemm::microKernel(kc, a, b_e + j * c_in + k0 * NR, acc);
+                        if (k0 > 0) {
+                            gemm::loadTile(acc, c_e + i * tc + j, ptrdiff_t(tc), mm, NR);
+                        }
+                        gemm::storeTile(acc, c_e + i * tc + j, ptrdiff_t(tc), mm, NR);
+                    }
+                }
+            }
+        }
+
 #pragma omp parallel for
-        for (ptrdiff_t i = 0; i < static_cast<ptrdiff_t>(output_size); ++i) {
-            y_half[i] = utils::cast<fp16_t>(y_float[i]);
+        for (ptrdiff_t index = 0; index < ptrdiff_t(c_out * panels); ++index) {
+            const size_t co = index / panels,
+                         panel = index % panels;
+            float m_[ALPHA][ALPHA][NR], y_[M][M][NR];
+            for (size_t e = 0; e < ALPHA * ALPHA; ++e) {
+                std::copy_n(m + (e * c_out + co) * tc + panel * NR, NR, m_[e / ALPHA][e % ALPHA]);
+            }
+            winograd::outputTransform<M, NR>(y_, m_);
+            for (size_t lane = 0; lane < NR && panel * NR + lane < count; ++lane) {
+                const size_t t = t0 + panel * NR + lane,
+                             n = t / tiles_per_image,
+                             th = t % tiles_per_image / plan.tiles_w,
+                             tw = t % tiles_per_image % plan.tiles_w;
+                const size_t rows = std::min(M, plan.y_h - th * M),
+                             cols = std::min(M, plan.y_w - tw * M);
+                auto dst = y + ((n * c_out + co) * plan.y_h + th * M) * plan.y_w + tw * M;
+                for (size_t r = 0; r < rows; ++r) {
+                    for (size_t c = 0; c < cols; ++c) {
+                        epilogue(dst + r * plan.y_w + c, y_[r][c][lane], co);
+                    }
+                }
+            }
         }
     }
+}
 
-    return INFINI_STATUS_SUCCESS;
+// 按所选算法预处理权重
+template <typename Xdata>
+void prepareWeights(const ConvPlan &plan, float *weights, const Xdata *w) {
+    switch (plan.algo) {
+    case ConvAlgo::IM2COL_GEMM: {
+        const auto &gemm_plan = plan.gemm;
+        for (size_t g = 0; g < gemm_plan.groups; ++g) {
+            auto dst = weights + g * gemm_plan.groupWeightSize();
+            auto src = w + g * gemm_plan.m * gemm_plan.k;
+            if (gemm_plan.channels_last) {
+                gemm::packRows<gemm::NR>(dst, src, gemm_plan.m, gemm_plan.k, gemm_plan.w_offsets.data());
+            } else {
+                gemm::packRows<gemm::MR>(dst, src, gemm_plan.m, gemm_plan.k, gemm_plan.w_offsets.data());
+            }
+        }
+        break;
+    }
+    case ConvAlgo::WINOGRAD:
+        if (plan.winograd.m == 4) {
+            winogradFilter<4>(plan.winograd, weights, w);
+        } else {
+            winogradFilter<2>(plan.winograd, weights, w);
+        }
+        break;
+    case ConvAlgo::DEPTHWISE:
+        depthwiseFilter(plan.depthwise, weights, w);
+        break;
+    default:
+        break;
+    }
 }
 
-template <>
-infiniStatus_t conv_cpu<bf16_t>(
+template <typename Tdata>
+infiniStatus_t conv_cpu(
     const ConvInfo &info,
+    const ConvPlan &plan,
+    const float *weights,
+    infiniopConvActivation_t activation,
     void *workspace,
     size_t workspace_size,
     void *y,
     const void *x,
     const void *w,
     const void *bias) {
-    auto y_float = reinterpret_cast<float *>(workspace);
-    auto x_half = reinterpret_cast<const bf16_t *>(x);
-    auto w_half = reinterpret_cast<const bf16_t *>(w);
-    auto output_size = calculateOutputSize(info);
-    std::fill(y_float, y_float + output_size, 0.0f);
-
-    void *conv_workspace = y_float + output_size;
-    size_t conv_workspace_size = workspace_size - output_size * sizeof(float);
+    auto y_ptr = reinterpret_cast<Tdata *>(y);
+    auto x_ptr = reinterpret_cast<const Tdata *>(x);
+    auto w_ptr = reinterpret_cast<const Tdata *>(w);
+    const Epilogue<Tdata> epilogue{reinterpret_cast<const Tdata *>(bias), activation};
 
-    _conv_cpu<bf16_t, float>(info, conv_workspace, conv_workspace_size, y_float, x_half, w_half);
+    // 未缓存预处理后的权重时在工作空间中现算
+    auto buffer = reinterpret_cast<float *>(workspace);
+    if (weights == nullptr) {
+        prepareWeights(plan, buffer, w_ptr);
+        weights = buffer;
+    }
+    float *scratch = buffer + plan.weightSize();
 
-    auto y_half = reinterpret_cast<bf16_t *>(y);
-    if (bias != nullptr) {
-        auto bias_half = reinterpret_cast<const bf16_t *>(bias);
-#pragma omp parallel for
-        for (ptrdiff_t i = 0; i < static_cast<ptrdiff_t>(output_size); ++i) {
-            size_t channel_idx = (i / info.spatial_sizes()) % info.out_channels();
-            float bias_value = utils::cast<float>(bias_half[channel_idx]);
-            y_float[i] += bias_value;
-            y_half[i] = utils::cast<bf16_t>(y_float[i]);
-        }
-    } else {
-#pragma omp parallel for
-        for (ptrdiff_t i = 0; i < static_cast<ptrdiff_t>(output_size); ++i) {
-            y_half[i] = utils::cast<bf16_t>(y_float[i]);
+    switch (plan.algo) {
+    case ConvAlgo::IM2COL_GEMM:
+        convGemm(info, plan.gemm, weights, scratch, epilogue, y_ptr, x_ptr);
+        break;
+    case ConvAlgo::WINOGRAD:
+        if (plan.winograd.m == 4) {
+            convWinograd<4>(plan.winograd, weights, scratch, epilogue, y_ptr, x_ptr);
+        } else {
+            convWinograd<2>(plan.winograd, weights, scratch, epilogue, y_ptr, x_ptr);
         }
+        break;
+    case ConvAlgo::DEPTHWISE:
+        convDepthwise(info, plan.depthwise, weights, epilogue, y_ptr, x_ptr);
+        break;
+    default:
+        applyConv(info, plan.direct, epilogue, y_ptr, x_ptr, w_ptr);
+        break;
     }
+    return INFINI_STATUS_SUCCESS;
+}
 
+infiniStatus_t Descriptor::setActivation(infiniopConvActivation_t activation) {
+    _activation = activation;
     return INFINI_STATUS_SUCCESS;
 }
 
@@ -348,13 +981,43 @@ infiniStatus_t Descriptor::calculate(
     if (workspace_size < _workspace_size) {
         return INFINI_STATUS_INSUFFICIENT_WORKSPACE;
     }
+
+    // 权重不变时预处理后的权重只算一次；缓存在调用期间加锁，避免并发调用时被其他权重覆盖。
+    // 提示可能在其他线程上修改，提示和 epoch 都是原子量，epoch 变化时重新预处理
+    const auto &plan = _opaque->plan;
+    const float *weights = nullptr;
+    const size_t weight_epoch = _weight_epoch.load();
+    std::unique_lock<std::mutex> lock(_opaque->mutex, std::defer_lock);
+    if (_weight_hint.load() == INFINIOP_CONV_WEIGHT_HINT_CONSTANT && plan.weightSize() > 0) {
+        lock.lock();
+        if (_opaque->weights_key != w || _opaque->weights_epoch != weight_epoch) {
+            _opaque->weights.resize(plan.weightSize());
+            switch (_dtype) {
+            case INFINI_DTYPE_F16:
+                prepareWeights(plan, _opaque->weights.data(), reinterpret_cast<const fp16_t *>(w));
+                break;
+            case INFINI_DTYPE_F32:
+                prepareWeights(plan, _opaque->weights.data(), reinterpret_cast<const float *>(w));
+                break;
+            case INFINI_DTYPE_BF16:
+                prepareWeights(plan, _opaque->weights.data(), reinterpret_cast<const bf16_t *>(w));
+                break;
+            default:
+                return INFINI_STATUS_BAD_TENSOR_DTYPE;
+            }
+            _opaque->weights_key = w;
+            _opaque->weights_epoch = weight_epoch;
+        }
+        weights = _opaque->weights.data();
+    }
+
     switch (_dtype) {
     case INFINI_DTYPE_F16:
-        return conv_cpu<fp16_t>(_info, workspace, workspace_size, y, x, w, bias);
+        return conv_cpu<fp16_t>(_info, plan, weights, _activation, workspace, workspace_size, y, x, w, bias);
     case INFINI_DTYPE_F32:
-        return conv_cpu<float>(_info, workspace, workspace_size, y, x, w, bias);
+        return conv_cpu<float>(_info, plan, weights, _activation, workspace, workspace_size, y, x, w, bias);
     case INFINI_DTYPE_BF16:
-        return conv_cpu<bf16_t>(_info, workspace, workspace_size, y, x, w, bias);
+        return conv_cpu<bf16_t>(_info, plan, weights, _activation, workspace, workspace_size, y, x, w, bias);
     default:
         return INFINI_STATUS_BAD_TENSOR_DTYPE;
     }
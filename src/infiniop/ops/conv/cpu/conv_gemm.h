@@ -0,0 +1,87 @@
+#ifndef __CONV_GEMM_CPU_H__
+#define __CONV_GEMM_CPU_H__
+
+#include "../../../devices/cpu/common_cpu.h"
+#include <algorithm>
+#include <cstddef>
+
+namespace op::conv::cpu::gemm {
+
+// 微内核计算 MR x NR 的输出块，累加器全部留在寄存器中
+constexpr size_t MR = 4;
+constexpr size_t NR = 8;
+// 归约维分块，打包后 A 的 KC x MR 小条和 B 的 KC x NR 小条都留在 L1 中
+constexpr size_t KC = 256;
+
+inline size_t roundUp(size_t n, size_t align) {
+    return (n + align - 1) / align * align;
+}
+
+// 把 rows x k 的矩阵按 LANES 行一组打包成 [rows/LANES][k][LANES]，不足的行补零。
+// 第 i 行第 j 列的元素为 a[i * k + col_offsets[j]]
+template <size_t LANES, typename T>
+void packRows(float *packed, const T *a, size_t rows, size_t k, const ptrdiff_t *col_offsets) {
+    const ptrdiff_t panels = ptrdiff_t((rows + LANES - 1) / LANES);
+#pragma omp parallel for
+    for (ptrdiff_t p = 0; p < panels; ++p) {
+        auto dst = packed + p * k * LANES;
+        for (size_t i = 0; i < LANES; ++i) {
+            size_t row = p * LANES + i;
+            if (row < rows) {
+                auto src = a + row * k;
+                for (size_t j = 0; j < k; ++j) {
+                    dst[j * LANES + i] = op::common_cpu::loadFloat(src[col_offsets[j]]);
+                }
+            } else {
+                for (size_t j = 0; j < k; ++j) {
+                    dst[j * LANES + i] = 0.f;
+                }
+            }
+        }
+    }
+}
+
+// acc = a[kc x MR]^T * b[kc x NR]，a、b 为打包后的小条，结果留在寄存器中由调用者写回
+inline void microKernel(
+    size_t kc,
+    const float *a,
+    const float *b,
+    float (&acc)[MR][NR]) {
+
+    for (size_t i = 0; i < MR; ++i) {
+        for (size_t j = 0; j < NR; ++j) {
+            acc[i][j] = 0.f;
+        }
+    }
+    for (size_t k = 0; k < kc; ++k) {
+        for (size_t i = 0; i < MR; ++i) {
+            const float a_ = a[k * MR + i];
+#pragma omp simd
+            for (size_t j = 0; j < NR; ++j) {
+                acc[i][j] += a_ * b[k * NR + j];
+            }
+        }
+    }
+}
+
+// acc (+)= c[m x n]，把之前 kc 块留下的部分和加到累加器上
+inline void loadTile(float (&acc)[MR][NR], const float *c, ptrdiff_t ldc, size_t m, size_t n) {
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            acc[i][j] += c[i * ldc + j];
+        }
+    }
+}
+
+// c[m x n] = acc 的有效部分
+inline void storeTile(const float (&acc)[MR][NR], float *c, ptrdiff_t ldc, size_t m, size_t n) {
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            c[i * ldc + j] = acc[i][j];
+        }
+    }
+}
+
+} // namespace op::conv::cpu::gemm
+
+#endif // __CONV_GEMM_CPU_H__
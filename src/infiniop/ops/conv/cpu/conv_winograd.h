@@ -0,0 +1,124 @@
+#ifndef __CONV_WINOGRAD_CPU_H__
+#define __CONV_WINOGRAD_CPU_H__
+
+#include <cstddef>
+
+// Winograd 快速卷积 F(M x M, 3 x 3)：Y = A^T [(G g G^T) ⊙ (B^T d B)] A，
+// 每个 (M + 2) x (M + 2) 的输入块只需 (M + 2)^2 次乘法即可得到 M x M 个输出。
+// 变换一次处理 LANES 个块，块在最内维，逐元素运算可以向量化
+namespace op::conv::cpu::winograd {
+
+template <size_t M>
+struct Matrices;
+
+template <>
+struct Matrices<2> {
+    static constexpr size_t ALPHA = 4;
+    static constexpr float BT[ALPHA][ALPHA] = {
+        {1, 0, -1, 0},
+        {0, 1, 1, 0},
+        {0, -1, 1, 0},
+        {0, 1, 0, -1},
+    };
+    static constexpr float G[ALPHA][3] = {
+        {1, 0, 0},
+        {.5f, .5f, .5f},
+        {.5f, -.5f, .5f},
+        {0, 0, 1},
+    };
+    static constexpr float AT[2][ALPHA] = {
+        {1, 1, 1, 0},
+        {0, 1, -1, -1},
+    };
+};
+
+template <>
+struct Matrices<4> {
+    static constexpr size_t ALPHA = 6;
+    static constexpr float BT[ALPHA][ALPHA] = {
+        {4, 0, -5, 0, 1, 0},
+        {0, -4, -4, 1, 1, 0},
+        {0, 4, -4, -1, 1, 0},
+        {0, -2, -1, 2, 1, 0},
+        {0, 2, -1, -2, 1, 0},
+        {0, 4, 0, -5, 0, 1},
+    };
+    static constexpr float G[ALPHA][3] = {
+        {1 / 4.f, 0, 0},
+        {-1 / 6.f, -1 / 6.f, -1 / 6.f},
+        {-1 / 6.f, 1 / 6.f, -1 / 6.f},
+        {1 / 24.f, 1 / 12.f, 1 / 6.f},
+        {1 / 24.f, -1 / 12.f, 1 / 6.f},
+        {0, 0, 1},
+    };
+    static constexpr float AT[4][ALPHA] = {
+        {1, 1, 1, 1, 1, 0},
+        {0, 1, -1, 2, -2, 0},
+        {0, 1, 1, 4, 4, 0},
+        {0, 1, -1, 8, -8, 1},
+    };
+};
+
+// out[R][C][LANES] = L[R][K] * in[K][K][LANES] * L^T，L 为变换矩阵，系数为 0 的项跳过
+template <size_t R, size_t K, size_t LANES>
+inline void sandwich(float (*out)[R][LANES], const float (*in)[K][LANES], const float (&l)[R][K]) {
+    float tmp[R][K][LANES];
+    for (size_t i = 0; i < R; ++i) {
+        for (size_t j = 0; j < K; ++j) {
+#pragma omp simd
+            for (size_t v = 0; v < LANES; ++v) {
+                tmp[i][j][v] = 0.f;
+            }
+            for (size_t k = 0; k < K; ++k) {
+                const float c = l[i][k];
+                if (c == 0.f) {
+                    continue;
+                }
+#pragma omp simd
+                for (size_t v = 0; v < LANES; ++v) {
+                    tmp[i][j][v] += c * in[k][j][v];
+                }
+            }
+        }
+    }
+    for (size_t i = 0; i < R; ++i) {
+        for (size_t j = 0; j < R; ++j) {
+#pragma omp simd
+            for (size_t v = 0; v < LANES; ++v) {
+                out[i][j][v] = 0.f;
+            }
+            for (size_t k = 0; k < K; ++k) {
+                const float c = l[j][k];
+                if (c == 0.f) {
+                    continue;
+                }
+#pragma omp simd
+                for (size_t v = 0; v < LANES; ++v) {
+                    out[i][j][v] += c * tmp[i][k][v];
+                }
+            }
+        }
+    }
+}
+
+// U = G g G^T
+template <size_t M>
+inline void filterTransform(float (*u)[Matrices<M>::ALPHA][1], const float (*g)[3][1]) {
+    sandwich<Matrices<M>::ALPHA, 3, 1>(u, g, Matrices<M>::G);
+}
+
+// V = B^T d B
+template <size_t M, size_t LANES>
+inline void inputTransform(float (*v)[Matrices<M>::ALPHA][LANES], const float (*d)[Matrices<M>::ALPHA][LANES]) {
+    sandwich<Matrices<M>::ALPHA, Matrices<M>::ALPHA, LANES>(v, d, Matrices<M>::BT);
+}
+
+// Y = A^T m A
+template <size_t M, size_t LANES>
+inline void outputTransform(float (*y)[M][LANES], const float (*m)[Matrices<M>::ALPHA][LANES]) {
+    sandwich<M, Matrices<M>::ALPHA, LANES>(y, m, Matrices<M>::AT);
+}
+
+} // namespace op::conv::cpu::winograd
+
+#endif // __CONV_WINOGRAD_CPU_H__
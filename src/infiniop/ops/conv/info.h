@@ -24,7 +24,8 @@ private:
     size_t _out_channels;
     size_t _spatial_sizes;
     size_t _bias_dims_size;
-    size_t _padded_shape_size;
+    size_t _groups;
+    bool _channels_last;
 
     ConvInfo(std::vector<size_t> meta,
              size_t ndim,
@@ -33,7 +34,8 @@ private:
              size_t out_channels,
              size_t spatial_sizes,
              size_t bias_dims_size,
-             size_t padded_shape_size)
+             size_t groups,
+             bool channels_last)
         : _meta(std::move(meta)),
           _ndim(ndim),
           _batch(batch),
@@ -41,7 +43,8 @@ private:
           _out_channels(out_channels),
           _spatial_sizes(spatial_sizes),
           _bias_dims_size(bias_dims_size),
-          _padded_shape_size(padded_shape_size) {}
+          _groups(groups),
+          _channels_last(channels_last) {}
 
 public:
     inline size_t ndim() const { return _ndim; }
@@ -50,7 +53,9 @@ public:
     inline size_t out_channels() const { return _out_channels; }
     inline size_t spatial_sizes() const { return _spatial_sizes; }
     inline size_t bias_dims_size() const { return _bias_dims_size; }
-    inline size_t padded_shape_size() const { return _padded_shape_size; }
+    inline size_t groups() const { return _groups; }
+    // x 和 y 按 [batch, 空间维..., channels] 连续存放
+    inline bool channels_last() const { return _channels_last; }
 
     inline size_t getMetaMemSize() const {
         return _meta.size() * sizeof(size_t);
@@ -80,9 +85,6 @@ public:
     inline const size_t *getDilationsInfo() const {
         return reinterpret_cast<const size_t *>(getStridesInfo()) + _ndim;
     }
-    inline const size_t *getPaddedShape() const {
-        return getDilationsInfo() + _ndim;
-    }
 
     inline size_t input_dim(size_t i) const {
         return i < _ndim ? getInputDims()[i] : 0;
@@ -105,9 +107,6 @@ public:
     inline size_t dilation_info(size_t i) const {
         return i < _ndim ? getDilationsInfo()[i] : 0;
     }
-    inline size_t padded_shape_dim(size_t i) const {
-        return i < _padded_shape_size ? getPaddedShape()[i] : 0;
-    }
 
     static utils::Result<ConvInfo> create(
         infiniopHandle_t handle_,
@@ -118,9 +117,23 @@ public:
         const void *pads,
         const void *strides,
         const void *dilations,
-        size_t n);
+        size_t n,
+        size_t groups);
 };
 
+// 张量是否按 order 给出的维度顺序（从外到内）连续存放，长度为 1 的维度不参与判断
+inline bool isDenseInOrder(infiniopTensorDescriptor_t desc, const std::vector<size_t> &order) {
+    ptrdiff_t expected = 1;
+    for (size_t i = order.size(); i-- > 0;) {
+        auto dim = order[i];
+        if (desc->dim(dim) != 1 && desc->stride(dim) != expected) {
+            return false;
+        }
+        expected *= ptrdiff_t(desc->dim(dim));
+    }
+    return true;
+}
+
 inline utils::Result<size_t> calculateConvOutputSize(
     size_t input_size,
     size_t kernel_size,
@@ -158,7 +171,8 @@ inline utils::Result<ConvInfo> ConvInfo::create(
     const void *pads,
     const void *strides,
     const void *dilations,
-    size_t n) {
+    size_t n,
+    size_t groups) {
 
     auto dtype = y_desc->dtype();
     if (dtype != x_desc->dtype() || dtype != w_desc->dtype()) {
@@ -176,26 +190,37 @@ inline utils::Result<ConvInfo> ConvInfo::create(
     size_t in_channels = x_desc->shape()[1];
     size_t out_channels = w_desc->shape()[0];
 
-    if (y_desc->shape()[0] != batch || y_desc->shape()[1] != out_channels || w_desc->shape()[1] != in_channels) {
+    if (groups == 0 || in_channels % groups != 0 || out_channels % groups != 0) {
+        return INFINI_STATUS_BAD_PARAM;
+    }
+    if (y_desc->shape()[0] != batch || y_desc->shape()[1] != out_channels || w_desc->shape()[1] != in_channels / groups) {
         return INFINI_STATUS_BAD_TENSOR_SHAPE;
     }
 
+    // x 和 y 同为通道优先或通道最后的连续布局，权重总是连续的
+    std::vector<size_t> channels_last_order(new_dims);
+    channels_last_order[0] = 0;
+    for (size_t i = 0; i < ndim; ++i) {
+        channels_last_order[i + 1] = i + 2;
+    }
+    channels_last_order[new_dims - 1] = 1;
+    bool channels_last = false;
+    if (!x_desc->isContiguous() || !y_desc->isContiguous()) {
+        channels_last = isDenseInOrder(x_desc, channels_last_order) && isDenseInOrder(y_desc, channels_last_order);
+        if (!channels_last) {
+            return INFINI_STATUS_BAD_TENSOR_STRIDES;
+        }
+    }
+    if (!w_desc->isContiguous()) {
+        return INFINI_STATUS_BAD_TENSOR_STRIDES;
+    }
+
     size_t bias_dims_size = (b_desc != nullptr) ? x_desc->ndim() : 0;
 
     const size_t *pads_ptr = reinterpret_cast<const size_t *>(pads);
-    bool has_padding = false;
-    if (pads_ptr != nullptr) {
-        for (size_t i = 0; i < ndim; ++i) {
-            if (pads_ptr[i] > 0) {
-                has_padding = true;
-                break;
-            }
-        }
-    }
-    size_t padded_shape_size = has_padding ? (ndim + 2) : 0;
 
     // 计算meta总大小
-    size_t meta_size = ndim * 6 + bias_dims_size + padded_shape_size;
+    size_t meta_size = ndim * 6 + bias_dims_size;
     std::vector<size_t> meta(meta_size);
 
     size_t *input_dims = meta.data();
@@ -205,7 +230,6 @@ inline utils::Result<ConvInfo> ConvInfo::create(
     size_t *pads_info = bias_dims + bias_dims_size;
     ptrdiff_t *strides_info = reinterpret_cast<ptrdiff_t *>(pads_info) + ndim;
     size_t *dilations_info = reinterpret_cast<size_t *>(strides_info) + ndim;
-    size_t *padded_shape = dilations_info + ndim;
 
     const ptrdiff_t *strides_ptr = reinterpret_cast<const ptrdiff_t *>(strides);
     const size_t *dilations_ptr = reinterpret_cast<const size_t *>(dilations);
@@ -238,16 +262,9 @@ inline utils::Result<ConvInfo> ConvInfo::create(
         bias_dims[1] = b_desc->shape()[0];
     }
 
-    if (padded_shape_size > 0) {
-        padded_shape[0] = batch;
-        padded_shape[1] = in_channels;
-        for (size_t i = 0; i < ndim; ++i) {
-            padded_shape[i + 2] = input_dims[i] + 2 * pads_info[i];
-        }
-    }
-
     ConvInfo info(std::move(meta), ndim, batch, in_channels, out_channels,
-                  spatial_sizes, bias_dims_size, padded_shape_size);
+                  spatial_sizes, bias_dims_size,
+                  groups, channels_last);
 
     return utils::Result<ConvInfo>(info);
 }
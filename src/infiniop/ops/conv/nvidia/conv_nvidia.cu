@@ -55,7 +55,7 @@ private:
         output_dims[0] = static_cast<int>(info.batch());
         output_dims[1] = static_cast<int>(info.out_channels());
         filter_dims[0] = static_cast<int>(info.out_channels());
-        filter_dims[1] = static_cast<int>(info.in_channels());
+        filter_dims[1] = static_cast<int>(info.in_channels() / info.groups());
 
         if (is_1d_conv) {
             input_dims[2] = 1;
@@ -124,17 +124,18 @@ private:
                                           const std::vector<int> &output_dims,
                                           const std::vector<int> &filter_dims,
                                           cudnnDataType_t cudnn_data_type,
-                                          int actual_tensor_ndim) {
+                                          int actual_tensor_ndim,
+                                          cudnnTensorFormat_t format) {
         CHECK_CUDNN(cudnnCreateTensorDescriptor(&x_desc));
         CHECK_CUDNN(cudnnCreateTensorDescriptor(&y_desc));
         CHECK_CUDNN(cudnnCreateFilterDescriptor(&w_desc));
         CHECK_CUDNN(cudnnCreateConvolutionDescriptor(&conv_desc));
 
         CHECK_CUDNN(cudnnSetTensorNdDescriptorEx(
-            x_desc, CUDNN_TENSOR_NCHW, cudnn_data_type,
+            x_desc, format, cudnn_data_type,
             actual_tensor_ndim, input_dims.data()));
         CHECK_CUDNN(cudnnSetTensorNdDescriptorEx(
-            y_desc, CUDNN_TENSOR_NCHW, cudnn_data_type,
+            y_desc, format, cudnn_data_type,
             actual_tensor_ndim, output_dims.data()));
         CHECK_CUDNN(cudnnSetFilterNdDescriptor(
             w_desc, cudnn_data_type, CUDNN_TENSOR_NCHW,
@@ -185,6 +186,7 @@ private:
                                               const std::vector<int> &strides,
                                               const std::vector<int> &dilations,
                                               int spatial_ndim,
+                                              int groups,
                                               cudnnDataType_t compute_type) {
         CHECK_CUDNN(cudnnSetConvolutionNdDescriptor(
             conv_desc,
@@ -194,6 +196,7 @@ private:
             dilations.data(),
             CUDNN_CROSS_CORRELATION,
             compute_type));
+        CHECK_CUDNN(cudnnSetConvolutionGroupCount(conv_desc, groups));
 
         return INFINI_STATUS_SUCCESS;
     }
@@ -316,12 +319,15 @@ public:
         CHECK_STATUS(getCudnnDataType(data_type, cudnn_data_type));
 
         CHECK_STATUS(createBasicDescriptors(input_dims_arr, output_dims_arr,
-                                            filter_dims_arr, cudnn_data_type, actual_tensor_ndim));
+                                            filter_dims_arr, cudnn_data_type, actual_tensor_ndim,
+                                            info.channels_last() ? CUDNN_TENSOR_NHWC : CUDNN_TENSOR_NCHW));
 
         CHECK_STATUS(createBiasDescriptors(info, cudnn_data_type, actual_tensor_ndim));
 
         CHECK_STATUS(setupConvolutionDescriptor(pads_arr, strides_arr, dilations_arr,
-                                                spatial_ndim_for_conv_desc, compute_type));
+                                                spatial_ndim_for_conv_desc,
+                                                static_cast<int>(info.groups()),
+                                                compute_type));
 
         if (info.bias_dims_size() == 0) {
             CHECK_STATUS(setupAlgorithmWithoutBias());
@@ -366,7 +372,8 @@ infiniStatus_t Descriptor::create(
     const void *pads,
     const void *strides,
     const void *dilations,
-    size_t n) {
+    size_t n,
+    size_t groups) {
 #ifdef ENABLE_CUDNN_API
     auto handle = reinterpret_cast<device::nvidia::Handle *>(handle_);
     auto dtype = y_desc->dtype();
@@ -374,7 +381,7 @@ infiniStatus_t Descriptor::create(
     CHECK_DTYPE(dtype, INFINI_DTYPE_F16, INFINI_DTYPE_F32, INFINI_DTYPE_BF16);
 
     auto result = ConvInfo::create(handle_, y_desc, x_desc, w_desc, b_desc,
-                                   pads, strides, dilations, n);
+                                   pads, strides, dilations, n, groups);
 
     CHECK_RESULT(result);
     auto conv_info = result.take();
@@ -395,6 +402,15 @@ infiniStatus_t Descriptor::create(
 #endif
 }
 
+infiniStatus_t Descriptor::setActivation(infiniopConvActivation_t activation) {
+    // cudnnConvolutionBiasActivationForward 只支持 ReLU 且要求带偏置，SiLU 无法融合，暂不支持任何激活
+    if (activation != INFINIOP_CONV_ACTIVATION_NONE) {
+        return INFINI_STATUS_NOT_IMPLEMENTED;
+    }
+    _activation = activation;
+    return INFINI_STATUS_SUCCESS;
+}
+
 infiniStatus_t Descriptor::calculate(
     void *workspace,
     size_t workspace_size,
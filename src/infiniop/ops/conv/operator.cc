@@ -18,7 +18,8 @@ __C __export infiniStatus_t infiniopCreateConvDescriptor(infiniopHandle_t handle
                                                          void *pads,
                                                          void *strides,
                                                          void *dilations,
-                                                         size_t n) {
+                                                         size_t n,
+                                                         size_t groups) {
 #define CREATE(CASE, NAMESPACE)                                             \
     case CASE:                                                              \
         return op::conv::NAMESPACE::Descriptor::create(                     \
@@ -31,7 +32,8 @@ __C __export infiniStatus_t infiniopCreateConvDescriptor(infiniopHandle_t handle
             pads,                                                           \
             strides,                                                        \
             dilations,                                                      \
-            n)
+            n,                                                              \
+            groups)
     switch (handle->device) {
 #ifdef ENABLE_CPU_API
         CREATE(INFINI_DEVICE_CPU, cpu);
@@ -78,6 +80,74 @@ infiniopGetConvWorkspaceSize(
 #undef GET
 }
 
+__C infiniStatus_t infiniopSetConvWeightHint(
+    infiniopConvDescriptor_t desc,
+    infiniopConvWeightHint_t hint) {
+
+    switch (hint) {
+    case INFINIOP_CONV_WEIGHT_HINT_DEFAULT:
+    case INFINIOP_CONV_WEIGHT_HINT_CONSTANT:
+        break;
+    default:
+        return INFINI_STATUS_BAD_PARAM;
+    }
+
+#define SET_HINT(CASE, NAMESPACE)                                                       \
+    case CASE:                                                                          \
+        reinterpret_cast<op::conv::NAMESPACE::Descriptor *>(desc)->setWeightHint(hint); \
+        return INFINI_STATUS_SUCCESS
+
+    switch (desc->device_type) {
+#ifdef ENABLE_CPU_API
+        SET_HINT(INFINI_DEVICE_CPU, cpu);
+#endif
+#ifdef ENABLE_NVIDIA_API
+        SET_HINT(INFINI_DEVICE_NVIDIA, nvidia);
+#endif
+#ifdef ENABLE_ILUVATAR_API
+        SET_HINT(INFINI_DEVICE_ILUVATAR, nvidia);
+#endif
+
+    default:
+        return INFINI_STATUS_DEVICE_TYPE_NOT_SUPPORTED;
+    }
+#undef SET_HINT
+}
+
+__C infiniStatus_t infiniopSetConvActivation(
+    infiniopConvDescriptor_t desc,
+    infiniopConvActivation_t activation) {
+
+    switch (activation) {
+    case INFINIOP_CONV_ACTIVATION_NONE:
+    case INFINIOP_CONV_ACTIVATION_RELU:
+    case INFINIOP_CONV_ACTIVATION_SILU:
+        break;
+    default:
+        return INFINI_STATUS_BAD_PARAM;
+    }
+
+#define SET_ACTIVATION(CASE, NAMESPACE) \
+    case CASE:                          \
+        return reinterpret_cast<op::conv::NAMESPACE::Descriptor *>(desc)->setActivation(activation)
+
+    switch (desc->device_type) {
+#ifdef ENABLE_CPU_API
+        SET_ACTIVATION(INFINI_DEVICE_CPU, cpu);
+#endif
+#ifdef ENABLE_NVIDIA_API
+        SET_ACTIVATION(INFINI_DEVICE_NVIDIA, nvidia);
+#endif
+#ifdef ENABLE_ILUVATAR_API
+        SET_ACTIVATION(INFINI_DEVICE_ILUVATAR, nvidia);
+#endif
+
+    default:
+        return INFINI_STATUS_DEVICE_TYPE_NOT_SUPPORTED;
+    }
+#undef SET_ACTIVATION
+}
+
 __C infiniStatus_t infiniopConv(
     infiniopConvDescriptor_t desc,
     void *workspace,
@@ -0,0 +1,82 @@
+#include "gather_cpu.h"
+#include "../../../devices/cpu/common_cpu.h"
+#include "index_copy_cpu.h"
+
+namespace op::gather::cpu {
+
+Descriptor::~Descriptor() = default;
+
+infiniStatus_t Descriptor::create(
+    infiniopHandle_t handle,
+    Descriptor **desc_ptr,
+    infiniopTensorDescriptor_t y_desc,
+    infiniopTensorDescriptor_t x_desc,
+    infiniopTensorDescriptor_t indices_desc,
+    int axis) {
+    auto result = IndexCopyInfo::create(y_desc, x_desc, indices_desc, axis, false);
+    CHECK_RESULT(result);
+    *desc_ptr = new Descriptor(nullptr, result.take(), handle->device, handle->device_id);
+    return INFINI_STATUS_SUCCESS;
+}
+
+template <typename Tindex>
+infiniStatus_t indexCopy(const IndexCopyInfo &info, char *y, const char *x, const Tindex *indices) {
+    const size_t n = info.n_indices;
+    // 先检查越界，避免拷贝到一半才报错
+    for (size_t i = 0; i < n; ++i) {
+        auto idx = indices[i * info.index_stride];
+        if (idx < 0 || size_t(idx) >= info.axis_len) {
+            return INFINI_STATUS_BAD_PARAM;
+        }
+    }
+
+    // 第 i 个索引对应的 y、x 片的起始地址
+    auto y_slice = [&](size_t i) {
+        auto y_i = info.scatter ? ptrdiff_t(indices[i * info.index_stride]) : ptrdiff_t(i);
+        return y + y_i * info.y_stride_axis;
+    };
+    auto x_slice = [&](size_t i) {
+        auto x_i = info.scatter ? ptrdiff_t(i) : ptrdiff_t(indices[i * info.index_stride]);
+        return x + x_i * info.x_stride_axis;
+    };
+
+    if (n >= op::common_cpu::maxThreads()) {
+        // 索引足够多时按索引并行，每片在线程内递推偏移整段拷贝
+        const size_t bytes = info.slice.count() * info.slice.unit();
+#pragma omp parallel for
+        for (ptrdiff_t i = 0; i < ptrdiff_t(n); ++i) {
+            auto y_ = y_slice(i);
+            auto x_ = x_slice(i);
+            info.slice.forEachRange(0, bytes, [=](ptrdiff_t y_offset, ptrdiff_t x_offset, size_t len) {
+                std::memcpy(y_ + y_offset, x_ + x_offset, len);
+            });
+        }
+    } else {
+        // 索引少而每片大时逐片拷贝，由 rearrange 在片内切分给各线程
+        for (size_t i = 0; i < n; ++i) {
+            info.slice.launch(y_slice(i), x_slice(i));
+        }
+    }
+    return INFINI_STATUS_SUCCESS;
+}
+
+infiniStatus_t indexCopy(const IndexCopyInfo &info, void *y, const void *x, const void *indices) {
+    switch (info.index_type) {
+    case INFINI_DTYPE_I32:
+        return indexCopy(info, (char *)y, (const char *)x, (const int32_t *)indices);
+    case INFINI_DTYPE_I64:
+        return indexCopy(info, (char *)y, (const char *)x, (const int64_t *)indices);
+    default:
+        return INFINI_STATUS_BAD_TENSOR_DTYPE;
+    }
+}
+
+infiniStatus_t Descriptor::calculate(
+    void *y,
+    const void *x,
+    const void *indices,
+    void *stream) const {
+    return indexCopy(_info, y, x, indices);
+}
+
+} // namespace op::gather::cpu
@@ -0,0 +1,8 @@
+#ifndef __GATHER_CPU_H__
+#define __GATHER_CPU_H__
+
+#include "../gather.h"
+
+DESCRIPTOR(cpu)
+
+#endif // __GATHER_CPU_H__
@@ -0,0 +1,13 @@
+#ifndef __INDEX_COPY_CPU_H__
+#define __INDEX_COPY_CPU_H__
+
+#include "../info.h"
+
+namespace op::gather::cpu {
+
+// gather 和 scatter 共用的按索引拷贝
+infiniStatus_t indexCopy(const IndexCopyInfo &info, void *y, const void *x, const void *indices);
+
+} // namespace op::gather::cpu
+
+#endif // __INDEX_COPY_CPU_H__
@@ -0,0 +1,43 @@
+#ifndef __GATHER_H__
+#define __GATHER_H__
+
+#include "../../operator.h"
+#include "info.h"
+
+#define DESCRIPTOR(NAMESPACE)                             \
+                                                          \
+    namespace op::gather::NAMESPACE {                     \
+    class Descriptor final : public InfiniopDescriptor {  \
+        struct Opaque;                                    \
+        Opaque *_opaque;                                  \
+        IndexCopyInfo _info;                              \
+                                                          \
+        Descriptor(                                       \
+            Opaque *opaque,                               \
+            IndexCopyInfo info,                           \
+            infiniDevice_t device_type,                   \
+            int device_id)                                \
+            : InfiniopDescriptor{device_type, device_id}, \
+              _opaque(opaque),                            \
+              _info(std::move(info)) {}                   \
+                                                          \
+    public:                                               \
+        ~Descriptor();                                    \
+                                                          \
+        static infiniStatus_t create(                     \
+            infiniopHandle_t handle,                      \
+            Descriptor **desc_ptr,                        \
+            infiniopTensorDescriptor_t y_desc,            \
+            infiniopTensorDescriptor_t x_desc,            \
+            infiniopTensorDescriptor_t indices_desc,      \
+            int axis);                                    \
+                                                          \
+        infiniStatus_t calculate(                         \
+            void *y,                                      \
+            const void *x,                                \
+            const void *indices,                          \
+            void *stream) const;                          \
+    };                                                    \
+    }
+
+#endif // __GATHER_H__
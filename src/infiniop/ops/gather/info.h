@@ -0,0 +1,83 @@
+#ifndef __GATHER_INFO_H__
+#define __GATHER_INFO_H__
+
+#include "../../../utils.h"
+#include "../../tensor.h"
+#include <vector>
+
+namespace op::gather {
+
+// 沿 axis 按索引拷贝：gather 时 x 的 axis 维被索引，y[..., i, ...] = x[..., indices[i], ...]；
+// scatter 时 y 的 axis 维被索引，y[..., indices[i], ...] = x[..., i, ...]
+class IndexCopyInfo {
+    IndexCopyInfo(utils::RearrangeMeta slice) : slice(std::move(slice)) {}
+
+public:
+    infiniDtype_t index_type;
+    bool scatter;
+
+    size_t n_indices;
+    // 被索引张量 axis 维的长度，用于检查越界
+    size_t axis_len;
+    // 字节步长
+    ptrdiff_t y_stride_axis, x_stride_axis;
+    ptrdiff_t index_stride;
+
+    // 除 axis 外的维度构成的一片，每个索引拷贝一片
+    utils::RearrangeMeta slice;
+
+    static utils::Result<IndexCopyInfo> create(
+        infiniopTensorDescriptor_t y_desc,
+        infiniopTensorDescriptor_t x_desc,
+        infiniopTensorDescriptor_t indices_desc,
+        int axis,
+        bool scatter) {
+
+        auto dtype = y_desc->dtype();
+        CHECK_OR_RETURN(x_desc->dtype() == dtype, INFINI_STATUS_BAD_TENSOR_DTYPE);
+        CHECK_DTYPE(indices_desc->dtype(), INFINI_DTYPE_I32, INFINI_DTYPE_I64);
+        CHECK_OR_RETURN(indices_desc->ndim() == 1, INFINI_STATUS_BAD_TENSOR_SHAPE);
+
+        auto ndim = ptrdiff_t(x_desc->ndim());
+        CHECK_OR_RETURN(ndim > 0 && ptrdiff_t(y_desc->ndim()) == ndim, INFINI_STATUS_BAD_TENSOR_SHAPE);
+        if (axis < 0) {
+            axis += int(ndim);
+        }
+        CHECK_OR_RETURN(axis >= 0 && axis < ndim, INFINI_STATUS_BAD_PARAM);
+
+        auto indexed = scatter ? y_desc : x_desc,
+             other = scatter ? x_desc : y_desc;
+        const size_t n_indices = indices_desc->dim(0);
+        CHECK_OR_RETURN(other->dim(axis) == n_indices, INFINI_STATUS_BAD_TENSOR_SHAPE);
+
+        std::vector<size_t> shape;
+        std::vector<ptrdiff_t> y_strides, x_strides;
+        for (ptrdiff_t i = 0; i < ndim; ++i) {
+            if (i == axis) {
+                continue;
+            }
+            CHECK_OR_RETURN(y_desc->dim(i) == x_desc->dim(i), INFINI_STATUS_BAD_TENSOR_SHAPE);
+            shape.push_back(y_desc->dim(i));
+            y_strides.push_back(y_desc->stride(i));
+            x_strides.push_back(x_desc->stride(i));
+        }
+        auto element_size = infiniSizeOf(dtype);
+        auto slice = utils::RearrangeMeta::create(
+            shape.data(), y_strides.data(), x_strides.data(), shape.size(), element_size);
+        CHECK_RESULT(slice);
+
+        IndexCopyInfo info(slice.take());
+        info.index_type = indices_desc->dtype();
+        info.scatter = scatter;
+        info.n_indices = n_indices;
+        info.axis_len = indexed->dim(axis);
+        info.y_stride_axis = y_desc->stride(axis) * ptrdiff_t(element_size);
+        info.x_stride_axis = x_desc->stride(axis) * ptrdiff_t(element_size);
+        info.index_stride = indices_desc->stride(0);
+        return utils::Result<IndexCopyInfo>(std::move(info));
+    }
+};
+
+} // namespace op::gather
+
+#endif // __GATHER_INFO_H__
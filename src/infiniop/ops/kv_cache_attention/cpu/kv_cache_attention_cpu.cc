@@ -0,0 +1,262 @@
+#include "kv_cache_attention_cpu.h"
+#include "../../../devices/cpu/common_cpu.h"
+#include "../../../reduce/cpu/reduce.h"
+#include <algorithm>
+#include <limits>
+
+namespace op::kv_cache_attention::cpu {
+
+// 每个线程的工作空间：缩放后的 q 行、输出累加器和一行注意力分数，有滑动窗口时一行最多 window 个分数
+inline size_t threadWorkspaceSize(const KVCacheAttentionInfo &info) {
+    const size_t window = info.mask.window,
+                 max_len = window == 0 ? info.total_seq_len() : std::min(window, info.total_seq_len());
+    return (2 * info.head_dim + max_len) * sizeof(float);
+}
+
+Descriptor::~Descriptor() = default;
+
+infiniStatus_t Descriptor::create(
+    infiniopHandle_t handle_,
+    Descriptor **desc_ptr,
+    infiniopTensorDescriptor_t out_desc,
+    infiniopTensorDescriptor_t q_desc,
+    infiniopTensorDescriptor_t k_desc,
+    infiniopTensorDescriptor_t v_desc,
+    infiniopTensorDescriptor_t k_cache_desc,
+    infiniopTensorDescriptor_t v_cache_desc,
+    infiniopTensorDescriptor_t k_scale_desc,
+    infiniopTensorDescriptor_t v_scale_desc,
+    size_t pos,
+    size_t window,
+    float alibi_max_bias) {
+    auto handle = reinterpret_cast<device::cpu::Handle *>(handle_);
+
+    auto result = KVCacheAttentionInfo::create(
+        out_desc, q_desc, k_desc, v_desc,
+        k_cache_desc, v_cache_desc,
+        k_scale_desc, v_scale_desc,
+        pos, window, alibi_max_bias);
+    CHECK_RESULT(result);
+    auto info = result.take();
+    auto workspace_size = op::common_cpu::maxThreads() * threadWorkspaceSize(info);
+
+    *desc_ptr = new Descriptor(
+        nullptr,
+        info,
+        workspace_size,
+        handle->device,
+        handle->device_id);
+    return INFINI_STATUS_SUCCESS;
+}
+
+// 把新的 k/v 写入缓存，量化缓存在写入时完成量化
+template <typename Tdata, typename Tcache>
+void appendCache(
+    const KVCacheAttentionInfo &info,
+    Tcache *cache, ptrdiff_t cache_stride_head, ptrdiff_t cache_stride_seq,
+    float *scale, ptrdiff_t scale_stride_head, ptrdiff_t scale_stride_seq,
+    const Tdata *x, ptrdiff_t x_stride_head, ptrdiff_t x_stride_seq) {
+
+#pragma omp parallel for
+    for (ptrdiff_t index = 0; index < ptrdiff_t(info.n_kv_head * info.seq_len); ++index) {
+        size_t h = index / info.seq_len,
+               i = index % info.seq_len;
+        auto x_ = x + h * x_stride_head + i * x_stride_seq;
+        auto cache_ = cache + h * cache_stride_head + (info.pos + i) * cache_stride_seq;
+
+        if constexpr (std::is_same<Tcache, Tdata>::value) {
+            std::memcpy(cache_, x_, info.head_dim * sizeof(Tdata));
+        } else {
+            auto scale_ = scale + h * scale_stride_head + (info.pos + i) * scale_stride_seq;
+            float s;
+            if (scale_stride_seq == 0) {
+                // 静态的逐头缩放因子，只读
+                s = *scale_;
+            } else {
+                float absmax = 0;
+                for (size_t d = 0; d < info.head_dim; ++d) {
+                    absmax = std::max(absmax, std::abs(op::common_cpu::loadFloat(x_[d])));
+                }
+                s = absmax > 0 ? absmax / op::common_cpu::Quant<Tcache>::max : 1.f;
+                *scale_ = s;
+            }
+            float inv_s = 1.f / s;
+            for (size_t d = 0; d < info.head_dim; ++d) {
+                cache_[d] = op::common_cpu::Quant<Tcache>::encode(op::common_cpu::loadFloat(x_[d]) * inv_s);
+            }
+        }
+    }
+}
+
+template <typename Tdata, typename Tcache>
+void attention(
+    const KVCacheAttentionInfo &info,
+    float *workspace, size_t nthreads,
+    Tdata *out,
+    const Tdata *q,
+    const Tcache *k_cache,
+    const Tcache *v_cache,
+    const float *k_scale,
+    const float *v_scale) {
+
+    constexpr bool quantized = !std::is_same<Tcache, Tdata>::value;
+    const size_t head_dim = info.head_dim,
+                 seq_len = info.seq_len,
+                 n_group = info.n_group();
+    const size_t thread_floats = threadWorkspaceSize(info) / sizeof(float);
+    const float qk_alpha = 1.f / std::sqrt(float(head_dim));
+
+#pragma omp parallel num_threads(nthreads)
+    {
+        float *q_ = workspace + op::common_cpu::threadId() * thread_floats;
+        float *acc = q_ + head_dim;
+        float *scores = acc + head_dim;
+
+#pragma omp for
+        for (ptrdiff_t index = 0; index < ptrdiff_t(info.n_q_head * seq_len); ++index) {
+            size_t h = index / seq_len,
+                   i = index % seq_len,
+                   kv_h = h / n_group;
+            // 因果掩码：第 i 个 token 能看到缓存中 [begin, pos + i] 的位置，窗口之外的块直接跳过
+            size_t end = info.pos + i + 1,
+                   begin = info.mask.begin(end - 1),
+                   len = end - begin;
+            float slope = info.mask.alibiSlope(h, info.n_q_head);
+
+            auto q_row = q + h * info.q_stride_head + i * info.q_stride_seq;
+            for (size_t d = 0; d < head_dim; ++d) {
+                q_[d] = op::common_cpu::loadFloat(q_row[d]) * qk_alpha;
+            }
+
+            // q * k^T，反量化的缩放因子提到内积之外
+            auto k_ = k_cache + kv_h * info.k_cache_stride_head;
+            float max_val = -std::numeric_limits<float>::infinity();
+            for (size_t j = 0; j < len; ++j) {
+                auto k_row = k_ + (begin + j) * info.k_cache_stride_seq;
+                float dot = 0;
+#pragma omp simd reduction(+ : dot)
+                for (size_t d = 0; d < head_dim; ++d) {
+                    dot += q_[d] * op::common_cpu::loadFloat(k_row[d]);
+                }
+                if constexpr (quantized) {
+                    dot *= k_scale[kv_h * info.k_scale_stride_head + (begin + j) * info.k_scale_stride_seq];
+                }
+                dot += slope * (float(begin + j) - float(end - 1));
+                scores[j] = dot;
+                max_val = std::max(max_val, dot);
+            }
+
+            // softmax
+            float sum = 0;
+            for (size_t j = 0; j < len; ++j) {
+                scores[j] = op::common_cpu::fastExp(scores[j] - max_val);
+                sum += scores[j];
+            }
+
+            // softmax(qk) * v，反量化的缩放因子并入注意力权重
+            std::fill(acc, acc + head_dim, 0.f);
+            auto v_ = v_cache + kv_h * info.v_cache_stride_head;
+            for (size_t j = 0; j < len; ++j) {
+                auto v_row = v_ + (begin + j) * info.v_cache_stride_seq;
+                float p = scores[j];
+                if constexpr (quantized) {
+                    p *= v_scale[kv_h * info.v_scale_stride_head + (begin + j) * info.v_scale_stride_seq];
+                }
+                for (size_t d = 0; d < head_dim; ++d) {
+                    acc[d] += p * op::common_cpu::loadFloat(v_row[d]);
+                }
+            }
+
+            auto out_row = out + i * info.out_stride_seq + h * info.out_stride_head;
+            float inv_sum = 1.f / sum;
+            for (size_t d = 0; d < head_dim; ++d) {
+                op::common_cpu::storeFloat(out_row[d], acc[d] * inv_sum);
+            }
+        }
+    }
+}
+
+template <typename Tdata, typename Tcache>
+infiniStatus_t calculateKVCacheAttention(
+    const KVCacheAttentionInfo &info,
+    void *workspace, size_t nthreads,
+    void *out, const void *q, const void *k, const void *v,
+    void *k_cache, void *v_cache,
+    void *k_scale, void *v_scale) {
+
+    appendCache(info,
+                reinterpret_cast<Tcache *>(k_cache), info.k_cache_stride_head, info.k_cache_stride_seq,
+                reinterpret_cast<float *>(k_scale), info.k_scale_stride_head, info.k_scale_stride_seq,
+                reinterpret_cast<const Tdata *>(k), info.k_stride_head, info.k_stride_seq);
+    appendCache(info,
+                reinterpret_cast<Tcache *>(v_cache), info.v_cache_stride_head, info.v_cache_stride_seq,
+                reinterpret_cast<float *>(v_scale), info.v_scale_stride_head, info.v_scale_stride_seq,
+                reinterpret_cast<const Tdata *>(v), info.v_stride_head, info.v_stride_seq);
+
+    attention(info,
+              reinterpret_cast<float *>(workspace), nthreads,
+              reinterpret_cast<Tdata *>(out),
+              reinterpret_cast<const Tdata *>(q),
+              reinterpret_cast<const Tcache *>(k_cache),
+              reinterpret_cast<const Tcache *>(v_cache),
+              reinterpret_cast<const float *>(k_scale),
+              reinterpret_cast<const float *>(v_scale));
+
+    return INFINI_STATUS_SUCCESS;
+}
+
+template <typename Tdata>
+infiniStatus_t dispatchCacheType(
+    const KVCacheAttentionInfo &info,
+    void *workspace, size_t nthreads,
+    void *out, const void *q, const void *k, const void *v,
+    void *k_cache, void *v_cache,
+    void *k_scale, void *v_scale) {
+
+#define CALCULATE(TCACHE)                        \
+    calculateKVCacheAttention<Tdata, TCACHE>(    \
+        info, workspace, nthreads, out, q, k, v, \
+        k_cache, v_cache, k_scale, v_scale)
+
+    switch (info.cache_dtype) {
+    case INFINI_DTYPE_I8:
+        return CALCULATE(int8_t);
+    case INFINI_DTYPE_F8:
+        return CALCULATE(fp8_t);
+    default:
+        return CALCULATE(Tdata);
+    }
+
+#undef CALCULATE
+}
+
+infiniStatus_t Descriptor::calculate(
+    void *workspace, size_t workspace_size,
+    void *out,
+    const void *q,
+    const void *k,
+    const void *v,
+    void *k_cache,
+    void *v_cache,
+    void *k_scale,
+    void *v_scale,
+    void *stream) const {
+
+    if (workspace_size < _workspace_size) {
+        return INFINI_STATUS_INSUFFICIENT_WORKSPACE;
+    }
+    auto nthreads = _workspace_size / threadWorkspaceSize(_info);
+
+    switch (_info.dtype) {
+    case INFINI_DTYPE_F16:
+        return dispatchCacheType<fp16_t>(_info, workspace, nthreads, out, q, k, v, k_cache, v_cache, k_scale, v_scale);
+    case INFINI_DTYPE_BF16:
+        return dispatchCacheType<bf16_t>(_info, workspace, nthreads, out, q, k, v, k_cache, v_cache, k_scale, v_scale);
+    case INFINI_DTYPE_F32:
+        return dispatchCacheType<float>(_info, workspace, nthreads, out, q, k, v, k_cache, v_cache, k_scale, v_scale);
+    default:
+        return INFINI_STATUS_BAD_TENSOR_DTYPE;
+    }
+}
+
+} // namespace op::kv_cache_attention::cpu
@@ -0,0 +1,8 @@
+#ifndef __KV_CACHE_ATTENTION_CPU_H__
+#define __KV_CACHE_ATTENTION_CPU_H__
+
+#include "../kv_cache_attention.h"
+
+DESCRIPTOR(cpu)
+
+#endif // __KV_CACHE_ATTENTION_CPU_H__
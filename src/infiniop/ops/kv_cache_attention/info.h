@@ -0,0 +1,137 @@
+#ifndef __KV_CACHE_ATTENTION_INFO_H__
+#define __KV_CACHE_ATTENTION_INFO_H__
+
+#include "../../../utils.h"
+#include "../../tensor.h"
+#include "../causal_softmax/info.h"
+
+namespace op::kv_cache_attention {
+
+class KVCacheAttentionInfo {
+    KVCacheAttentionInfo() = default;
+
+public:
+    infiniDtype_t dtype, cache_dtype;
+    size_t n_q_head, n_kv_head, seq_len, head_dim, pos;
+
+    ptrdiff_t out_stride_seq, out_stride_head;
+    ptrdiff_t q_stride_head, q_stride_seq;
+    ptrdiff_t k_stride_head, k_stride_seq;
+    ptrdiff_t v_stride_head, v_stride_seq;
+    ptrdiff_t k_cache_stride_head, k_cache_stride_seq;
+    ptrdiff_t v_cache_stride_head, v_cache_stride_seq;
+    // 量化缓存的缩放因子步长，seq 维步长为 0 表示静态的逐头缩放
+    ptrdiff_t k_scale_stride_head, k_scale_stride_seq;
+    ptrdiff_t v_scale_stride_head, v_scale_stride_seq;
+
+    op::causal_softmax::CausalMask mask;
+
+    size_t n_group() const { return n_q_head / n_kv_head; }
+    size_t total_seq_len() const { return pos + seq_len; }
+    bool quantized() const { return cache_dtype != dtype; }
+
+    static utils::Result<KVCacheAttentionInfo> create(
+        infiniopTensorDescriptor_t out_desc,
+        infiniopTensorDescriptor_t q_desc,
+        infiniopTensorDescriptor_t k_desc,
+        infiniopTensorDescriptor_t v_desc,
+        infiniopTensorDescriptor_t k_cache_desc,
+        infiniopTensorDescriptor_t v_cache_desc,
+        infiniopTensorDescriptor_t k_scale_desc,
+        infiniopTensorDescriptor_t v_scale_desc,
+        size_t pos,
+        size_t window,
+        float alibi_max_bias) {
+
+        auto dtype = q_desc->dtype();
+        auto cache_dtype = k_cache_desc->dtype();
+        CHECK_DTYPE(dtype, INFINI_DTYPE_F16, INFINI_DTYPE_BF16, INFINI_DTYPE_F32);
+        CHECK_OR_RETURN(out_desc->dtype() == dtype
+                            && k_desc->dtype() == dtype
+                            && v_desc->dtype() == dtype
+                            && v_cache_desc->dtype() == cache_dtype,
+                        INFINI_STATUS_BAD_TENSOR_DTYPE);
+        CHECK_OR_RETURN(cache_dtype == dtype || cache_dtype == INFINI_DTYPE_I8 || cache_dtype == INFINI_DTYPE_F8,
+                        INFINI_STATUS_BAD_TENSOR_DTYPE);
+
+        CHECK_OR_RETURN(out_desc->ndim() == 3
+                            && q_desc->ndim() == 3
+                            && k_desc->ndim() == 3
+                            && v_desc->ndim() == 3
+                            && k_cache_desc->ndim() == 3
+                            && v_cache_desc->ndim() == 3,
+                        INFINI_STATUS_BAD_TENSOR_SHAPE);
+
+        auto n_q_head = q_desc->dim(0),
+             seq_len = q_desc->dim(1),
+             head_dim = q_desc->dim(2),
+             n_kv_head = k_desc->dim(0),
+             total_seq_len = pos + seq_len;
+
+        CHECK_OR_RETURN(std::isfinite(alibi_max_bias) && alibi_max_bias >= 0.f, INFINI_STATUS_BAD_PARAM);
+        CHECK_OR_RETURN(n_kv_head > 0 && n_q_head % n_kv_head == 0, INFINI_STATUS_BAD_TENSOR_SHAPE);
+        CHECK_OR_RETURN(out_desc->dim(0) == seq_len && out_desc->dim(1) == n_q_head && out_desc->dim(2) == head_dim,
+                        INFINI_STATUS_BAD_TENSOR_SHAPE);
+        for (auto desc : {k_desc, v_desc}) {
+            CHECK_OR_RETURN(desc->dim(0) == n_kv_head && desc->dim(1) == seq_len && desc->dim(2) == head_dim,
+                            INFINI_STATUS_BAD_TENSOR_SHAPE);
+        }
+        for (auto desc : {k_cache_desc, v_cache_desc}) {
+            CHECK_OR_RETURN(desc->dim(0) == n_kv_head && desc->dim(1) >= total_seq_len && desc->dim(2) == head_dim,
+                            INFINI_STATUS_BAD_TENSOR_SHAPE);
+        }
+        // head_dim 必须连续
+        for (auto desc : {out_desc, q_desc, k_desc, v_desc, k_cache_desc, v_cache_desc}) {
+            CHECK_OR_RETURN(desc->stride(2) == 1, INFINI_STATUS_BAD_TENSOR_STRIDES);
+        }
+
+        ptrdiff_t scale_strides[4] = {0, 0, 0, 0};
+        if (cache_dtype != dtype) {
+            CHECK_OR_RETURN(k_scale_desc != nullptr && v_scale_desc != nullptr, INFINI_STATUS_NULL_POINTER);
+            for (auto desc : {k_scale_desc, v_scale_desc}) {
+                CHECK_OR_RETURN(desc->dtype() == INFINI_DTYPE_F32, INFINI_STATUS_BAD_TENSOR_DTYPE);
+                CHECK_OR_RETURN(desc->ndim() == 2
+                                    && desc->dim(0) == n_kv_head
+                                    && (desc->dim(1) >= total_seq_len || desc->stride(1) == 0),
+                                INFINI_STATUS_BAD_TENSOR_SHAPE);
+            }
+            scale_strides[0] = k_scale_desc->stride(0);
+            scale_strides[1] = k_scale_desc->stride(1);
+            scale_strides[2] = v_scale_desc->stride(0);
+            scale_strides[3] = v_scale_desc->stride(1);
+        } else {
+            CHECK_OR_RETURN(k_scale_desc == nullptr && v_scale_desc == nullptr, INFINI_STATUS_BAD_PARAM);
+        }
+
+        return utils::Result<KVCacheAttentionInfo>(KVCacheAttentionInfo{
+            dtype,
+            cache_dtype,
+            n_q_head,
+            n_kv_head,
+            seq_len,
+            head_dim,
+            pos,
+            out_desc->stride(0),
+            out_desc->stride(1),
+            q_desc->stride(0),
+            q_desc->stride(1),
+            k_desc->stride(0),
+            k_desc->stride(1),
+            v_desc->stride(0),
+            v_desc->stride(1),
+            k_cache_desc->stride(0),
+            k_cache_desc->stride(1),
+            v_cache_desc->stride(0),
+            v_cache_desc->stride(1),
+            scale_strides[0],
+            scale_strides[1],
+            scale_strides[2],
+            scale_strides[3],
+            op::causal_softmax::CausalMask{window, alibi_max_bias},
+        });
+    }
+};
+
+} // namespace op::kv_cache_attention
+
+#endif // __KV_CACHE_ATTENTION_INFO_H__
@@ -0,0 +1,116 @@
+#include "../../operator.h"
+#include "../../handle.h"
+#include "infiniop/ops/kv_cache_attention.h"
+
+#ifdef ENABLE_CPU_API
+#include "cpu/kv_cache_attention_cpu.h"
+#endif
+
+__C infiniStatus_t infiniopCreateKVCacheAttentionDescriptor(
+    infiniopHandle_t handle,
+    infiniopKVCacheAttentionDescriptor_t *desc_ptr,
+    infiniopTensorDescriptor_t out_desc,
+    infiniopTensorDescriptor_t q_desc,
+    infiniopTensorDescriptor_t k_desc,
+    infiniopTensorDescriptor_t v_desc,
+    infiniopTensorDescriptor_t k_cache_desc,
+    infiniopTensorDescriptor_t v_cache_desc,
+    infiniopTensorDescriptor_t k_scale_desc,
+    infiniopTensorDescriptor_t v_scale_desc,
+    size_t pos,
+    size_t window,
+    float alibi_max_bias) {
+
+#define CREATE(CASE, NAMESPACE)                                                           \
+    case CASE:                                                                            \
+        return op::kv_cache_attention::NAMESPACE::Descriptor::create(                     \
+            handle,                                                                       \
+            reinterpret_cast<op::kv_cache_attention::NAMESPACE::Descriptor **>(desc_ptr), \
+            out_desc,                                                                     \
+            q_desc,                                                                       \
+            k_desc,                                                                       \
+            v_desc,                                                                       \
+            k_cache_desc,                                                                 \
+            v_cache_desc,                                                                 \
+            k_scale_desc,                                                                 \
+            v_scale_desc,                                                                 \
+            pos,                                                                          \
+            window,                                                                       \
+            alibi_max_bias)
+
+    switch (handle->device) {
+#ifdef ENABLE_CPU_API
+        CREATE(INFINI_DEVICE_CPU, cpu);
+#endif
+    }
+
+#undef CREATE
+
+    return INFINI_STATUS_DEVICE_TYPE_NOT_SUPPORTED;
+}
+
+__C infiniStatus_t infiniopGetKVCacheAttentionWorkspaceSize(infiniopKVCacheAttentionDescriptor_t desc, size_t *size) {
+
+#define GET(CASE, NAMESPACE)                                                                              \
+    case CASE:                                                                                            \
+        *size = reinterpret_cast<op::kv_cache_attention::NAMESPACE::Descriptor *>(desc)->workspaceSize(); \
+        return INFINI_STATUS_SUCCESS
+
+    switch (desc->device_type) {
+#ifdef ENABLE_CPU_API
+        GET(INFINI_DEVICE_CPU, cpu);
+#endif
+    }
+
+#undef GET
+
+    return INFINI_STATUS_DEVICE_TYPE_NOT_SUPPORTED;
+}
+
+__C infiniStatus_t infiniopKVCacheAttention(
+    infiniopKVCacheAttentionDescriptor_t desc,
+    void *workspace,
+    size_t workspace_size,
+    void *out,
+    const void *q,
+    const void *k,
+    const void *v,
+    void *k_cache,
+    void *v_cache,
+    void *k_scale,
+    void *v_scale,
+    void *stream) {
+
+#define CALCULATE(CASE, NAMESPACE)                                                                 \
+    case CASE:                                                                                     \
+        return reinterpret_cast<op::kv_cache_attention::NAMESPACE::Descriptor *>(desc)->calculate( \
+            workspace, workspace_size, out, q, k, v, k_cache, v_cache, k_scale, v_scale, stream)
+
+    switch (desc->device_type) {
+#ifdef ENABLE_CPU_API
+        CALCULATE(INFINI_DEVICE_CPU, cpu);
+#endif
+    }
+
+#undef CALCULATE
+
+    return INFINI_STATUS_DEVICE_TYPE_NOT_SUPPORTED;
+}
+
+__C infiniStatus_t infiniopDestroyKVCacheAttentionDescriptor(infiniopKVCacheAttentionDescriptor_t desc) {
+
+#define DESTROY(CASE, NAMESPACE)                                                        \
+    case CASE:                                                                          \
+        delete reinterpret_cast<op::kv_cache_attention::NAMESPACE::Descriptor *>(desc); \
+        return INFINI_STATUS_SUCCESS
+
+    switch (desc->device_type) {
+#ifdef ENABLE_CPU_API
+        DESTROY(INFINI_DEVICE_CPU, cpu);
+#endif
+    }
+
+#undef DESTROY
+
+    return INFINI_STATUS_DEVICE_TYPE_NOT_SUPPORTED;
+}
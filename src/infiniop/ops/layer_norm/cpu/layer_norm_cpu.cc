@@ -0,0 +1,176 @@
+#include "layer_norm_cpu.h"
+#include "../../../devices/cpu/common_cpu.h"
+#include "../../../reduce/cpu/reduce.h"
+
+namespace op::layer_norm::cpu {
+
+Descriptor::~Descriptor() {}
+
+infiniStatus_t Descriptor::create(
+    infiniopHandle_t handle,
+    Descriptor **desc_ptr,
+    infiniopTensorDescriptor_t y_desc,
+    infiniopTensorDescriptor_t residual_out_desc,
+    infiniopTensorDescriptor_t x_desc,
+    infiniopTensorDescriptor_t residual_desc,
+    infiniopTensorDescriptor_t w_desc,
+    infiniopTensorDescriptor_t b_desc,
+    float epsilon) {
+    auto result = LayerNormInfo::create(y_desc, residual_out_desc, x_desc, residual_desc, w_desc, b_desc, epsilon);
+    CHECK_RESULT(result);
+    auto info = result.take();
+    // 每个线程缓存一行输入（融合残差时为相加的结果），归一化时不必再读一遍输入
+    auto workspace_size = op::common_cpu::maxThreads() * op::rms_norm::rowWorkspaceSize(info.dim(), info.atype);
+    *desc_ptr = new Descriptor(nullptr, std::move(info), workspace_size, handle->device, handle->device_id);
+    return INFINI_STATUS_SUCCESS;
+}
+
+// 每次转换成计算类型参与归约的元素数
+constexpr size_t BLOCK_SIZE = 256;
+
+template <typename T, typename Tw, typename Tcompute, bool CONTIGUOUS>
+void layerNorm(
+    const LayerNormInfo &info,
+    Tcompute *workspace, size_t nthreads,
+    T *y, T *residual_out, const T *x, const T *residual, const Tw *w, const Tw *b) {
+
+    const size_t dim = info.dim(),
+                 nrow_dim = info.ndim() - 1;
+    const ptrdiff_t y_stride = CONTIGUOUS ? 1 : info.y_strides.back(),
+                    x_stride = CONTIGUOUS ? 1 : info.x_strides.back(),
+                    r_stride = !info.has_residual || CONTIGUOUS ? 1 : info.residual_strides.back(),
+                    ro_stride = !info.has_residual || CONTIGUOUS ? 1 : info.residual_out_strides.back();
+    auto offset = [&](size_t i, const std::vector<ptrdiff_t> &strides) -> ptrdiff_t {
+        if (nrow_dim == 1) {
+            return i * strides[0];
+        }
+        return op::common_cpu::indexToOffset(i, nrow_dim, info.shape.data(), strides.data());
+    };
+
+#pragma omp parallel num_threads(nthreads)
+    {
+        Tcompute *h = workspace + op::common_cpu::threadId() * dim;
+
+#pragma omp for
+        for (ptrdiff_t i = 0; i < ptrdiff_t(info.batch()); i++) {
+            auto x_ = x + offset(i, info.x_strides);
+            auto y_ = y + offset(i, info.y_strides);
+            const T *r_ = nullptr;
+            T *ro_ = nullptr;
+            if (info.has_residual) {
+                r_ = residual + offset(i, info.residual_strides);
+                ro_ = residual_out + offset(i, info.residual_out_strides);
+            }
+
+            // 读入一行并以 Welford 算法逐块归约均值和方差
+            op::common_cpu::reduce_op::MeanVarStat<Tcompute> stat;
+            for (size_t j = 0; j < dim; j += BLOCK_SIZE) {
+                size_t len = std::min(BLOCK_SIZE, dim - j);
+                if (info.has_residual) {
+                    // 归一化的输入取舍入到 T 之后的残差，与先做 add 再做 layer_norm 的结果一致
+                    for (size_t k = j; k < j + len; k++) {
+                        T sum;
+                        op::common_cpu::storeCompute(sum, op::common_cpu::loadCompute<Tcompute>(x_[k * x_stride]) + op::common_cpu::loadCompute<Tcompute>(r_[k * r_stride]));
+                        ro_[k * ro_stride] = sum;
+                        h[k] = op::common_cpu::loadCompute<Tcompute>(sum);
+                    }
+                } else {
+                    for (size_t k = j; k < j + len; k++) {
+                        h[k] = op::common_cpu::loadCompute<Tcompute>(x_[k * x_stride]);
+                    }
+                }
+                stat.update(h + j, len);
+            }
+
+            // 1 / sqrt(var + eps)
+            Tcompute mean = stat.mean,
+                     rstd = Tcompute(1) / std::sqrt(stat.variance() + Tcompute(info.epsilon));
+
+            if (b) {
+                for (size_t j = 0; j < dim; j++) {
+                    op::common_cpu::storeCompute(y_[j * y_stride], (h[j] - mean) * rstd * op::common_cpu::loadCompute<Tcompute>(w[j]) + op::common_cpu::loadCompute<Tcompute>(b[j]));
+                }
+            } else {
+                for (size_t j = 0; j < dim; j++) {
+                    op::common_cpu::storeCompute(y_[j * y_stride], (h[j] - mean) * rstd * op::common_cpu::loadCompute<Tcompute>(w[j]));
+                }
+            }
+        }
+    }
+}
+
+template <typename T, typename Tw, typename Tcompute>
+infiniStatus_t dispatchStride(
+    const LayerNormInfo &info,
+    void *workspace, size_t nthreads,
+    void *y, void *residual_out, const void *x, const void *residual, const void *w, const void *b) {
+
+    bool contiguous = info.y_strides.back() == 1
+                   && info.x_strides.back() == 1
+                   && (!info.has_residual
+                       || (info.residual_strides.back() == 1 && info.residual_out_strides.back() == 1));
+
+#define CALCULATE(CONTIGUOUS)                                         \
+    layerNorm<T, Tw, Tcompute, CONTIGUOUS>(                           \
+        info, (Tcompute *)workspace, nthreads,                        \
+        (T *)y, (T *)residual_out, (const T *)x, (const T *)residual, \
+        (const Tw *)w, (const Tw *)b)
+
+    if (contiguous) {
+        CALCULATE(true);
+    } else {
+        CALCULATE(false);
+    }
+    return INFINI_STATUS_SUCCESS;
+
+#undef CALCULATE
+}
+
+infiniStatus_t Descriptor::calculate(
+    void *workspace, size_t workspace_size,
+    void *y,
+    void *residual_out,
+    const void *x,
+    const void *residual,
+    const void *w,
+    const void *b,
+    void *stream) const {
+
+    if (workspace_size < _workspace_size) {
+        return INFINI_STATUS_INSUFFICIENT_WORKSPACE;
+    }
+    if ((_info.has_bias && b == nullptr)
+        || (_info.has_residual && (residual == nullptr || residual_out == nullptr))) {
+        return INFINI_STATUS_NULL_POINTER;
+    }
+    if (!_info.has_bias) {
+        b = nullptr;
+    }
+    auto nthreads = _workspace_size / op::rms_norm::rowWorkspaceSize(_info.dim(), _info.atype);
+
+#define DISPATCH(T, TW, TCOMPUTE) \
+    return dispatchStride<T, TW, TCOMPUTE>(_info, workspace, nthreads, y, residual_out, x, residual, w, b)
+
+    switch (_info.atype) {
+    case INFINI_DTYPE_F16:
+        if (_info.wtype == INFINI_DTYPE_F32) {
+            DISPATCH(fp16_t, float, float);
+        }
+        DISPATCH(fp16_t, fp16_t, float);
+    case INFINI_DTYPE_BF16:
+        if (_info.wtype == INFINI_DTYPE_F32) {
+            DISPATCH(bf16_t, float, float);
+        }
+        DISPATCH(bf16_t, bf16_t, float);
+    case INFINI_DTYPE_F32:
+        DISPATCH(float, float, float);
+    case INFINI_DTYPE_F64:
+        DISPATCH(double, double, double);
+    default:
+        return INFINI_STATUS_BAD_TENSOR_DTYPE;
+    }
+
+#undef DISPATCH
+}
+
+} // namespace op::layer_norm::cpu
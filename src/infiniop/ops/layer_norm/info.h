@@ -0,0 +1,97 @@
+#ifndef __LAYER_NORM_INFO_H__
+#define __LAYER_NORM_INFO_H__
+
+#include "../rms_norm/info.h"
+
+namespace op::layer_norm {
+
+class LayerNormInfo {
+    LayerNormInfo() = default;
+
+public:
+    infiniDtype_t wtype;
+    infiniDtype_t atype;
+    float epsilon;
+    bool has_bias;
+    // 是否融合残差：先计算 residual_out = x + residual，再对其归一化
+    bool has_residual;
+    // 合并后的形状和步长，至少二维；前面的维度不能合并成一维时多于二维
+    std::vector<size_t> shape;
+    std::vector<ptrdiff_t> y_strides;
+    std::vector<ptrdiff_t> x_strides;
+    std::vector<ptrdiff_t> residual_strides;
+    std::vector<ptrdiff_t> residual_out_strides;
+
+    size_t ndim() const { return shape.size(); }
+    size_t dim() const { return shape[ndim() - 1]; }
+    // 行数，即除最后一维外所有维度的乘积
+    size_t batch() const {
+        size_t n = 1;
+        for (size_t i = 0; i + 1 < ndim(); ++i) {
+            n *= shape[i];
+        }
+        return n;
+    }
+
+    static utils::Result<LayerNormInfo> create(
+        infiniopTensorDescriptor_t y_desc,
+        infiniopTensorDescriptor_t residual_out_desc,
+        infiniopTensorDescriptor_t x_desc,
+        infiniopTensorDescriptor_t residual_desc,
+        infiniopTensorDescriptor_t w_desc,
+        infiniopTensorDescriptor_t b_desc,
+        float epsilon) {
+
+        // 激活和权重的类型组合与 rms_norm 相同，偏置与权重类型相同
+        auto atype = y_desc->dtype();
+        auto wtype = w_desc->dtype();
+        CHECK_OR_RETURN(x_desc->dtype() == atype, INFINI_STATUS_BAD_TENSOR_DTYPE);
+        CHECK_OR_RETURN(op::rms_norm::isSupportedDtype(atype, wtype), INFINI_STATUS_BAD_TENSOR_DTYPE);
+
+        CHECK_SAME_SHAPE(y_desc->shape(), x_desc->shape());
+        auto ndim = x_desc->ndim();
+        CHECK_OR_RETURN(ndim > 0 && w_desc->ndim() == 1, INFINI_STATUS_BAD_TENSOR_SHAPE);
+        size_t dim = x_desc->dim(ndim - 1);
+        CHECK_OR_RETURN(dim > 0 && w_desc->dim(0) == dim, INFINI_STATUS_BAD_TENSOR_SHAPE);
+        CHECK_OR_RETURN(w_desc->stride(0) == 1, INFINI_STATUS_BAD_TENSOR_STRIDES);
+
+        if (b_desc) {
+            CHECK_OR_RETURN(b_desc->dtype() == wtype, INFINI_STATUS_BAD_TENSOR_DTYPE);
+            CHECK_SAME_SHAPE(b_desc->shape(), w_desc->shape());
+            CHECK_OR_RETURN(b_desc->stride(0) == 1, INFINI_STATUS_BAD_TENSOR_STRIDES);
+        }
+
+        // 残差的输入和输出必须同时给出
+        CHECK_OR_RETURN((residual_desc == nullptr) == (residual_out_desc == nullptr), INFINI_STATUS_NULL_POINTER);
+        std::vector<infiniopTensorDescriptor_t> descs{y_desc, x_desc};
+        if (residual_desc) {
+            CHECK_OR_RETURN(residual_desc->dtype() == atype && residual_out_desc->dtype() == atype,
+                            INFINI_STATUS_BAD_TENSOR_DTYPE);
+            CHECK_SAME_SHAPE(y_desc->shape(), residual_desc->shape(), residual_out_desc->shape());
+            descs.push_back(residual_desc);
+            descs.push_back(residual_out_desc);
+        }
+
+        LayerNormInfo info;
+        info.wtype = wtype;
+        info.atype = atype;
+        info.epsilon = epsilon;
+        info.has_bias = b_desc != nullptr;
+        info.has_residual = residual_desc != nullptr;
+
+        std::vector<std::vector<ptrdiff_t>> strides;
+        info.shape = op::rms_norm::mergeRowDims(descs, strides);
+        info.y_strides = std::move(strides[0]);
+        info.x_strides = std::move(strides[1]);
+        if (info.has_residual) {
+            info.residual_strides = std::move(strides[2]);
+            info.residual_out_strides = std::move(strides[3]);
+        }
+
+        return utils::Result<LayerNormInfo>(std::move(info));
+    }
+};
+
+} // namespace op::layer_norm
+
+#endif // __LAYER_NORM_INFO_H__
@@ -24,6 +24,8 @@ infiniStatus_t Descriptor::create(
     auto handle = reinterpret_cast<device::ascend::Handle *>(handle_);
     auto result = RandomSampleInfo::create(result_desc, probs_desc);
     CHECK_RESULT(result);
+    // 暂不支持批量采样
+    CHECK_OR_RETURN(result->batch == 1, INFINI_STATUS_NOT_IMPLEMENTED);
     CHECK_DTYPE(result->dt_i, INFINI_DTYPE_I64);
     auto workspace_size = probs_desc->numel() * infiniSizeOf(probs_desc->dtype()) + probs_desc->numel() * infiniSizeOf(infiniDtype_t::INFINI_DTYPE_I64);
     auto tresult = new aclnnTensorDescriptor(result_desc);
@@ -107,4 +109,18 @@ Descriptor::calculate(
 
     return INFINI_STATUS_SUCCESS;
 }
+
+infiniStatus_t Descriptor::calculateBatched(
+    void *workspace,
+    size_t workspace_size,
+    void *result,
+    const void *probs,
+    const float *random_val,
+    const float *topp,
+    const int *topk,
+    const float *temperature,
+    const infiniopLogitsProcessor_t *processors,
+    void *stream) const {
+    return INFINI_STATUS_NOT_IMPLEMENTED;
+}
 } // namespace op::random_sample::ascend
@@ -1,11 +1,52 @@
 #include "random_sample_cpu.h"
 #include "../../../devices/cpu/common_cpu.h"
+#include "../../../reduce/cpu/reduce.h"
 #include "../info.h"
 #include "infinicore.h"
 #include <algorithm>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <vector>
 
 namespace op::random_sample::cpu {
 
+template <typename DT>
+struct ComputeType {
+    using type = DT;
+};
+
+template <>
+struct ComputeType<fp16_t> {
+    using type = float;
+};
+
+template <>
+struct ComputeType<bf16_t> {
+    using type = float;
+};
+
+// 候选词：缩放后的 logit 和在词表中的下标
+template <class Tcompute>
+struct Candidate {
+    Tcompute val;
+    uint32_t idx;
+};
+
+// 按值从大到小排序，用作堆的比较函数时堆顶是最小值
+template <class Tcompute>
+inline bool greater(const Candidate<Tcompute> &a, const Candidate<Tcompute> &b) {
+    return a.val > b.val;
+}
+
+// 一行的工作空间：最坏情况下（topk 不小于词表）整个词表都是候选
+inline size_t rowWorkspaceSize(const RandomSampleInfo &info) {
+    return info.n
+         * (info.dt_p == INFINI_DTYPE_F64
+                ? sizeof(Candidate<double>)
+                : sizeof(Candidate<float>));
+}
+
 Descriptor::~Descriptor() = default;
 
 infiniStatus_t Descriptor::create(
@@ -17,10 +58,15 @@ infiniStatus_t Descriptor::create(
 
     auto result = RandomSampleInfo::create(result_desc, probs_desc);
     CHECK_RESULT(result);
+    CHECK_OR_RETURN(result->n > 0 && result->n <= UINT32_MAX, INFINI_STATUS_BAD_TENSOR_SHAPE);
+
+    // 按行并行时每个线程各用一行的工作空间
+    auto info = result.take();
+    auto workspace_size = std::min(info.batch, op::common_cpu::maxThreads()) * rowWorkspaceSize(info);
 
     *desc_ptr = new Descriptor(
-        result.take(),
-        0,
+        info,
+        workspace_size,
         nullptr,
         handle->device, handle->device_id);
     return INFINI_STATUS_SUCCESS;
@@ -30,92 +76,436 @@ size_t Descriptor::minWorkspaceSize() const {
     return _min_workspace_size;
 }
 
-template <typename DT>
-struct ComputeType {
-    using type = DT;
+// 每次转换成 float 参与归约的元素数
+constexpr size_t BLOCK_SIZE = 256;
+// topk 不超过扫描长度的 1/16 时在转换的同时用小顶堆筛选，否则把所有元素写入工作空间再做部分选择
+constexpr size_t HEAP_RATIO = 16;
+// 行数不足以占满线程时，长于此值的行在行内切分给各线程
+constexpr size_t MIN_SPLIT_LEN = 16384;
+
+// 块内最大值，NaN 被忽略。浮点的 max 归约需要 omp simd 才能向量化
+template <class T>
+inline T blockMax(const T *buf, size_t len) {
+    T val = -std::numeric_limits<T>::infinity();
+#pragma omp simd reduction(max : val)
+    for (size_t j = 0; j < len; j++) {
+        val = buf[j] > val ? buf[j] : val;
+    }
+    return val;
+}
+
+// 对单个词的 logit 的修改：偏置，以及出现过的词的重复、频率和存在惩罚
+struct Adjustment {
+    uint32_t idx, count;
+    float bias;
 };
 
-template <>
-struct ComputeType<fp16_t> {
-    using type = float;
+// 一行的 logits 处理，修改项按下标排序、合并，扫描时随块推进，不需要额外遍历词表
+struct Processors {
+    std::vector<Adjustment> adjustments;
+    float repetition_penalty, frequency_penalty, presence_penalty, min_p;
+
+    static infiniStatus_t check(const infiniopLogitsProcessor_t &p, size_t n) {
+        if ((p.num_tokens && !p.token_ids) || (p.num_bias && (!p.bias_token_ids || !p.bias_values))) {
+            return INFINI_STATUS_NULL_POINTER;
+        }
+        auto in_vocab = [n](int id) { return id >= 0 && size_t(id) < n; };
+        CHECK_OR_RETURN(std::all_of(p.token_ids, p.token_ids + p.num_tokens, in_vocab), INFINI_STATUS_BAD_PARAM);
+        CHECK_OR_RETURN(std::all_of(p.bias_token_ids, p.bias_token_ids + p.num_bias, in_vocab), INFINI_STATUS_BAD_PARAM);
+        CHECK_OR_RETURN(p.min_p >= 0 && p.min_p <= 1, INFINI_STATUS_BAD_PARAM);
+        return INFINI_STATUS_SUCCESS;
+    }
+
+    explicit Processors(const infiniopLogitsProcessor_t &p)
+        : repetition_penalty(p.repetition_penalty == 0 ? 1.f : p.repetition_penalty),
+          frequency_penalty(p.frequency_penalty),
+          presence_penalty(p.presence_penalty),
+          min_p(p.min_p) {
+
+        std::vector<Adjustment> raw;
+        raw.reserve(p.num_tokens + p.num_bias);
+        for (size_t i = 0; i < p.num_tokens; i++) {
+            raw.push_back({uint32_t(p.token_ids[i]), 1, 0.f});
+        }
+        for (size_t i = 0; i < p.num_bias; i++) {
+            raw.push_back({uint32_t(p.bias_token_ids[i]), 0, p.bias_values[i]});
+        }
+        std::sort(raw.begin(), raw.end(), [](const Adjustment &a, const Adjustment &b) { return a.idx < b.idx; });
+        for (const auto &a : raw) {
+            if (!adjustments.empty() && adjustments.back().idx == a.idx) {
+                adjustments.back().count += a.count;
+                adjustments.back().bias += a.bias;
+            } else {
+                adjustments.push_back(a);
+            }
+        }
+    }
+
+    template <class T>
+    T apply(T x, const Adjustment &a) const {
+        x += a.bias;
+        if (a.count > 0) {
+            x = x > 0 ? x / repetition_penalty : x * repetition_penalty;
+            x -= frequency_penalty * a.count + presence_penalty;
+        }
+        return x;
+    }
+
+    // 第一个下标不小于 begin 的修改项
+    const Adjustment *seek(size_t begin) const {
+        return std::lower_bound(
+            adjustments.data(), adjustments.data() + adjustments.size(), begin,
+            [](const Adjustment &a, size_t i) { return a.idx < i; });
+    }
+
+    const Adjustment *end() const {
+        return adjustments.data() + adjustments.size();
+    }
 };
 
-template <>
-struct ComputeType<bf16_t> {
-    using type = float;
+// 一行的采样参数
+struct SampleArgs {
+    float random_val, topp;
+    int topk;
+    float temperature;
 };
 
-struct Algo {
+// 各行的采样参数，stride 为 0 时所有行共用一组参数
+struct BatchArgs {
+    const float *random_val, *topp;
+    const int *topk;
+    const float *temperature;
+    ptrdiff_t stride;
+    // 为空表示不处理 logits，否则每行一个
+    const infiniopLogitsProcessor_t *processors;
 
-    template <class Tidx, class Tval>
-    static auto get(void const *ptr, size_t i) {
-        return utils::cast<typename ComputeType<Tval>::type, Tval>(reinterpret_cast<Tval const *>(ptr)[i]);
+    SampleArgs operator[](size_t row) const {
+        auto i = row * stride;
+        return {random_val[i], topp[i], topk[i], temperature[i]};
     }
+};
 
-    template <class Tidx, class Tval>
-    infiniStatus_t argmax(
-        void *workspace, size_t workspace_size,
-        void *result, void const *probs, size_t n,
-        void *stream) {
-        auto idx = reinterpret_cast<Tidx *>(result);
-        *idx = 0;
+// 词表中的一行 logits
+template <class Tval>
+struct Row {
+    using Tcompute = typename ComputeType<Tval>::type;
+    using Pair = Candidate<Tcompute>;
 
-        auto max_val = get<Tidx, Tval>(probs, 0);
-        for (size_t i = 0; i < n; i++) {
-            if (auto val = get<Tidx, Tval>(probs, i); val > max_val) {
-                max_val = val;
-                *idx = static_cast<Tidx>(i);
-            }
+    const Tval *probs;
+    size_t n;
+    // 为空表示不处理 logits
+    const Processors *processors;
+
+    // 把 [i, i + len) 转换成 Tcompute 写入 buf
+    void load(Tcompute *buf, size_t i, size_t len) const {
+        if constexpr (std::is_same<Tcompute, float>::value) {
+            op::common_cpu::loadFloat(buf, probs + i, len);
+        } else {
+            std::copy(probs + i, probs + i + len, buf);
         }
+    }
 
-        return INFINI_STATUS_SUCCESS;
+    // 块 [i, i + len) 中是否有需要修改的 logit
+    bool touches(const Adjustment *it, size_t i, size_t len) const {
+        return processors && it != processors->end() && it->idx < i + len;
     }
 
-    template <class Tidx, class Tval>
-    infiniStatus_t random(
-        void *workspace, size_t workspace_size,
-        void *result, void const *probs, size_t n,
-        float random_val, float topp, int topk, float temperature,
-        void *stream) {
+    // 修改块 [i, i + len) 中的 logits，it 随块推进
+    void adjust(Tcompute *buf, size_t i, size_t len, const Adjustment *&it) const {
+        for (; touches(it, i, len); ++it) {
+            buf[it->idx - i] = processors->apply(buf[it->idx - i], *it);
+        }
+    }
+
+    const Adjustment *seek(size_t begin) const {
+        return processors ? processors->seek(begin) : nullptr;
+    }
 
-        struct KVPair {
-            Tidx idx;
-            typename ComputeType<Tval>::type val;
+    float minP() const {
+        return processors ? processors->min_p : 0.f;
+    }
 
-            bool operator<(const KVPair &other) const {
-                return val > other.val;
+    // [begin, end) 中的最大值及其下标，相等时取下标小的。
+    // 分块转换后先求块内最大值，只有超过当前最大值的块才回头找下标
+    Pair argmax(size_t begin, size_t end) const {
+        Pair best{-std::numeric_limits<Tcompute>::infinity(), uint32_t(begin)};
+        Tcompute buf[BLOCK_SIZE];
+        auto it = seek(begin);
+        for (size_t i = begin; i < end; i += BLOCK_SIZE) {
+            const size_t len = std::min(BLOCK_SIZE, end - i);
+            // 单精度和双精度的块不需要修改时直接归约，不需要转换
+            const Tcompute *block = buf;
+            if constexpr (std::is_same<Tval, Tcompute>::value) {
+                if (touches(it, i, len)) {
+                    load(buf, i, len);
+                } else {
+                    block = probs + i;
+                }
+            } else {
+                load(buf, i, len);
             }
-        };
-
-        auto idx = reinterpret_cast<Tidx *>(result);
-        // build & sort
-        std::vector<KVPair> pairs(n);
-        for (size_t i = 0; i < n; i++) {
-            pairs[i] = {static_cast<Tidx>(i), get<Tidx, Tval>(probs, i)};
-        }
-        std::sort(pairs.begin(), pairs.end());
-        // softmax & sum
-        auto const max_val = pairs[0].val;
-        pairs[0].val = 1;
-        for (size_t i = 1; i < n; i++) {
-            pairs[i].val = pairs[i - 1].val + std::exp((pairs[i].val - max_val) / temperature);
-        }
-        // topk & topp & limit
-        auto const pk = pairs[std::min(static_cast<size_t>(topk), n) - 1].val,
-                   pp = pairs[n - 1].val * topp,
-                   plimit = random_val * std::min(pk, pp);
-        // sample
-        for (size_t i = 0; i < n; i++) {
-            if (plimit <= pairs[i].val) {
-                *idx = pairs[i].idx;
-                break;
+            adjust(buf, i, len, it);
+            if (auto val = blockMax(block, len); val > best.val) {
+                size_t j = 0;
+                while (block[j] != val) {
+                    j++;
+                }
+                best = {val, uint32_t(i + j)};
             }
         }
+        return best;
+    }
 
-        return INFINI_STATUS_SUCCESS;
+    // 扫描 [begin, end)：转换、处理并缩放，按需求 softmax 的最大值和分母，候选写入 out，返回候选数
+    size_t scan(
+        size_t begin, size_t end,
+        size_t k, Tcompute inv_temperature, bool need_sum,
+        Pair *out, op::common_cpu::reduce_op::SoftmaxStat &stat) const {
+
+        const bool use_heap = k * HEAP_RATIO <= end - begin;
+        size_t count = 0;
+        Tcompute buf[BLOCK_SIZE];
+        auto it = seek(begin);
+        for (size_t i = begin; i < end; i += BLOCK_SIZE) {
+            const size_t len = std::min(BLOCK_SIZE, end - i);
+            load(buf, i, len);
+            adjust(buf, i, len, it);
+            for (size_t j = 0; j < len; j++) {
+                buf[j] *= inv_temperature;
+            }
+            if (need_sum) {
+                if constexpr (std::is_same<Tcompute, float>::value) {
+                    stat.update(buf, len);
+                } else {
+                    float buf_f[BLOCK_SIZE];
+                    for (size_t j = 0; j < len; j++) {
+                        buf_f[j] = float(buf[j]);
+                    }
+                    stat.update(buf_f, len);
+                }
+            }
+
+            if (!use_heap) {
+                for (size_t j = 0; j < len; j++) {
+                    out[count++] = {buf[j], uint32_t(i + j)};
+                }
+                continue;
+            }
+            for (size_t j = 0; j < len; j++) {
+                if (count < k) {
+                    out[count++] = {buf[j], uint32_t(i + j)};
+                    std::push_heap(out, out + count, greater<Tcompute>);
+                } else if (buf[j] > out[0].val) {
+                    std::pop_heap(out, out + k, greater<Tcompute>);
+                    out[k - 1] = {buf[j], uint32_t(i + j)};
+                    std::push_heap(out, out + k, greater<Tcompute>);
+                }
+            }
+        }
+        return count;
     }
 };
 
+// 从 count 个候选中选出前 k 个从大到小排列，在其上按 topk 和 topp 采样。
+// 只在候选上求累积的未归一化概率，整个词表的分母来自扫描时的归约
+template <class Tcompute>
+uint32_t pick(
+    Candidate<Tcompute> *candidates, size_t count, size_t k,
+    const op::common_cpu::reduce_op::SoftmaxStat &stat, bool need_sum,
+    float random_val, float topp, float min_p) {
+
+    if (count > k) {
+        std::nth_element(candidates, candidates + k - 1, candidates + count, greater<Tcompute>);
+    }
+    std::sort(candidates, candidates + k, greater<Tcompute>);
+
+    const Tcompute max_val = candidates[0].val;
+    // min_p：概率不小于最大概率的 min_p 倍，即 logit 不小于 max + ln(min_p) 的候选才保留
+    size_t kp = k;
+    if (min_p > 0) {
+        const Tcompute threshold = max_val + std::log(Tcompute(min_p));
+        kp = std::partition_point(candidates + 1, candidates + k,
+                                  [=](const Candidate<Tcompute> &c) { return c.val >= threshold; })
+           - candidates;
+    }
+    Tcompute cum = 0;
+    for (size_t i = 0; i < k; i++) {
+        cum += std::exp(candidates[i].val - max_val);
+        candidates[i].val = cum;
+    }
+
+    // topk & topp & limit
+    Tcompute limit = candidates[kp - 1].val;
+    if (need_sum) {
+        limit = std::min(limit, stat.sum * std::exp(Tcompute(stat.max) - max_val) * topp);
+    }
+    auto const plimit = random_val * limit;
+    // sample
+    for (size_t i = 0; i < kp; i++) {
+        if (plimit <= candidates[i].val) {
+            return candidates[i].idx;
+        }
+    }
+    return candidates[kp - 1].idx;
+}
+
+// 采样只会落在前 topk 个候选中，因此只需选出这些候选并排序，不必排序整个词表。
+// 全词表只参与一次线性扫描：转换、求 softmax 的分母和筛选候选
+template <class Tval>
+uint32_t sampleRow(const Row<Tval> &row, SampleArgs args, typename Row<Tval>::Pair *candidates) {
+    using Tcompute = typename Row<Tval>::Tcompute;
+    if (isGreedy(args.random_val, args.topp, args.topk, args.temperature)) {
+        return row.argmax(0, row.n).idx;
+    }
+
+    const size_t k = args.topk > 0 ? std::min(size_t(args.topk), row.n) : row.n;
+    // topp 不小于 1 时只有 topk 起作用，不需要分母
+    const bool need_sum = args.topp < 1.f;
+    op::common_cpu::reduce_op::SoftmaxStat stat;
+    auto count = row.scan(0, row.n, k, Tcompute(1) / args.temperature, need_sum, candidates, stat);
+    return pick(candidates, count, k, stat, need_sum, args.random_val, args.topp, row.minP());
+}
+
+// 行内并行：每个线程扫描一段，各段的候选和归约结果合并后再采样
+template <class Tval>
+uint32_t sampleRowSplit(const Row<Tval> &row, SampleArgs args, typename Row<Tval>::Pair *candidates, size_t nthreads) {
+    using Tcompute = typename Row<Tval>::Tcompute;
+    using Pair = typename Row<Tval>::Pair;
+    const size_t n = row.n,
+                 chunk = (n + nthreads - 1) / nthreads,
+                 nchunks = (n + chunk - 1) / chunk;
+
+    if (isGreedy(args.random_val, args.topp, args.topk, args.temperature)) {
+        std::vector<Pair> best(nchunks);
+#pragma omp parallel for
+        for (ptrdiff_t t = 0; t < ptrdiff_t(nchunks); t++) {
+            best[t] = row.argmax(t * chunk, std::min((t + 1) * chunk, n));
+        }
+        // 各段按下标顺序合并，相等时保留靠前的
+        auto ans = best[0];
+        for (size_t t = 1; t < nchunks; t++) {
+            if (best[t].val > ans.val) {
+                ans = best[t];
+            }
+        }
+        return ans.idx;
+    }
+
+    const size_t k = args.topk > 0 ? std::min(size_t(args.topk), n) : n;
+    const bool need_sum = args.topp < 1.f;
+    const Tcompute inv_temperature = Tcompute(1) / args.temperature;
+    std::vector<size_t> counts(nchunks);
+    std::vector<op::common_cpu::reduce_op::SoftmaxStat> stats(nchunks);
+#pragma omp parallel for
+    for (ptrdiff_t t = 0; t < ptrdiff_t(nchunks); t++) {
+        size_t begin = t * chunk;
+        counts[t] = row.scan(begin, std::min(begin + chunk, n), k, inv_temperature, need_sum, candidates + begin, stats[t]);
+    }
+
+    // 各段的候选写在段首，依次搬到一起
+    size_t count = 0;
+    op::common_cpu::reduce_op::SoftmaxStat stat;
+    for (size_t t = 0; t < nchunks; t++) {
+        std::memmove(candidates + count, candidates + t * chunk, counts[t] * sizeof(Pair));
+        count += counts[t];
+        stat.merge(stats[t]);
+    }
+    return pick(candidates, count, k, stat, need_sum, args.random_val, args.topp, row.minP());
+}
+
+template <class Tidx, class Tval>
+infiniStatus_t sample(
+    const RandomSampleInfo &info,
+    void *workspace, size_t nslots,
+    void *result, const void *probs,
+    BatchArgs args) {
+
+    auto candidates = reinterpret_cast<typename Row<Tval>::Pair *>(workspace);
+    auto result_ = reinterpret_cast<Tidx *>(result);
+    auto row = [&](size_t i, std::optional<Processors> &processors) {
+        if (args.processors) {
+            processors.emplace(args.processors[i]);
+        }
+        return Row<Tval>{
+            reinterpret_cast<const Tval *>(probs) + i * info.probs_stride,
+            info.n,
+            processors ? &*processors : nullptr};
+    };
+
+    const size_t nthreads = op::common_cpu::maxThreads();
+    if (info.batch >= nthreads || info.n < MIN_SPLIT_LEN) {
+        // 按行并行，贪心和随机采样的行可以混在一起
+#pragma omp parallel num_threads(nslots)
+        {
+            auto candidates_ = candidates + op::common_cpu::threadId() * info.n;
+#pragma omp for
+            for (ptrdiff_t i = 0; i < ptrdiff_t(info.batch); i++) {
+                std::optional<Processors> processors;
+                result_[i * info.result_stride] = static_cast<Tidx>(sampleRow(row(i, processors), args[i], candidates_));
+            }
+        }
+    } else {
+        // 行少而长，每行切分给各线程
+        for (size_t i = 0; i < info.batch; i++) {
+            std::optional<Processors> processors;
+            result_[i * info.result_stride] = static_cast<Tidx>(sampleRowSplit(row(i, processors), args[i], candidates, nthreads));
+        }
+    }
+    return INFINI_STATUS_SUCCESS;
+}
+
+template <class Tidx>
+infiniStatus_t dispatchVal(
+    const RandomSampleInfo &info,
+    void *workspace, size_t nslots,
+    void *result, const void *probs,
+    BatchArgs args) {
+
+    switch (info.dt_p) {
+    case INFINI_DTYPE_F16:
+        return sample<Tidx, fp16_t>(info, workspace, nslots, result, probs, args);
+    case INFINI_DTYPE_BF16:
+        return sample<Tidx, bf16_t>(info, workspace, nslots, result, probs, args);
+    case INFINI_DTYPE_F32:
+        return sample<Tidx, float>(info, workspace, nslots, result, probs, args);
+    case INFINI_DTYPE_F64:
+        return sample<Tidx, double>(info, workspace, nslots, result, probs, args);
+    default:
+        return INFINI_STATUS_BAD_TENSOR_DTYPE;
+    }
+}
+
+infiniStatus_t calculateSample(
+    const RandomSampleInfo &info, size_t min_workspace_size,
+    void *workspace, size_t workspace_size,
+    void *result, const void *probs,
+    BatchArgs args) {
+
+    if (workspace_size < min_workspace_size) {
+        return INFINI_STATUS_INSUFFICIENT_WORKSPACE;
+    }
+    auto nslots = std::max(min_workspace_size / rowWorkspaceSize(info), size_t(1));
+
+#define CASE(DT_VAL, DT_TYP) \
+    case DT_VAL:             \
+        return dispatchVal<DT_TYP>(info, workspace, nslots, result, probs, args)
+
+    switch (info.dt_i) {
+        CASE(INFINI_DTYPE_I8, int8_t);
+        CASE(INFINI_DTYPE_I16, int16_t);
+        CASE(INFINI_DTYPE_I32, int32_t);
+        CASE(INFINI_DTYPE_I64, int64_t);
+        CASE(INFINI_DTYPE_U8, uint8_t);
+        CASE(INFINI_DTYPE_U16, uint16_t);
+        CASE(INFINI_DTYPE_U32, uint32_t);
+        CASE(INFINI_DTYPE_U64, uint64_t);
+    default:
+        return INFINI_STATUS_BAD_TENSOR_DTYPE;
+    }
+
+#undef CASE
+}
+
 infiniStatus_t Descriptor::calculate(
     void *workspace,
     size_t workspace_size,
@@ -127,13 +517,39 @@ infiniStatus_t Descriptor::calculate(
     float temperature,
     void *stream) const {
 
-    Calculate::calculate<Algo>(
-        Algo{}, _info, workspace, workspace_size,
+    // 所有行使用同一组参数
+    return calculateSample(
+        _info, _min_workspace_size,
+        workspace, workspace_size,
         result, probs,
-        random_val, topp, topk, temperature,
-        stream);
+        {&random_val, &topp, &topk, &temperature, 0, nullptr});
+}
 
-    return INFINI_STATUS_SUCCESS;
+infiniStatus_t Descriptor::calculateBatched(
+    void *workspace,
+    size_t workspace_size,
+    void *result,
+    const void *probs,
+    const float *random_val,
+    const float *topp,
+    const int *topk,
+    const float *temperature,
+    const infiniopLogitsProcessor_t *processors,
+    void *stream) const {
+
+    if (!random_val || !topp || !topk || !temperature) {
+        return INFINI_STATUS_NULL_POINTER;
+    }
+    if (processors) {
+        for (size_t i = 0; i < _info.batch; i++) {
+            CHECK_STATUS(Processors::check(processors[i], _info.n));
+        }
+    }
+    return calculateSample(
+        _info, _min_workspace_size,
+        workspace, workspace_size,
+        result, probs,
+        {random_val, topp, topk, temperature, 1, processors});
 }
 
 } // namespace op::random_sample::cpu
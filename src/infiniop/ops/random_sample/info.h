@@ -9,6 +9,9 @@ namespace op::random_sample {
 struct RandomSampleInfo {
     infiniDtype_t dt_i, dt_p;
     size_t n;
+    // 批量采样时 probs 为 [batch, n]，result 为 [batch]；单次采样时 batch 为 1
+    size_t batch;
+    ptrdiff_t result_stride, probs_stride;
 
     static utils::Result<RandomSampleInfo> create(
         infiniopTensorDescriptor_t result_desc,
@@ -19,11 +22,20 @@ struct RandomSampleInfo {
 
         CHECK_DTYPE_ANY_INT(dt_i);
         CHECK_DTYPE(dt_p, INFINI_DTYPE_F16, INFINI_DTYPE_BF16, INFINI_DTYPE_F32, INFINI_DTYPE_F64);
-        CHECK_OR_RETURN(result_desc->ndim() == 0, INFINI_STATUS_BAD_TENSOR_SHAPE);
-        CHECK_OR_RETURN(probs_desc->ndim() == 1, INFINI_STATUS_BAD_TENSOR_SHAPE);
-        CHECK_OR_RETURN(probs_desc->stride(0) == 1, INFINI_STATUS_BAD_TENSOR_STRIDES);
-
-        return utils::Result<RandomSampleInfo>({dt_i, dt_p, probs_desc->dim(0)});
+        CHECK_OR_RETURN(result_desc->ndim() + 1 == probs_desc->ndim(), INFINI_STATUS_BAD_TENSOR_SHAPE);
+        CHECK_OR_RETURN(probs_desc->ndim() == 1 || probs_desc->ndim() == 2, INFINI_STATUS_BAD_TENSOR_SHAPE);
+        CHECK_OR_RETURN(probs_desc->stride(probs_desc->ndim() - 1) == 1, INFINI_STATUS_BAD_TENSOR_STRIDES);
+
+        if (probs_desc->ndim() == 1) {
+            return utils::Result<RandomSampleInfo>({dt_i, dt_p, probs_desc->dim(0), 1, 0, 0});
+        }
+
+        CHECK_OR_RETURN(result_desc->dim(0) == probs_desc->dim(0), INFINI_STATUS_BAD_TENSOR_SHAPE);
+        return utils::Result<RandomSampleInfo>({dt_i, dt_p,
+                                                probs_desc->dim(1),
+                                                probs_desc->dim(0),
+                                                result_desc->stride(0),
+                                                probs_desc->stride(0)});
     }
 };
 
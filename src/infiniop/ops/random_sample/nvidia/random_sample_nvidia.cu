@@ -22,6 +22,8 @@ infiniStatus_t Descriptor::create(
 
     auto result = RandomSampleInfo::create(result_desc, probs_desc);
     CHECK_RESULT(result);
+    // 暂不支持批量采样
+    CHECK_OR_RETURN(result->batch == 1, INFINI_STATUS_NOT_IMPLEMENTED);
 
     auto info = result.take();
     size_t workspace_size;
@@ -99,4 +101,18 @@ infiniStatus_t Descriptor::calculate(
     return INFINI_STATUS_SUCCESS;
 }
 
+infiniStatus_t Descriptor::calculateBatched(
+    void *workspace,
+    size_t workspace_size,
+    void *result,
+    const void *probs,
+    const float *random_val,
+    const float *topp,
+    const int *topk,
+    const float *temperature,
+    const infiniopLogitsProcessor_t *processors,
+    void *stream) const {
+    return INFINI_STATUS_NOT_IMPLEMENTED;
+}
+
 } // namespace op::random_sample::nvidia
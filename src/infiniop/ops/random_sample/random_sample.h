@@ -2,6 +2,7 @@
 #define __RANDOM_SAMPLE_H__
 
 #include "../../operator.h"
+#include "infiniop/ops/random_sample.h"
 #include "info.h"
 
 #define DESCRIPTOR(NAMESPACE)                             \
@@ -45,12 +46,29 @@
             float topp,                                   \
             int topk,                                     \
             float temperature,                            \
+            void *stream) const;                          \
+                                                          \
+        infiniStatus_t calculateBatched(                  \
+            void *workspace,                              \
+            size_t workspace_size,                        \
+            void *result,                                 \
+            const void *probs,                            \
+            const float *random_val,                      \
+            const float *topp,                            \
+            const int *topk,                              \
+            const float *temperature,                     \
+            const infiniopLogitsProcessor_t *processors,  \
             void *stream) const;                          \
     };                                                    \
     }
 
 namespace op::random_sample {
 
+// 这些参数退化为取最大值
+inline bool isGreedy(float random_val, float topp, int topk, float temperature) {
+    return random_val == 0 || topp == 0 || topk == 1 || temperature == 0;
+}
+
 struct CalculateArgs {
     void *workspace;
     size_t workspace_size;
@@ -64,14 +82,14 @@ struct CalculateArgs {
 class Calculate {
 
     template <class Tidx, class Tval, class Algo>
-    static void switch_f(Algo algo, size_t n, CalculateArgs args) {
-        if (args.random_val == 0 || args.topp == 0 || args.topk == 1 || args.temperature == 0) {
-            algo.template argmax<Tidx, Tval>(
+    static infiniStatus_t switch_f(Algo algo, size_t n, CalculateArgs args) {
+        if (isGreedy(args.random_val, args.topp, args.topk, args.temperature)) {
+            return algo.template argmax<Tidx, Tval>(
                 args.workspace, args.workspace_size,
                 args.result, args.probs, n,
                 args.stream);
         } else {
-            algo.template random<Tidx, Tval>(
+            return algo.template random<Tidx, Tval>(
                 args.workspace, args.workspace_size,
                 args.result, args.probs, n,
                 args.random_val, args.topp, args.topk, args.temperature,
@@ -80,22 +98,18 @@ class Calculate {
     }
 
     template <class Tidx, class Algo>
-    static void switch_val(
+    static infiniStatus_t switch_val(
         Algo algo,
         infiniDtype_t dt_p, size_t n, CalculateArgs args) {
         switch (dt_p) {
         case INFINI_DTYPE_F16:
-            switch_f<Tidx, fp16_t>(algo, n, args);
-            break;
+            return switch_f<Tidx, fp16_t>(algo, n, args);
         case INFINI_DTYPE_BF16:
-            switch_f<Tidx, bf16_t>(algo, n, args);
-            break;
+            return switch_f<Tidx, bf16_t>(algo, n, args);
         case INFINI_DTYPE_F32:
-            switch_f<Tidx, float>(algo, n, args);
-            break;
+            return switch_f<Tidx, float>(algo, n, args);
         case INFINI_DTYPE_F64:
-            switch_f<Tidx, double>(algo, n, args);
-            break;
+            return switch_f<Tidx, double>(algo, n, args);
         default:
             // unreachable
             std::abort();
@@ -114,13 +128,12 @@ public:
 
 #define CASE(DT_VAL, DT_TYP)                      \
     case DT_VAL:                                  \
-        switch_val<DT_TYP>(                       \
+        return switch_val<DT_TYP>(                \
             algo, info.dt_p, info.n,              \
             {workspace, workspace_size,           \
              result, probs,                       \
              random_val, topp, temperature, topk, \
-             stream});                            \
-        break
+             stream})
 
         switch (info.dt_i) {
             CASE(INFINI_DTYPE_I8, int8_t);
@@ -137,8 +150,6 @@ public:
         }
 
 #undef CASE
-
-        return INFINI_STATUS_SUCCESS;
     }
 };
 
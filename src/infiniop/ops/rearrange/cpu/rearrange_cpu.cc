@@ -5,7 +5,14 @@
 
 namespace op::rearrange::cpu {
 
-Descriptor::~Descriptor() = default;
+// 输入输出类型不同时在搬运中转换类型，此时 _meta 以元素而不是字节为单位
+struct Descriptor::Opaque {
+    infiniDtype_t y_dtype, x_dtype;
+};
+
+Descriptor::~Descriptor() {
+    delete _opaque;
+}
 
 infiniStatus_t Descriptor::create(
     infiniopHandle_t handle_,
@@ -18,30 +25,112 @@ infiniStatus_t Descriptor::create(
 
     auto y_shape = y_desc->shape();
     auto x_shape = x_desc->shape();
-    CHECK_OR_RETURN(x_desc->dtype() == dtype, INFINI_STATUS_BAD_TENSOR_DTYPE);
     CHECK_OR_RETURN(x_desc->ndim() == ndim, INFINI_STATUS_BAD_TENSOR_SHAPE);
     CHECK_SAME_SHAPE(x_shape, y_shape);
 
     auto dst_strides = y_desc->strides();
     auto src_strides = x_desc->strides();
-    auto element_size = infiniSizeOf(dtype);
+
+    bool cast = x_desc->dtype() != dtype;
+    if (cast) {
+        CHECK_DTYPE(dtype, INFINI_DTYPE_F16, INFINI_DTYPE_BF16, INFINI_DTYPE_F32);
+        CHECK_DTYPE(x_desc->dtype(), INFINI_DTYPE_F16, INFINI_DTYPE_BF16, INFINI_DTYPE_F32);
+    }
+    auto element_size = cast ? 1 : infiniSizeOf(dtype);
 
     auto result = utils::RearrangeMeta::create(y_shape.data(), dst_strides.data(), src_strides.data(), ndim, element_size);
     CHECK_RESULT(result);
 
     *desc_ptr = new Descriptor(
         result.take(),
-        nullptr,
+        cast ? new Opaque{dtype, x_desc->dtype()} : nullptr,
         handle->device,
         handle->device_id);
     return INFINI_STATUS_SUCCESS;
 }
 
+// 每次经 float 中转的元素数，中间结果留在 L1 中
+constexpr size_t BLOCK_SIZE = 256;
+// 每个线程至少转换的元素数
+constexpr size_t MIN_ELEMENTS_PER_THREAD = 16384;
+
+template <typename Ty, typename Tx>
+void convert(Ty *y, const Tx *x, size_t len) {
+    float buf[BLOCK_SIZE];
+    for (size_t i = 0; i < len; i += BLOCK_SIZE) {
+        auto n = std::min(BLOCK_SIZE, len - i);
+        op::common_cpu::loadFloat(buf, x + i, n);
+        op::common_cpu::storeFloat(y + i, buf, n);
+    }
+}
+
+// 复用 RearrangeMeta 排序合并后的维度，按元素切分给各线程，每段连续数据整段转换
+template <typename Ty, typename Tx>
+void rearrangeCast(const utils::RearrangeMeta &meta, Ty *y, const Tx *x) {
+    const size_t total = meta.count() * meta.unit(),
+                 nthreads = std::min(op::common_cpu::maxThreads(),
+                                     (total + MIN_ELEMENTS_PER_THREAD - 1) / MIN_ELEMENTS_PER_THREAD);
+    auto range = [&](size_t begin, size_t end) {
+        meta.forEachRange(begin, end, [=](ptrdiff_t y_offset, ptrdiff_t x_offset, size_t len) {
+            convert(y + y_offset, x + x_offset, len);
+        });
+    };
+    if (nthreads <= 1) {
+        range(0, total);
+        return;
+    }
+#pragma omp parallel for num_threads(nthreads)
+    for (ptrdiff_t t = 0; t < ptrdiff_t(nthreads); ++t) {
+        range(t * total / nthreads, (t + 1) * total / nthreads);
+    }
+}
+
+template <typename Ty>
+infiniStatus_t dispatchCast(const utils::RearrangeMeta &meta, infiniDtype_t x_dtype, void *y, const void *x) {
+    switch (x_dtype) {
+    case INFINI_DTYPE_F16:
+        rearrangeCast(meta, (Ty *)y, (const fp16_t *)x);
+        return INFINI_STATUS_SUCCESS;
+    case INFINI_DTYPE_BF16:
+        rearrangeCast(meta, (Ty *)y, (const bf16_t *)x);
+        return INFINI_STATUS_SUCCESS;
+    case INFINI_DTYPE_F32:
+        rearrangeCast(meta, (Ty *)y, (const float *)x);
+        return INFINI_STATUS_SUCCESS;
+    default:
+        return INFINI_STATUS_BAD_TENSOR_DTYPE;
+    }
+}
+
 infiniStatus_t Descriptor::calculate(
     void *y,
     const void *x,
     void *stream) const {
-    _meta.launch(y, x);
+
+    if (_opaque) {
+        switch (_opaque->y_dtype) {
+        case INFINI_DTYPE_F16:
+            return dispatchCast<fp16_t>(_meta, _opaque->x_dtype, y, x);
+        case INFINI_DTYPE_BF16:
+            return dispatchCast<bf16_t>(_meta, _opaque->x_dtype, y, x);
+        case INFINI_DTYPE_F32:
+            return dispatchCast<float>(_meta, _opaque->x_dtype, y, x);
+        default:
+            return INFINI_STATUS_BAD_TENSOR_DTYPE;
+        }
+    }
+
+    switch (_hint) {
+    case INFINIOP_REARRANGE_HINT_STREAMING:
+        _meta.launch(y, x, true);
+        break;
+    case INFINIOP_REARRANGE_HINT_CACHED:
+        _meta.launch(y, x, false);
+        break;
+    default:
+        _meta.launch(y, x);
+        break;
+    }
     return INFINI_STATUS_SUCCESS;
 }
 
@@ -54,6 +54,50 @@ __C infiniStatus_t infiniopCreateRearrangeDescriptor(
 #undef CREATE
 }
 
+__C infiniStatus_t infiniopSetRearrangeHint(
+    infiniopRearrangeDescriptor_t desc,
+    infiniopRearrangeHint_t hint) {
+
+    switch (hint) {
+    case INFINIOP_REARRANGE_HINT_DEFAULT:
+    case INFINIOP_REARRANGE_HINT_STREAMING:
+    case INFINIOP_REARRANGE_HINT_CACHED:
+        break;
+    default:
+        return INFINI_STATUS_BAD_PARAM;
+    }
+
+#define SET_HINT(CASE, NAMESPACE)                                                      \
+    case CASE:                                                                         \
+        reinterpret_cast<op::rearrange::NAMESPACE::Descriptor *>(desc)->setHint(hint); \
+        return INFINI_STATUS_SUCCESS
+
+    switch (desc->device_type) {
+
+#ifdef ENABLE_CPU_API
+        SET_HINT(INFINI_DEVICE_CPU, cpu);
+#endif
+#ifdef ENABLE_ASCEND_API
+        SET_HINT(INFINI_DEVICE_ASCEND, ascend);
+#endif
+
+#ifdef ENABLE_NVIDIA_API
+        SET_HINT(INFINI_DEVICE_NVIDIA, nvidia);
+#endif
+#ifdef ENABLE_ILUVATAR_API
+        SET_HINT(INFINI_DEVICE_ILUVATAR, nvidia);
+#endif
+#ifdef ENABLE_METAX_API
+        SET_HINT(INFINI_DEVICE_METAX, metax);
+#endif
+
+    default:
+        return INFINI_STATUS_DEVICE_TYPE_NOT_SUPPORTED;
+    }
+
+#undef SET_HINT
+}
+
 __C infiniStatus_t infiniopRearrange(
     infiniopRearrangeDescriptor_t desc,
     void *dst,
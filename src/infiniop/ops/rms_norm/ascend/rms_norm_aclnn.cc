@@ -38,6 +38,11 @@ infiniStatus_t Descriptor::create(
     CHECK_RESULT(result);
     auto info = result.take();
 
+    // only support contiguous last dimension and leading dimensions that merge into one
+    if (info.ndim() != 2 || info.x_strides[1] != 1 || info.y_strides[1] != 1) {
+        return INFINI_STATUS_BAD_TENSOR_STRIDES;
+    }
+
     size_t workspace_size = 0;
     aclOpExecutor *executor = nullptr;
     aclnnTensorDescriptor_t y = nullptr;
@@ -1,6 +1,5 @@
 #include "rms_norm_cpu.h"
 #include "../../../devices/cpu/common_cpu.h"
-#include "../../../reduce/cpu/reduce.h"
 
 namespace op::rms_norm::cpu {
 
@@ -19,56 +18,116 @@ infiniStatus_t Descriptor::create(
     return INFINI_STATUS_SUCCESS;
 }
 
-template <typename T>
-infiniStatus_t rmsnorm(const RMSNormInfo *info, T *y, const T *x, const T *w) {
-#pragma omp parallel for
-    for (ptrdiff_t i = 0; i < ptrdiff_t(info->shape[0]); i++) {
-        T *x_ = (T *)(x + i * info->x_strides[0]);
-        T *y_ = (T *)(y + i * info->y_strides[0]);
-
-        // [Reduce] sum of x^2 on last dimension
-        T ss = op::common_cpu::reduce_op::sumSquared(x_, info->shape[1], info->x_strides[1]);
-
-        // 1 / (sqrt(sum/dim + eps))
-        T rms = (T)1 / std::sqrt(ss / (T)(info->shape[1]) + (T)(info->epsilon));
-
-        for (size_t j = 0; j < info->shape[1]; j++) {
-            y_[j * info->y_strides[1]] = x_[j * info->x_strides[1]] * w[j] * rms;
+// 每次转换成计算类型参与运算的元素数，保证中间结果留在 L1 中
+constexpr size_t BLOCK_SIZE = 256;
+// 平方和使用的独立累加器个数，使归约可以向量化
+constexpr size_t LANES = 8;
+// 行数不足以占满线程时，长于此值的行在行内切分给各线程
+constexpr size_t MIN_SPLIT_LEN = 16384;
+
+// 一行数据；CONTIGUOUS 时最后一维步长为 1，内层循环可以向量化
+template <typename T, typename Tw, typename Tcompute, bool CONTIGUOUS>
+struct RMSNormRow {
+    const RMSNormInfo &info;
+    T *y;
+    const T *x;
+    const Tw *w;
+
+    // [Reduce] sum of x^2 in [begin, end)
+    Tcompute sumSquared(size_t begin, size_t end) const {
+        const ptrdiff_t x_stride = CONTIGUOUS ? 1 : info.x_strides.back();
+        Tcompute buf[BLOCK_SIZE], acc[LANES] = {};
+        for (size_t j = begin; j < end; j += BLOCK_SIZE) {
+            size_t len = std::min(BLOCK_SIZE, end - j);
+            for (size_t k = 0; k < len; k++) {
+                buf[k] = op::common_cpu::loadCompute<Tcompute>(x[(j + k) * x_stride]);
+            }
+            size_t k = 0;
+            for (; k + LANES <= len; k += LANES) {
+                for (size_t l = 0; l < LANES; l++) {
+                    acc[l] += buf[k + l] * buf[k + l];
+                }
+            }
+            for (; k < len; k++) {
+                acc[0] += buf[k] * buf[k];
+            }
+        }
+        Tcompute ss = 0;
+        for (size_t l = 0; l < LANES; l++) {
+            ss += acc[l];
         }
+        return ss;
     }
 
-    return INFINI_STATUS_SUCCESS;
-}
-
-template <typename T, typename Tw>
-infiniStatus_t rmsnormHalfPrecision(const RMSNormInfo *info, T *y, const T *x, const Tw *w) {
-    static_assert(std::is_same<T, fp16_t>::value || std::is_same<T, bf16_t>::value,
-                  "T must be fp16_t or bf16_t");
-
+    // y = x * w * rms in [begin, end)，类型转换与乘法在同一个循环中完成
+    void scale(size_t begin, size_t end, Tcompute rms) const {
+        const ptrdiff_t x_stride = CONTIGUOUS ? 1 : info.x_strides.back(),
+                        y_stride = CONTIGUOUS ? 1 : info.y_strides.back();
+        for (size_t j = begin; j < end; j++) {
+            op::common_cpu::storeCompute(y[j * y_stride], op::common_cpu::loadCompute<Tcompute>(x[j * x_stride]) * op::common_cpu::loadCompute<Tcompute>(w[j]) * rms);
+        }
+    }
+};
+
+template <typename T, typename Tw, typename Tcompute, bool CONTIGUOUS>
+void rmsnorm(const RMSNormInfo &info, T *y, const T *x, const Tw *w) {
+    const size_t dim = info.dim(),
+                 batch = info.batch(),
+                 nrow_dim = info.ndim() - 1;
+    auto row = [&](size_t i) {
+        ptrdiff_t y_offset, x_offset;
+        if (nrow_dim == 1) {
+            y_offset = i * info.y_strides[0];
+            x_offset = i * info.x_strides[0];
+        } else {
+            y_offset = op::common_cpu::indexToOffset(i, nrow_dim, info.shape.data(), info.y_strides.data());
+            x_offset = op::common_cpu::indexToOffset(i, nrow_dim, info.shape.data(), info.x_strides.data());
+        }
+        return RMSNormRow<T, Tw, Tcompute, CONTIGUOUS>{info, y + y_offset, x + x_offset, w};
+    };
+    // 1 / (sqrt(sum/dim + eps))
+    auto rms = [&](Tcompute ss) {
+        return Tcompute(1) / std::sqrt(ss / Tcompute(dim) + Tcompute(info.epsilon));
+    };
+
+    const size_t nthreads = op::common_cpu::maxThreads();
+    if (batch >= nthreads || dim < MIN_SPLIT_LEN) {
+        // 按行并行
 #pragma omp parallel for
-    for (ptrdiff_t i = 0; i < ptrdiff_t(info->shape[0]); i++) {
-        T *x_ = (T *)(x + i * info->x_strides[0]);
-        T *y_ = (T *)(y + i * info->y_strides[0]);
-
-        // [Reduce] sum of x^2 on last dimension
-        float ss = op::common_cpu::reduce_op::sumSquared(x_, info->shape[1], info->x_strides[1]);
-
-        // 1 / (sqrt(sum/dim + eps))
-        float rms = 1.f / std::sqrt(ss / (float)(info->shape[1]) + info->epsilon);
-
-        for (size_t j = 0; j < info->shape[1]; j++) {
-            if constexpr (std::is_same<Tw, float>::value) {
-                float val = utils::cast<float>(x_[j * info->x_strides[1]]) * w[j] * rms;
-                y_[j * info->y_strides[1]] = utils::cast<T>(val);
-            } else if constexpr (std::is_same<Tw, T>::value) {
-                float val = utils::cast<float>(x_[j * info->x_strides[1]]) * utils::cast<float>(w[j]) * rms;
-                y_[j * info->y_strides[1]] = utils::cast<T>(val);
-            } else {
-                std::abort();
+        for (ptrdiff_t i = 0; i < ptrdiff_t(batch); i++) {
+            auto row_ = row(i);
+            row_.scale(0, dim, rms(row_.sumSquared(0, dim)));
+        }
+    } else {
+        // 行少而宽（如解码阶段），每行切分给各线程，部分和相加后再缩放
+        const size_t chunk = (dim + nthreads - 1) / nthreads;
+        std::vector<Tcompute> partial(nthreads);
+        for (size_t i = 0; i < batch; i++) {
+            auto row_ = row(i);
+#pragma omp parallel for
+            for (ptrdiff_t t = 0; t < ptrdiff_t(nthreads); t++) {
+                partial[t] = row_.sumSquared(std::min(t * chunk, dim), std::min((t + 1) * chunk, dim));
+            }
+            Tcompute ss = 0;
+            for (auto p : partial) {
+                ss += p;
+            }
+            auto rms_ = rms(ss);
+#pragma omp parallel for
+            for (ptrdiff_t t = 0; t < ptrdiff_t(nthreads); t++) {
+                row_.scale(std::min(t * chunk, dim), std::min((t + 1) * chunk, dim), rms_);
             }
         }
     }
+}
 
+template <typename T, typename Tw, typename Tcompute>
+infiniStatus_t dispatchStride(const RMSNormInfo &info, void *y, const void *x, const void *w) {
+    if (info.y_strides.back() == 1 && info.x_strides.back() == 1) {
+        rmsnorm<T, Tw, Tcompute, true>(info, (T *)y, (const T *)x, (const Tw *)w);
+    } else {
+        rmsnorm<T, Tw, Tcompute, false>(info, (T *)y, (const T *)x, (const Tw *)w);
+    }
     return INFINI_STATUS_SUCCESS;
 }
 
@@ -78,28 +137,26 @@ infiniStatus_t Descriptor::calculate(
     void *stream) const {
     if (_info.atype == INFINI_DTYPE_F16) {
         if (_info.wtype == INFINI_DTYPE_F16) {
-            CHECK_STATUS(rmsnormHalfPrecision(&_info, (fp16_t *)y, (const fp16_t *)x, (const fp16_t *)w));
+            return dispatchStride<fp16_t, fp16_t, float>(_info, y, x, w);
         } else if (_info.wtype == INFINI_DTYPE_F32) {
-            CHECK_STATUS(rmsnormHalfPrecision(&_info, (fp16_t *)y, (const fp16_t *)x, (const float *)w));
+            return dispatchStride<fp16_t, float, float>(_info, y, x, w);
         } else {
             return INFINI_STATUS_BAD_TENSOR_DTYPE;
         }
     } else if (_info.atype == INFINI_DTYPE_BF16) {
         if (_info.wtype == INFINI_DTYPE_BF16) {
-            CHECK_STATUS(rmsnormHalfPrecision(&_info, (bf16_t *)y, (const bf16_t *)x, (const bf16_t *)w));
+            return dispatchStride<bf16_t, bf16_t, float>(_info, y, x, w);
         } else if (_info.wtype == INFINI_DTYPE_F32) {
-            CHECK_STATUS(rmsnormHalfPrecision(&_info, (bf16_t *)y, (const bf16_t *)x, (const float *)w));
+            return dispatchStride<bf16_t, float, float>(_info, y, x, w);
         } else {
             return INFINI_STATUS_BAD_TENSOR_DTYPE;
         }
     } else if (_info.atype == INFINI_DTYPE_F32) {
-        CHECK_STATUS(rmsnorm(&_info, (float *)y, (float *)x, (float *)w));
+        return dispatchStride<float, float, float>(_info, y, x, w);
     } else if (_info.atype == INFINI_DTYPE_F64) {
-        CHECK_STATUS(rmsnorm(&_info, (double *)y, (double *)x, (double *)w));
+        return dispatchStride<double, double, double>(_info, y, x, w);
     } else {
         return INFINI_STATUS_BAD_TENSOR_DTYPE;
     }
-
-    return INFINI_STATUS_SUCCESS;
 }
 } // namespace op::rms_norm::cpu
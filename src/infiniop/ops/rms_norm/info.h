@@ -7,6 +7,65 @@
 
 namespace op::rms_norm {
 
+// 检查激活和权重的类型组合：半精度激活可以搭配同类型或 F32 的权重，F32/F64 要求类型相同
+inline bool isSupportedDtype(infiniDtype_t atype, infiniDtype_t wtype) {
+    if (atype == INFINI_DTYPE_F16 || atype == INFINI_DTYPE_BF16) {
+        return wtype == atype || wtype == INFINI_DTYPE_F32;
+    }
+    if (atype == INFINI_DTYPE_F32 || atype == INFINI_DTYPE_F64) {
+        return wtype == atype;
+    }
+    return false;
+}
+
+// 按行归一化的 CPU 实现中每个线程缓存一行中间结果的工作空间，F64 用 double 计算，其余用 float
+inline size_t rowWorkspaceSize(size_t dim, infiniDtype_t atype) {
+    return dim * (atype == INFINI_DTYPE_F64 ? sizeof(double) : sizeof(float));
+}
+
+// 除最后一维外的维度都视为行，在所有张量上都能合并的相邻维度合并，连续的张量最终合并为二维。
+// descs 的形状相同且至少一维；返回合并后的形状，strides[k] 为 descs[k] 合并后的步长
+inline std::vector<size_t> mergeRowDims(
+    const std::vector<infiniopTensorDescriptor_t> &descs,
+    std::vector<std::vector<ptrdiff_t>> &strides) {
+
+    auto ndim = descs[0]->ndim();
+    std::vector<size_t> shape;
+    strides.assign(descs.size(), {});
+    for (size_t i = 0; i + 1 < ndim; ++i) {
+        auto d = descs[0]->dim(i);
+        if (d == 1) {
+            continue;
+        }
+        bool mergeable = !shape.empty();
+        for (size_t k = 0; k < descs.size() && mergeable; ++k) {
+            mergeable = strides[k].back() == descs[k]->stride(i) * ptrdiff_t(d);
+        }
+        if (mergeable) {
+            shape.back() *= d;
+            for (size_t k = 0; k < descs.size(); ++k) {
+                strides[k].back() = descs[k]->stride(i);
+            }
+        } else {
+            shape.push_back(d);
+            for (size_t k = 0; k < descs.size(); ++k) {
+                strides[k].push_back(descs[k]->stride(i));
+            }
+        }
+    }
+    if (shape.empty()) {
+        shape.push_back(1);
+        for (auto &s : strides) {
+            s.push_back(0);
+        }
+    }
+    shape.push_back(descs[0]->dim(ndim - 1));
+    for (size_t k = 0; k < descs.size(); ++k) {
+        strides[k].push_back(descs[k]->stride(ndim - 1));
+    }
+    return shape;
+}
+
 class RMSNormInfo {
     RMSNormInfo() = default;
 
@@ -14,12 +73,21 @@ public:
     infiniDtype_t wtype;
     infiniDtype_t atype;
     float epsilon;
+    // 合并后的形状和步长，至少二维；前面的维度不能合并成一维时多于二维
     std::vector<size_t> shape;
     std::vector<ptrdiff_t> y_strides;
     std::vector<ptrdiff_t> x_strides;
 
     size_t ndim() const { return shape.size(); }
     size_t dim() const { return shape[ndim() - 1]; }
+    // 行数，即除最后一维外所有维度的乘积
+    size_t batch() const {
+        size_t n = 1;
+        for (size_t i = 0; i + 1 < ndim(); ++i) {
+            n *= shape[i];
+        }
+        return n;
+    }
 
     static utils::Result<RMSNormInfo> create(
         infiniopTensorDescriptor_t y_desc,
@@ -32,27 +100,18 @@ public:
         if (x_desc->dtype() != atype) {
             return INFINI_STATUS_BAD_TENSOR_DTYPE;
         }
-        if (atype == INFINI_DTYPE_F16 || atype == INFINI_DTYPE_BF16) {
-            // For half-precision types (FP16/BF16), weights can be the same half-precision type or FP32
-            if (wtype != atype && wtype != INFINI_DTYPE_F32) {
-                return INFINI_STATUS_BAD_TENSOR_DTYPE;
-            }
-        } else if (atype == INFINI_DTYPE_F32 || atype == INFINI_DTYPE_F64) {
-            // For FP32/FP64, activations and weights must be of the same type
-            if (atype != wtype) {
-                return INFINI_STATUS_BAD_TENSOR_DTYPE;
-            }
-        } else {
+        if (!isSupportedDtype(atype, wtype)) {
             return INFINI_STATUS_BAD_TENSOR_DTYPE;
         }
 
-        if (y_desc->ndim() != 2 || x_desc->ndim() != 2 || w_desc->ndim() != 1) {
+        CHECK_SAME_SHAPE(y_desc->shape(), x_desc->shape());
+        auto ndim = x_desc->ndim();
+        if (ndim == 0 || w_desc->ndim() != 1) {
             return INFINI_STATUS_BAD_TENSOR_SHAPE;
         }
 
-        size_t batch = y_desc->shape()[0];
-        size_t dim = y_desc->shape()[1];
-        if (x_desc->shape()[0] != batch || x_desc->shape()[1] != dim || w_desc->shape()[0] != dim) {
+        size_t dim = x_desc->dim(ndim - 1);
+        if (w_desc->shape()[0] != dim) {
             return INFINI_STATUS_BAD_TENSOR_SHAPE;
         }
 
@@ -60,17 +119,16 @@ public:
             return INFINI_STATUS_BAD_TENSOR_STRIDES;
         }
 
-        if (x_desc->stride(1) != 1 || y_desc->stride(1) != 1) {
-            return INFINI_STATUS_BAD_TENSOR_STRIDES;
-        }
+        std::vector<std::vector<ptrdiff_t>> strides;
+        auto shape = mergeRowDims({y_desc, x_desc}, strides);
 
         return utils::Result<RMSNormInfo>(RMSNormInfo{
             wtype,
             atype,
             epsilon,
-            y_desc->shape(),
-            y_desc->strides(),
-            x_desc->strides(),
+            std::move(shape),
+            std::move(strides[0]),
+            std::move(strides[1]),
         });
     }
 };
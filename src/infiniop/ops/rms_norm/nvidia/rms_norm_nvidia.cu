@@ -41,8 +41,8 @@ infiniStatus_t Descriptor::create(
     CHECK_RESULT(result);
     auto info = result.take();
 
-    // only support contiguous last dimension
-    if (info.x_strides[1] != 1 || info.y_strides[1] != 1) {
+    // only support contiguous last dimension and leading dimensions that merge into one
+    if (info.ndim() != 2 || info.x_strides[1] != 1 || info.y_strides[1] != 1) {
         return INFINI_STATUS_BAD_TENSOR_STRIDES;
     }
 
@@ -0,0 +1,128 @@
+#include "rms_norm_quant_cpu.h"
+#include "../../../devices/cpu/common_cpu.h"
+#include "../../../reduce/cpu/reduce.h"
+
+namespace op::rms_norm_quant::cpu {
+
+Descriptor::~Descriptor() {}
+
+infiniStatus_t Descriptor::create(
+    infiniopHandle_t handle,
+    Descriptor **desc_ptr,
+    infiniopTensorDescriptor_t y_desc,
+    infiniopTensorDescriptor_t scale_desc,
+    infiniopTensorDescriptor_t x_desc,
+    infiniopTensorDescriptor_t w_desc,
+    float epsilon) {
+    auto result = RMSNormQuantInfo::create(y_desc, scale_desc, x_desc, w_desc, epsilon);
+    CHECK_RESULT(result);
+    auto info = result.take();
+    // 每个线程缓存一行归一化的结果，求出行最大值后直接从缓存量化
+    auto workspace_size = op::common_cpu::maxThreads() * op::rms_norm::rowWorkspaceSize(info.dim(), info.norm.atype);
+    *desc_ptr = new Descriptor(nullptr, std::move(info), workspace_size, handle->device, handle->device_id);
+    return INFINI_STATUS_SUCCESS;
+}
+
+template <typename Tq, typename T, typename Tw, typename Tcompute>
+void rmsNormQuant(
+    const RMSNormQuantInfo &info,
+    Tcompute *workspace, size_t nthreads,
+    Tq *y, float *scale, const T *x, const Tw *w) {
+
+    using Quant = op::common_cpu::Quant<Tq>;
+    const size_t dim = info.dim();
+    const auto &norm = info.norm;
+
+#pragma omp parallel num_threads(nthreads)
+    {
+        Tcompute *h = workspace + op::common_cpu::threadId() * dim;
+
+#pragma omp for
+        for (ptrdiff_t i = 0; i < ptrdiff_t(info.batch()); i++) {
+            auto x_ = x + i * norm.x_strides[0];
+            auto y_ = y + i * info.y_strides[0];
+
+            // [Reduce] sum of x^2 on last dimension
+            Tcompute ss = 0;
+            for (size_t j = 0; j < dim; j++) {
+                h[j] = op::common_cpu::loadCompute<Tcompute>(x_[j]);
+                ss += h[j] * h[j];
+            }
+
+            // 1 / (sqrt(sum/dim + eps))
+            Tcompute rms = Tcompute(1) / std::sqrt(ss / Tcompute(dim) + Tcompute(norm.epsilon));
+
+            // 归一化，同时求出逐行量化所需的绝对值最大值
+            Tcompute absmax = 0;
+            for (size_t j = 0; j < dim; j++) {
+                h[j] *= op::common_cpu::loadCompute<Tcompute>(w[j]) * rms;
+                absmax = std::max(absmax, std::abs(h[j]));
+            }
+
+            float s = absmax > 0 ? float(absmax) / Quant::max : 1.f;
+            scale[i * info.scale_stride] = s;
+            Tcompute inv_s = Tcompute(1) / Tcompute(s);
+            for (size_t j = 0; j < dim; j++) {
+                y_[j] = Quant::encode(float(h[j] * inv_s));
+            }
+        }
+    }
+}
+
+template <typename Tq>
+infiniStatus_t dispatchDtype(
+    const RMSNormQuantInfo &info,
+    void *workspace, size_t nthreads,
+    void *y, void *scale, const void *x, const void *w) {
+
+#define CALCULATE(T, TW, TCOMPUTE)                                      \
+    rmsNormQuant(info, (TCOMPUTE *)workspace, nthreads,                 \
+                 (Tq *)y, (float *)scale, (const T *)x, (const TW *)w); \
+    return INFINI_STATUS_SUCCESS
+
+    switch (info.norm.atype) {
+    case INFINI_DTYPE_F16:
+        if (info.norm.wtype == INFINI_DTYPE_F32) {
+            CALCULATE(fp16_t, float, float);
+        }
+        CALCULATE(fp16_t, fp16_t, float);
+    case INFINI_DTYPE_BF16:
+        if (info.norm.wtype == INFINI_DTYPE_F32) {
+            CALCULATE(bf16_t, float, float);
+        }
+        CALCULATE(bf16_t, bf16_t, float);
+    case INFINI_DTYPE_F32:
+        CALCULATE(float, float, float);
+    case INFINI_DTYPE_F64:
+        CALCULATE(double, double, double);
+    default:
+        return INFINI_STATUS_BAD_TENSOR_DTYPE;
+    }
+
+#undef CALCULATE
+}
+
+infiniStatus_t Descriptor::calculate(
+    void *workspace, size_t workspace_size,
+    void *y,
+    void *scale,
+    const void *x,
+    const void *w,
+    void *stream) const {
+
+    if (workspace_size < _workspace_size) {
+        return INFINI_STATUS_INSUFFICIENT_WORKSPACE;
+    }
+    auto nthreads = _workspace_size / op::rms_norm::rowWorkspaceSize(_info.dim(), _info.norm.atype);
+
+    switch (_info.qtype) {
+    case INFINI_DTYPE_I8:
+        return dispatchDtype<int8_t>(_info, workspace, nthreads, y, scale, x, w);
+    case INFINI_DTYPE_F8:
+        return dispatchDtype<fp8_t>(_info, workspace, nthreads, y, scale, x, w);
+    default:
+        return INFINI_STATUS_BAD_TENSOR_DTYPE;
+    }
+}
+
+} // namespace op::rms_norm_quant::cpu
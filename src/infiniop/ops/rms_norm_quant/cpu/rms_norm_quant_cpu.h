@@ -0,0 +1,8 @@
+#ifndef __RMS_NORM_QUANT_CPU_H__
+#define __RMS_NORM_QUANT_CPU_H__
+
+#include "../rms_norm_quant.h"
+
+DESCRIPTOR(cpu)
+
+#endif // __RMS_NORM_QUANT_CPU_H__
@@ -0,0 +1,53 @@
+#ifndef __RMS_NORM_QUANT_INFO_H__
+#define __RMS_NORM_QUANT_INFO_H__
+
+#include "../rms_norm/info.h"
+
+namespace op::rms_norm_quant {
+
+class RMSNormQuantInfo {
+    RMSNormQuantInfo(op::rms_norm::RMSNormInfo norm) : norm(std::move(norm)) {}
+
+public:
+    // x/w 的类型和形状要求与 rms_norm 相同，只支持二维且最后一维连续；norm.y_strides 不使用
+    op::rms_norm::RMSNormInfo norm;
+    // 量化输出的类型（I8/F8）及其步长
+    infiniDtype_t qtype;
+    std::vector<ptrdiff_t> y_strides;
+    // 每行一个 F32 缩放因子，y * scale 还原出归一化的结果
+    ptrdiff_t scale_stride;
+
+    size_t batch() const { return norm.shape[0]; }
+    size_t dim() const { return norm.dim(); }
+
+    static utils::Result<RMSNormQuantInfo> create(
+        infiniopTensorDescriptor_t y_desc,
+        infiniopTensorDescriptor_t scale_desc,
+        infiniopTensorDescriptor_t x_desc,
+        infiniopTensorDescriptor_t w_desc,
+        float epsilon) {
+
+        CHECK_OR_RETURN(x_desc->ndim() == 2, INFINI_STATUS_BAD_TENSOR_SHAPE);
+        auto result = op::rms_norm::RMSNormInfo::create(x_desc, x_desc, w_desc, epsilon);
+        CHECK_RESULT(result);
+
+        auto qtype = y_desc->dtype();
+        CHECK_DTYPE(qtype, INFINI_DTYPE_I8, INFINI_DTYPE_F8);
+        CHECK_OR_RETURN(scale_desc->dtype() == INFINI_DTYPE_F32, INFINI_STATUS_BAD_TENSOR_DTYPE);
+        CHECK_SAME_SHAPE(y_desc->shape(), x_desc->shape());
+        CHECK_OR_RETURN(y_desc->dim(1) > 0, INFINI_STATUS_BAD_TENSOR_SHAPE);
+        CHECK_OR_RETURN(scale_desc->ndim() == 1 && scale_desc->dim(0) == y_desc->dim(0),
+                        INFINI_STATUS_BAD_TENSOR_SHAPE);
+        CHECK_OR_RETURN(y_desc->stride(1) == 1 && x_desc->stride(1) == 1, INFINI_STATUS_BAD_TENSOR_STRIDES);
+
+        RMSNormQuantInfo info(result.take());
+        info.qtype = qtype;
+        info.y_strides = y_desc->strides();
+        info.scale_stride = scale_desc->stride(0);
+        return utils::Result<RMSNormQuantInfo>(std::move(info));
+    }
+};
+
+} // namespace op::rms_norm_quant
+
+#endif // __RMS_NORM_QUANT_INFO_H__
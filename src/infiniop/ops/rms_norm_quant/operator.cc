@@ -0,0 +1,100 @@
+#include "../../operator.h"
+#include "../../handle.h"
+#include "infiniop/ops/rms_norm_quant.h"
+
+#ifdef ENABLE_CPU_API
+#include "cpu/rms_norm_quant_cpu.h"
+#endif
+
+__C infiniStatus_t infiniopCreateRMSNormQuantDescriptor(
+    infiniopHandle_t handle,
+    infiniopRMSNormQuantDescriptor_t *desc_ptr,
+    infiniopTensorDescriptor_t y_desc,
+    infiniopTensorDescriptor_t scale_desc,
+    infiniopTensorDescriptor_t x_desc,
+    infiniopTensorDescriptor_t w_desc,
+    float epsilon) {
+
+#define CREATE(CASE, NAMESPACE)                                                       \
+    case CASE:                                                                        \
+        return op::rms_norm_quant::NAMESPACE::Descriptor::create(                     \
+            handle,                                                                   \
+            reinterpret_cast<op::rms_norm_quant::NAMESPACE::Descriptor **>(desc_ptr), \
+            y_desc,                                                                   \
+            scale_desc,                                                               \
+            x_desc,                                                                   \
+            w_desc,                                                                   \
+            epsilon)
+
+    switch (handle->device) {
+#ifdef ENABLE_CPU_API
+        CREATE(INFINI_DEVICE_CPU, cpu);
+#endif
+    }
+
+#undef CREATE
+
+    return INFINI_STATUS_DEVICE_TYPE_NOT_SUPPORTED;
+}
+
+__C infiniStatus_t infiniopGetRMSNormQuantWorkspaceSize(infiniopRMSNormQuantDescriptor_t desc, size_t *size) {
+
+#define GET(CASE, NAMESPACE)                                                                          \
+    case CASE:                                                                                        \
+        *size = reinterpret_cast<op::rms_norm_quant::NAMESPACE::Descriptor *>(desc)->workspaceSize(); \
+        return INFINI_STATUS_SUCCESS                                                                  \
+
+    switch (desc->device_type) {
+#ifdef ENABLE_CPU_API
+        GET(INFINI_DEVICE_CPU, cpu);
+#endif
+    }
+
+#undef GET
+
+    return INFINI_STATUS_DEVICE_TYPE_NOT_SUPPORTED;
+}
+
+__C infiniStatus_t infiniopRMSNormQuant(
+    infiniopRMSNormQuantDescriptor_t desc,
+    void *workspace,
+    size_t workspace_size,
+    void *y,
+    void *scale,
+    const void *x,
+    const void *w,
+    void *stream) {
+
+#define CALCULATE(CASE, NAMESPACE)                                                             \
+    case CASE:                                                                                 \
+        return reinterpret_cast<op::rms_norm_quant::NAMESPACE::Descriptor *>(desc)->calculate( \
+            workspace, workspace_size, y, scale, x, w, stream)
+
+    switch (desc->device_type) {
+#ifdef ENABLE_CPU_API
+        CALCULATE(INFINI_DEVICE_CPU, cpu);
+#endif
+    }
+
+#undef CALCULATE
+
+    return INFINI_STATUS_DEVICE_TYPE_NOT_SUPPORTED;
+}
+
+__C infiniStatus_t infiniopDestroyRMSNormQuantDescriptor(infiniopRMSNormQuantDescriptor_t desc) {
+
+#define DESTROY(CASE, NAMESPACE)                                                    \
+    case CASE:                                                                      \
+        delete reinterpret_cast<op::rms_norm_quant::NAMESPACE::Descriptor *>(desc); \
+        return INFINI_STATUS_SUCCESS                                                \
+
+    switch (desc->device_type) {
+#ifdef ENABLE_CPU_API
+        DESTROY(INFINI_DEVICE_CPU, cpu);
+#endif
+    }
+
+#undef DESTROY
+
+    return INFINI_STATUS_DEVICE_TYPE_NOT_SUPPORTED;
+}
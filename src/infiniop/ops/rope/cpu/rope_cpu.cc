@@ -1,5 +1,5 @@
 #include "rope_cpu.h"
-#include "../../../devices/cpu/common_cpu.h"
+#include "rope_kernel.h"
 
 namespace op::rope::cpu {
 
@@ -12,17 +12,21 @@ infiniStatus_t Descriptor::create(
     infiniopTensorDescriptor_t x_desc,
     infiniopTensorDescriptor_t pos_desc,
     infiniopTensorDescriptor_t sin_desc,
-    infiniopTensorDescriptor_t cos_desc) {
+    infiniopTensorDescriptor_t cos_desc,
+    float theta,
+    const infiniopRoPEScaling_t *scaling,
+    infiniopRoPEAlgo_t algo) {
 
     auto handle = reinterpret_cast<device::cpu::Handle *>(handle_);
 
-    auto info = RoPEInfo::createRoPEInfo(y_desc, x_desc, pos_desc, sin_desc, cos_desc);
+    auto info = RoPEInfo::createRoPEInfo(y_desc, x_desc, pos_desc, sin_desc, cos_desc, theta, scaling, algo);
     CHECK_RESULT(info);
+    auto workspace_size = info->hasTable() ? 0 : op::common_cpu::maxThreads() * threadWorkspaceSize(*info);
 
     // Create descriptor
     *desc_ptr = new Descriptor(
         info.take(),
-        0,
+        workspace_size,
         nullptr,
         handle->device,
         handle->device_id);
@@ -30,7 +34,8 @@ infiniStatus_t Descriptor::create(
     return INFINI_STATUS_SUCCESS;
 }
 
-template <typename Tdata, typename Tindex>
+// 以 (token, head) 为单位并行，头数少于线程数时也能占满线程
+template <bool NEOX, typename Tdata, typename Tindex>
 infiniStatus_t calculateRoPE(const RoPEInfo &info,
                              Tdata *y,
                              const Tdata *x,
@@ -38,43 +43,66 @@ infiniStatus_t calculateRoPE(const RoPEInfo &info,
                              const Tdata *sin_table,
                              const Tdata *cos_table) {
 #pragma omp parallel for
-    for (ptrdiff_t h = 0; h < ptrdiff_t(info.nhead); h++) {
-        for (size_t tok = 0; tok < info.seqlen; tok++) {
-            size_t x_offset = tok * info.x_stride_seqlen + h * info.x_stride_nhead;
-            size_t y_offset = tok * info.y_stride_seqlen + h * info.y_stride_nhead;
-            size_t pos_id = size_t(pos_ids[tok]);
-            size_t table_offset = pos_id * info.table_dim;
-
-            for (size_t i = 0; i < info.table_dim; i++) {
-                size_t pos0 = 2 * i;
-                size_t pos1 = 2 * i + 1;
-
-                if constexpr (std::is_same<Tdata, fp16_t>::value || std::is_same<Tdata, bf16_t>::value) {
-                    float x0 = utils::cast<float>(x[x_offset + pos0]),
-                          x1 = utils::cast<float>(x[x_offset + pos1]),
-                          sin__ = utils::cast<float>(sin_table[table_offset + i]),
-                          cos__ = utils::cast<float>(cos_table[table_offset + i]);
-
-                    y[y_offset + pos0] = utils::cast<Tdata>(x0 * cos__ - x1 * sin__);
-                    y[y_offset + pos1] = utils::cast<Tdata>(x0 * sin__ + x1 * cos__);
-                } else {
-                    Tdata x0 = x[x_offset + pos0],
-                          x1 = x[x_offset + pos1],
-                          sin__ = sin_table[table_offset + i],
-                          cos__ = cos_table[table_offset + i];
-
-                    y[y_offset + pos0] = x0 * cos__ - x1 * sin__;
-                    y[y_offset + pos1] = x0 * sin__ + x1 * cos__;
-                }
-            }
+    for (ptrdiff_t index = 0; index < ptrdiff_t(info.seqlen * info.nhead); index++) {
+        size_t tok = index / info.nhead,
+               h = index % info.nhead;
+        size_t table_offset = size_t(pos_ids[tok]) * info.table_dim;
+        rotateHead<NEOX>(y + tok * info.y_stride_seqlen + h * info.y_stride_nhead,
+                         x + tok * info.x_stride_seqlen + h * info.x_stride_nhead,
+                         sin_table + table_offset,
+                         cos_table + table_offset,
+                         info.table_dim);
+    }
+
+    return INFINI_STATUS_SUCCESS;
+}
+
+// 按 theta 计算旋转角，每个线程缓存当前位置的 sin 和 cos
+template <bool NEOX, typename Tdata, typename Tindex>
+infiniStatus_t calculateRoPETheta(const RoPEInfo &info,
+                                  void *workspace,
+                                  size_t nthreads,
+                                  Tdata *y,
+                                  const Tdata *x,
+                                  const Tindex *pos_ids) {
+#pragma omp parallel num_threads(nthreads)
+    {
+        ThetaAngles<ComputeType<Tdata>, Tindex> angles(info, workspace);
+
+#pragma omp for schedule(static)
+        for (ptrdiff_t index = 0; index < ptrdiff_t(info.seqlen * info.nhead); index++) {
+            size_t tok = index / info.nhead,
+                   h = index % info.nhead;
+            angles.update(pos_ids[tok]);
+            rotateHead<NEOX>(y + tok * info.y_stride_seqlen + h * info.y_stride_nhead,
+                             x + tok * info.x_stride_seqlen + h * info.x_stride_nhead,
+                             angles.sin, angles.cos, info.table_dim);
         }
     }
 
     return INFINI_STATUS_SUCCESS;
 }
 
-#define CALCULATE_ROPE(TDATA, TINDEX) \
-    calculateRoPE(_info, (TDATA *)y, (const TDATA *)x, (const TINDEX *)pos_ids, (const TDATA *)sin_table, (const TDATA *)cos_table)
+template <bool NEOX, typename Tdata, typename Tindex>
+infiniStatus_t dispatchTable(const RoPEInfo &info,
+                             void *workspace,
+                             size_t nthreads,
+                             void *y,
+                             const void *x,
+                             const void *pos_ids,
+                             const void *sin_table,
+                             const void *cos_table) {
+    if (info.hasTable()) {
+        return calculateRoPE<NEOX>(info, (Tdata *)y, (const Tdata *)x, (const Tindex *)pos_ids,
+                                   (const Tdata *)sin_table, (const Tdata *)cos_table);
+    }
+    return calculateRoPETheta<NEOX>(info, workspace, nthreads, (Tdata *)y, (const Tdata *)x, (const Tindex *)pos_ids);
+}
+
+#define CALCULATE_ROPE(TDATA, TINDEX)                                                                         \
+    _info.algo == INFINIOP_ROPE_ALGO_GPT_NEOX                                                                 \
+        ? dispatchTable<true, TDATA, TINDEX>(_info, workspace, nthreads, y, x, pos_ids, sin_table, cos_table) \
+        : dispatchTable<false, TDATA, TINDEX>(_info, workspace, nthreads, y, x, pos_ids, sin_table, cos_table)
 
 #define ROPE_TYPE(TDATA)                        \
     switch (_info.pos_type) {                   \
@@ -108,6 +136,11 @@ infiniStatus_t Descriptor::calculate(
     const void *cos_table,
     void *stream) const {
 
+    if (workspace_size < _workspace_size) {
+        return INFINI_STATUS_INSUFFICIENT_WORKSPACE;
+    }
+    auto nthreads = _info.hasTable() ? 1 : _workspace_size / threadWorkspaceSize(_info);
+
     switch (_info.data_type) {
     case INFINI_DTYPE_F16:
         ROPE_TYPE(fp16_t);
@@ -0,0 +1,102 @@
+#ifndef __ROPE_KERNEL_CPU_H__
+#define __ROPE_KERNEL_CPU_H__
+
+#include "../../../devices/cpu/common_cpu.h"
+#include "../../../reduce/cpu/reduce.h"
+#include "../info.h"
+
+// RoPE 与融合的 RoPE + KV-cache 共用的旋转核
+namespace op::rope::cpu {
+
+// F64 用 double 计算，其余用 float
+template <typename Tdata>
+using ComputeType = std::conditional_t<std::is_same<Tdata, double>::value, double, float>;
+
+// 按 theta 计算时每个线程缓存当前位置的 sin 和 cos
+inline size_t threadWorkspaceSize(const RoPEInfo &info) {
+    return 2 * info.table_dim * (info.data_type == INFINI_DTYPE_F64 ? sizeof(double) : sizeof(float));
+}
+
+// 每次旋转的维度对数，转换成计算类型的中间结果留在栈上
+constexpr size_t BLOCK_SIZE = 64;
+
+// 旋转一个头向量，y 与 x 可以是同一块内存。
+// GPT-J 布局第 2i 维与第 2i + 1 维成对，GPT-NeoX 布局第 i 维与第 i + half 维成对，
+// 两种布局的区别只在于读写的下标，旋转本身是连续的逐元素运算，可以向量化
+template <bool NEOX, typename Tdata, typename Tangle>
+void rotateHead(Tdata *y, const Tdata *x, const Tangle *sin, const Tangle *cos, size_t half) {
+    using Tcompute = ComputeType<Tdata>;
+    auto first = [=](size_t i) { return NEOX ? i : 2 * i; };
+    auto second = [=](size_t i) { return NEOX ? i + half : 2 * i + 1; };
+
+    if constexpr (std::is_same<Tdata, Tcompute>::value && std::is_same<Tangle, Tcompute>::value) {
+        for (size_t i = 0; i < half; i++) {
+            Tcompute x0 = x[first(i)],
+                     x1 = x[second(i)];
+            y[first(i)] = x0 * cos[i] - x1 * sin[i];
+            y[second(i)] = x0 * sin[i] + x1 * cos[i];
+        }
+    } else {
+        // 先分块转换成 float 再旋转，半精度用内联的位运算转换
+        Tcompute x0[BLOCK_SIZE], x1[BLOCK_SIZE], sin_[BLOCK_SIZE], cos_[BLOCK_SIZE];
+        for (size_t i = 0; i < half; i += BLOCK_SIZE) {
+            const size_t len = std::min(BLOCK_SIZE, half - i);
+            for (size_t k = 0; k < len; k++) {
+                x0[k] = op::common_cpu::loadFloat(x[first(i + k)]);
+                x1[k] = op::common_cpu::loadFloat(x[second(i + k)]);
+                sin_[k] = op::common_cpu::loadFloat(sin[i + k]);
+                cos_[k] = op::common_cpu::loadFloat(cos[i + k]);
+            }
+            for (size_t k = 0; k < len; k++) {
+                Tcompute y0 = x0[k] * cos_[k] - x1[k] * sin_[k],
+                         y1 = x0[k] * sin_[k] + x1[k] * cos_[k];
+                x0[k] = y0;
+                x1[k] = y1;
+            }
+            for (size_t k = 0; k < len; k++) {
+                op::common_cpu::storeFloat(y[first(i + k)], x0[k]);
+                op::common_cpu::storeFloat(y[second(i + k)], x1[k]);
+            }
+        }
+    }
+}
+
+// 按 theta 计算旋转角时当前线程的 sin 和 cos，存放在 workspace 中本线程的一段。
+// 同一线程上相邻的任务大多属于同一个 token，因此只在位置变化时重新计算
+template <typename Tcompute, typename Tindex>
+struct ThetaAngles {
+    const RoPEInfo &info;
+    Tcompute *sin, *cos;
+    bool cached = false;
+    Tindex cached_pos = 0;
+
+    ThetaAngles(const RoPEInfo &info_, void *workspace)
+        : info(info_),
+          sin(reinterpret_cast<Tcompute *>(workspace) + op::common_cpu::threadId() * 2 * info_.table_dim),
+          cos(sin + info_.table_dim) {}
+
+    void update(Tindex pos) {
+        if (cached && pos == cached_pos) {
+            return;
+        }
+        const Tcompute attention_factor = info.attention_factor;
+        for (size_t i = 0; i < info.table_dim; i++) {
+            double angle = double(pos) * info.inv_freq[i];
+            if constexpr (std::is_same<Tcompute, double>::value) {
+                sin[i] = std::sin(angle) * attention_factor;
+                cos[i] = std::cos(angle) * attention_factor;
+            } else {
+                float s, c;
+                op::common_cpu::fastSinCos(angle, s, c);
+                sin[i] = s * attention_factor;
+                cos[i] = c * attention_factor;
+            }
+        }
+        cached = true;
+        cached_pos = pos;
+    }
+};
+
+} // namespace op::rope::cpu
+
+#endif // __ROPE_KERNEL_CPU_H__
@@ -0,0 +1,181 @@
+#ifndef __ROPE_INFO_H__
+#define __ROPE_INFO_H__
+
+#include "../../../utils.h"
+#include "../../tensor.h"
+#include "infiniop/ops/rope.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+class RoPEInfo {
+private:
+    RoPEInfo() = default;
+
+    // 由 theta 和缩放方式计算每对维度的旋转频率，与 HuggingFace transformers 的 rope_init_fn 一致
+    static utils::Result<std::vector<double>> computeInvFreq(
+        size_t dhead, float theta, const infiniopRoPEScaling_t &scaling) {
+
+        const size_t half = dhead / 2;
+        double base = theta;
+        if (scaling.type == INFINIOP_ROPE_SCALING_NTK) {
+            // NTK-aware：放大 base，高频几乎不变，低频被插值
+            base *= std::pow(double(scaling.factor), double(dhead) / double(dhead - 2));
+        }
+
+        std::vector<double> inv_freq(half);
+        for (size_t i = 0; i < half; ++i) {
+            inv_freq[i] = std::pow(base, -double(2 * i) / double(dhead));
+        }
+
+        switch (scaling.type) {
+        case INFINIOP_ROPE_SCALING_NONE:
+        case INFINIOP_ROPE_SCALING_NTK:
+            break;
+        case INFINIOP_ROPE_SCALING_LINEAR:
+            for (auto &f : inv_freq) {
+                f /= scaling.factor;
+            }
+            break;
+        case INFINIOP_ROPE_SCALING_YARN: {
+            CHECK_OR_RETURN(scaling.original_max_position_embeddings > 0, INFINI_STATUS_BAD_PARAM);
+            const double beta_fast = scaling.beta_fast > 0 ? scaling.beta_fast : 32.,
+                         beta_slow = scaling.beta_slow > 0 ? scaling.beta_slow : 1.;
+            constexpr double PI = 3.14159265358979323846;
+            // 在原始上下文长度内旋转圈数为 num_rotations 的维度
+            auto correctionDim = [&](double num_rotations) {
+                return double(dhead)
+                     * std::log(double(scaling.original_max_position_embeddings) / (num_rotations * 2 * PI))
+                     / (2 * std::log(base));
+            };
+            double low = std::max(std::floor(correctionDim(beta_fast)), 0.),
+                   high = std::min(std::ceil(correctionDim(beta_slow)), double(dhead - 1));
+            if (low == high) {
+                high += 0.001;
+            }
+            // 低于 low 的高频维度外推（保持原频率），高于 high 的低频维度插值，中间线性过渡
+            for (size_t i = 0; i < half; ++i) {
+                double ramp = std::min(std::max((double(i) - low) / (high - low), 0.), 1.);
+                inv_freq[i] = inv_freq[i] / scaling.factor * ramp + inv_freq[i] * (1 - ramp);
+            }
+            break;
+        }
+        default:
+            return INFINI_STATUS_BAD_PARAM;
+        }
+        return utils::Result<std::vector<double>>(std::move(inv_freq));
+    }
+
+public:
+    infiniDtype_t data_type, pos_type;
+    size_t seqlen, nhead, dhead, table_len, table_dim;
+    ptrdiff_t
+        y_stride_seqlen,
+        y_stride_nhead,
+        x_stride_seqlen,
+        x_stride_nhead;
+
+    // 不传 sin/cos 表时由 theta 在核函数内计算旋转角，inv_freq 为每对维度的频率，
+    // attention_factor 为 YaRN 等缩放方式对 sin/cos 的整体放缩
+    bool has_table;
+    // 维度配对方式：GPT-J 为 (2i, 2i + 1)，GPT-NeoX 为 (i, i + dhead / 2)
+    infiniopRoPEAlgo_t algo;
+    std::vector<double> inv_freq;
+    float attention_factor;
+
+    bool hasTable() const { return has_table; }
+
+    static utils::Result<RoPEInfo> createRoPEInfo(
+        infiniopTensorDescriptor_t y_desc,
+        infiniopTensorDescriptor_t x_desc,
+        infiniopTensorDescriptor_t pos_desc,
+        infiniopTensorDescriptor_t sin_desc,
+        infiniopTensorDescriptor_t cos_desc,
+        float theta = 0.f,
+        const infiniopRoPEScaling_t *scaling = nullptr,
+        infiniopRoPEAlgo_t algo = INFINIOP_ROPE_ALGO_GPT_J) {
+        CHECK_OR_RETURN(
+            y_desc != nullptr && x_desc != nullptr && pos_desc != nullptr,
+            INFINI_STATUS_NULL_POINTER);
+        // sin 表和 cos 表要么都给出，要么都不给出（由 theta 计算）
+        CHECK_OR_RETURN((sin_desc == nullptr) == (cos_desc == nullptr), INFINI_STATUS_NULL_POINTER);
+        const bool has_table = sin_desc != nullptr;
+
+        const infiniDtype_t data_type = y_desc->dtype();
+        const infiniDtype_t pos_type = pos_desc->dtype();
+        CHECK_OR_RETURN(data_type == x_desc->dtype(), INFINI_STATUS_BAD_TENSOR_DTYPE);
+        CHECK_DTYPE(data_type, INFINI_DTYPE_F16, INFINI_DTYPE_BF16, INFINI_DTYPE_F32, INFINI_DTYPE_F64);
+        CHECK_DTYPE_ANY_INT(pos_type);
+        CHECK_OR_RETURN(algo == INFINIOP_ROPE_ALGO_GPT_J || algo == INFINIOP_ROPE_ALGO_GPT_NEOX, INFINI_STATUS_BAD_PARAM);
+
+        CHECK_OR_RETURN(y_desc->ndim() == 3
+                            && x_desc->ndim() == 3
+                            && pos_desc->ndim() == 1,
+                        INFINI_STATUS_BAD_TENSOR_SHAPE);
+
+        const auto seqlen = y_desc->dim(0),
+                   nhead = y_desc->dim(1),
+                   dhead = y_desc->dim(2);
+
+        CHECK_OR_RETURN(seqlen == x_desc->dim(0)
+                            && seqlen == pos_desc->dim(0)
+                            && nhead == x_desc->dim(1) && dhead == x_desc->dim(2),
+                        INFINI_STATUS_BAD_TENSOR_SHAPE);
+        // Last dimension of x and y must be contiguous
+        CHECK_OR_RETURN(y_desc->stride(2) == 1 && x_desc->stride(2) == 1, INFINI_STATUS_BAD_TENSOR_STRIDES);
+
+        RoPEInfo info;
+        info.data_type = data_type;
+        info.pos_type = pos_type;
+        info.seqlen = seqlen;
+        info.nhead = nhead;
+        info.dhead = dhead;
+        info.y_stride_seqlen = y_desc->stride(0);
+        info.y_stride_nhead = y_desc->stride(1);
+        info.x_stride_seqlen = x_desc->stride(0);
+        info.x_stride_nhead = x_desc->stride(1);
+        info.has_table = has_table;
+        info.algo = algo;
+        info.attention_factor = 1.f;
+
+        if (has_table) {
+            CHECK_OR_RETURN(data_type == sin_desc->dtype() && data_type == cos_desc->dtype(),
+                            INFINI_STATUS_BAD_TENSOR_DTYPE);
+            CHECK_OR_RETURN(sin_desc->ndim() == 2 && cos_desc->ndim() == 2, INFINI_STATUS_BAD_TENSOR_SHAPE);
+            info.table_len = sin_desc->dim(0);
+            info.table_dim = sin_desc->dim(1);
+            CHECK_OR_RETURN(info.table_len == cos_desc->dim(0) && info.table_dim == cos_desc->dim(1),
+                            INFINI_STATUS_BAD_TENSOR_SHAPE);
+            // sin table and cos table must be totally contiguous
+            CHECK_OR_RETURN(sin_desc->isContiguous() && cos_desc->isContiguous(), INFINI_STATUS_BAD_TENSOR_STRIDES);
+        } else {
+            CHECK_OR_RETURN(std::isfinite(theta) && theta > 1.f, INFINI_STATUS_BAD_PARAM);
+            CHECK_OR_RETURN(dhead % 2 == 0 && dhead >= 2, INFINI_STATUS_BAD_TENSOR_SHAPE);
+            infiniopRoPEScaling_t scaling_{};
+            if (scaling != nullptr) {
+                scaling_ = *scaling;
+                if (scaling_.type != INFINIOP_ROPE_SCALING_NONE) {
+                    CHECK_OR_RETURN(std::isfinite(scaling_.factor) && scaling_.factor >= 1.f, INFINI_STATUS_BAD_PARAM);
+                }
+            }
+            // NTK 的 base 缩放指数为 dhead / (dhead - 2)
+            CHECK_OR_RETURN(scaling_.type != INFINIOP_ROPE_SCALING_NTK || dhead > 2, INFINI_STATUS_BAD_TENSOR_SHAPE);
+            auto inv_freq = computeInvFreq(dhead, theta, scaling_);
+            CHECK_RESULT(inv_freq);
+            info.inv_freq = inv_freq.take();
+            info.table_len = 0;
+            info.table_dim = dhead / 2;
+            if (scaling_.attention_factor > 0.f) {
+                info.attention_factor = scaling_.attention_factor;
+            } else if (scaling_.type == INFINIOP_ROPE_SCALING_YARN && scaling_.factor > 1.f) {
+                info.attention_factor = 0.1f * std::log(scaling_.factor) + 1.f;
+            }
+        }
+
+        CHECK_OR_RETURN(dhead == info.table_dim * 2, INFINI_STATUS_BAD_TENSOR_SHAPE);
+
+        return utils::Result<RoPEInfo>(std::move(info));
+    }
+};
+
+#endif // __ROPE_INFO_H__
@@ -42,12 +42,18 @@ infiniStatus_t Descriptor::create(
     infiniopTensorDescriptor_t x_desc,
     infiniopTensorDescriptor_t pos_desc,
     infiniopTensorDescriptor_t sin_desc,
-    infiniopTensorDescriptor_t cos_desc) {
+    infiniopTensorDescriptor_t cos_desc,
+    float theta,
+    const infiniopRoPEScaling_t *scaling,
+    infiniopRoPEAlgo_t algo) {
 
     auto handle = reinterpret_cast<device::nvidia::Handle *>(handle_);
 
-    auto info = RoPEInfo::createRoPEInfo(y_desc, x_desc, pos_desc, sin_desc, cos_desc);
+    auto info = RoPEInfo::createRoPEInfo(y_desc, x_desc, pos_desc, sin_desc, cos_desc, theta, scaling, algo);
     CHECK_RESULT(info);
+    if (!info->hasTable() || info->algo != INFINIOP_ROPE_ALGO_GPT_J) {
+        return INFINI_STATUS_NOT_IMPLEMENTED;
+    }
 
     // Create descriptor
     *desc_ptr = new Descriptor(
@@ -0,0 +1,169 @@
+#include "rope_kv_cache_cpu.h"
+#include "../../rope/cpu/rope_kernel.h"
+
+namespace op::rope_kv_cache::cpu {
+
+Descriptor::~Descriptor() = default;
+
+infiniStatus_t Descriptor::create(
+    infiniopHandle_t handle_,
+    Descriptor **desc_ptr,
+    infiniopTensorDescriptor_t q_desc,
+    infiniopTensorDescriptor_t k_desc,
+    infiniopTensorDescriptor_t v_desc,
+    infiniopTensorDescriptor_t k_cache_desc,
+    infiniopTensorDescriptor_t v_cache_desc,
+    infiniopTensorDescriptor_t pos_desc,
+    infiniopTensorDescriptor_t sin_desc,
+    infiniopTensorDescriptor_t cos_desc,
+    size_t pos,
+    float theta,
+    const infiniopRoPEScaling_t *scaling,
+    infiniopRoPEAlgo_t algo) {
+    auto handle = reinterpret_cast<device::cpu::Handle *>(handle_);
+
+    auto result = RoPEKVCacheInfo::create(
+        q_desc, k_desc, v_desc,
+        k_cache_desc, v_cache_desc,
+        pos_desc, sin_desc, cos_desc,
+        pos, theta, scaling, algo);
+    CHECK_RESULT(result);
+    auto info = result.take();
+    auto workspace_size = info.q.hasTable() ? 0 : op::common_cpu::maxThreads() * op::rope::cpu::threadWorkspaceSize(info.q);
+
+    *desc_ptr = new Descriptor(
+        nullptr,
+        std::move(info),
+        workspace_size,
+        handle->device,
+        handle->device_id);
+    return INFINI_STATUS_SUCCESS;
+}
+
+// 每个 (token, head) 为一个任务：q 头原地旋转；kv 头把旋转后的 k 和原样的 v 写入缓存。
+// 所有头放在同一个并行循环里，只启动一次线程组，每个元素只读写一遍。
+// 旋转与 RoPE 算子共用 rotateHead，配对方式和按 theta 计算旋转角的方式与之一致
+template <bool NEOX, typename Tdata, typename Tindex>
+infiniStatus_t calculateRoPEKVCache(const RoPEKVCacheInfo &info,
+                                    void *workspace,
+                                    size_t nthreads,
+                                    Tdata *q,
+                                    const Tdata *k,
+                                    const Tdata *v,
+                                    Tdata *k_cache,
+                                    Tdata *v_cache,
+                                    const Tindex *pos_ids,
+                                    const Tdata *sin_table,
+                                    const Tdata *cos_table) {
+    const size_t n_q_head = info.q.nhead,
+                 n_head = n_q_head + info.k.nhead,
+                 half = info.q.table_dim;
+
+    auto task = [&](size_t tok, size_t h, const auto *sin_, const auto *cos_) {
+        if (h < n_q_head) {
+            auto q_ = q + tok * info.q.y_stride_seqlen + h * info.q.y_stride_nhead;
+            op::rope::cpu::rotateHead<NEOX>(q_, q_, sin_, cos_, half);
+        } else {
+            h -= n_q_head;
+            size_t cache_pos = info.pos + tok;
+            op::rope::cpu::rotateHead<NEOX>(k_cache + h * info.k_cache_stride_head + cache_pos * info.k_cache_stride_seq,
+                                            k + tok * info.k.x_stride_seqlen + h * info.k.x_stride_nhead,
+                                            sin_, cos_, half);
+            std::memcpy(v_cache + h * info.v_cache_stride_head + cache_pos * info.v_cache_stride_seq,
+                        v + tok * info.v_stride_seqlen + h * info.v_stride_nhead,
+                        info.q.dhead * sizeof(Tdata));
+        }
+    };
+
+    if (info.q.hasTable()) {
+#pragma omp parallel for
+        for (ptrdiff_t index = 0; index < ptrdiff_t(info.q.seqlen * n_head); index++) {
+            size_t tok = index / n_head;
+            size_t table_offset = size_t(pos_ids[tok]) * half;
+            task(tok, index % n_head, sin_table + table_offset, cos_table + table_offset);
+        }
+    } else {
+#pragma omp parallel num_threads(nthreads)
+        {
+            op::rope::cpu::ThetaAngles<op::rope::cpu::ComputeType<Tdata>, Tindex> angles(info.q, workspace);
+
+#pragma omp for schedule(static)
+            for (ptrdiff_t index = 0; index < ptrdiff_t(info.q.seqlen * n_head); index++) {
+                size_t tok = index / n_head;
+                angles.update(pos_ids[tok]);
+                task(tok, index % n_head, angles.sin, angles.cos);
+            }
+        }
+    }
+
+    return INFINI_STATUS_SUCCESS;
+}
+
+#define CALCULATE_NEOX(NEOX, TDATA, TINDEX)                                                                \
+    calculateRoPEKVCache<NEOX>(_info, workspace, nthreads, (TDATA *)q, (const TDATA *)k, (const TDATA *)v, \
+                               (TDATA *)k_cache, (TDATA *)v_cache, (const TINDEX *)pos_ids,                \
+                               (const TDATA *)sin_table, (const TDATA *)cos_table)
+
+#define CALCULATE(TDATA, TINDEX)                \
+    _info.q.algo == INFINIOP_ROPE_ALGO_GPT_NEOX \
+        ? CALCULATE_NEOX(true, TDATA, TINDEX)   \
+        : CALCULATE_NEOX(false, TDATA, TINDEX)
+
+#define POS_TYPE(TDATA)                        \
+    switch (_info.q.pos_type) {                \
+    case INFINI_DTYPE_U8:                      \
+        return CALCULATE(TDATA, uint8_t);      \
+    case INFINI_DTYPE_U16:                     \
+        return CALCULATE(TDATA, uint16_t);     \
+    case INFINI_DTYPE_U32:                     \
+        return CALCULATE(TDATA, uint32_t);     \
+    case INFINI_DTYPE_U64:                     \
+        return CALCULATE(TDATA, uint64_t);     \
+    case INFINI_DTYPE_I8:                      \
+        return CALCULATE(TDATA, int8_t);       \
+    case INFINI_DTYPE_I16:                     \
+        return CALCULATE(TDATA, int16_t);      \
+    case INFINI_DTYPE_I32:                     \
+        return CALCULATE(TDATA, int32_t);      \
+    case INFINI_DTYPE_I64:                     \
+        return CALCULATE(TDATA, int64_t);      \
+    default:                                   \
+        return INFINI_STATUS_BAD_TENSOR_DTYPE; \
+    }
+
+infiniStatus_t Descriptor::calculate(
+    void *workspace, size_t workspace_size,
+    void *q,
+    const void *k,
+    const void *v,
+    void *k_cache,
+    void *v_cache,
+    const void *pos_ids,
+    const void *sin_table,
+    const void *cos_table,
+    void *stream) const {
+
+    if (workspace_size < _workspace_size) {
+        return INFINI_STATUS_INSUFFICIENT_WORKSPACE;
+    }
+    auto nthreads = _info.q.hasTable() ? 1 : _workspace_size / op::rope::cpu::threadWorkspaceSize(_info.q);
+
+    switch (_info.q.data_type) {
+    case INFINI_DTYPE_F16:
+        POS_TYPE(fp16_t);
+    case INFINI_DTYPE_BF16:
+        POS_TYPE(bf16_t);
+    case INFINI_DTYPE_F32:
+        POS_TYPE(float);
+    case INFINI_DTYPE_F64:
+        POS_TYPE(double);
+    default:
+        return INFINI_STATUS_BAD_TENSOR_DTYPE;
+    }
+}
+
+#undef POS_TYPE
+#undef CALCULATE
+#undef CALCULATE_NEOX
+
+} // namespace op::rope_kv_cache::cpu
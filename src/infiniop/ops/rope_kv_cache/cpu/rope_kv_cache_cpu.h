@@ -0,0 +1,8 @@
+#ifndef __ROPE_KV_CACHE_CPU_H__
+#define __ROPE_KV_CACHE_CPU_H__
+
+#include "../rope_kv_cache.h"
+
+DESCRIPTOR(cpu)
+
+#endif // __ROPE_KV_CACHE_CPU_H__
@@ -0,0 +1,82 @@
+#ifndef __ROPE_KV_CACHE_INFO_H__
+#define __ROPE_KV_CACHE_INFO_H__
+
+#include "../rope/info.h"
+
+namespace op::rope_kv_cache {
+
+class RoPEKVCacheInfo {
+    RoPEKVCacheInfo(RoPEInfo q_, RoPEInfo k_) : q(std::move(q_)), k(std::move(k_)) {}
+
+public:
+    // q 原地旋转，k 旋转后写入缓存；两者共用 sin/cos 表（或 theta）与配对方式，由 RoPEInfo 负责形状和步长检查
+    RoPEInfo q, k;
+    size_t pos;
+    ptrdiff_t v_stride_seqlen, v_stride_nhead;
+    ptrdiff_t k_cache_stride_head, k_cache_stride_seq;
+    ptrdiff_t v_cache_stride_head, v_cache_stride_seq;
+
+    static utils::Result<RoPEKVCacheInfo> create(
+        infiniopTensorDescriptor_t q_desc,
+        infiniopTensorDescriptor_t k_desc,
+        infiniopTensorDescriptor_t v_desc,
+        infiniopTensorDescriptor_t k_cache_desc,
+        infiniopTensorDescriptor_t v_cache_desc,
+        infiniopTensorDescriptor_t pos_desc,
+        infiniopTensorDescriptor_t sin_desc,
+        infiniopTensorDescriptor_t cos_desc,
+        size_t pos,
+        float theta = 0.f,
+        const infiniopRoPEScaling_t *scaling = nullptr,
+        infiniopRoPEAlgo_t algo = INFINIOP_ROPE_ALGO_GPT_J) {
+
+        CHECK_OR_RETURN(v_desc != nullptr && k_cache_desc != nullptr && v_cache_desc != nullptr,
+                        INFINI_STATUS_NULL_POINTER);
+
+        auto q_info = RoPEInfo::createRoPEInfo(q_desc, q_desc, pos_desc, sin_desc, cos_desc, theta, scaling, algo);
+        CHECK_RESULT(q_info);
+        auto k_info = RoPEInfo::createRoPEInfo(k_desc, k_desc, pos_desc, sin_desc, cos_desc, theta, scaling, algo);
+        CHECK_RESULT(k_info);
+
+        auto dtype = q_info->data_type;
+        CHECK_OR_RETURN(k_info->data_type == dtype
+                            && v_desc->dtype() == dtype
+                            && k_cache_desc->dtype() == dtype
+                            && v_cache_desc->dtype() == dtype,
+                        INFINI_STATUS_BAD_TENSOR_DTYPE);
+
+        const auto seqlen = q_info->seqlen,
+                   n_q_head = q_info->nhead,
+                   n_kv_head = k_info->nhead,
+                   head_dim = q_info->dhead;
+        CHECK_OR_RETURN(n_kv_head > 0 && n_q_head % n_kv_head == 0 && k_info->dhead == head_dim,
+                        INFINI_STATUS_BAD_TENSOR_SHAPE);
+        CHECK_OR_RETURN(v_desc->ndim() == 3
+                            && k_cache_desc->ndim() == 3
+                            && v_cache_desc->ndim() == 3,
+                        INFINI_STATUS_BAD_TENSOR_SHAPE);
+        CHECK_SAME_SHAPE(v_desc->shape(), k_desc->shape());
+        for (auto desc : {k_cache_desc, v_cache_desc}) {
+            CHECK_OR_RETURN(desc->dim(0) == n_kv_head && desc->dim(1) >= pos + seqlen && desc->dim(2) == head_dim,
+                            INFINI_STATUS_BAD_TENSOR_SHAPE);
+        }
+        // head_dim 必须连续
+        for (auto desc : {v_desc, k_cache_desc, v_cache_desc}) {
+            CHECK_OR_RETURN(desc->stride(2) == 1, INFINI_STATUS_BAD_TENSOR_STRIDES);
+        }
+
+        RoPEKVCacheInfo info(q_info.take(), k_info.take());
+        info.pos = pos;
+        info.v_stride_seqlen = v_desc->stride(0);
+        info.v_stride_nhead = v_desc->stride(1);
+        info.k_cache_stride_head = k_cache_desc->stride(0);
+        info.k_cache_stride_seq = k_cache_desc->stride(1);
+        info.v_cache_stride_head = v_cache_desc->stride(0);
+        info.v_cache_stride_seq = v_cache_desc->stride(1);
+        return utils::Result<RoPEKVCacheInfo>(std::move(info));
+    }
+};
+
+} // namespace op::rope_kv_cache
+
+#endif // __ROPE_KV_CACHE_INFO_H__
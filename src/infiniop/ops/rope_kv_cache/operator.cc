@@ -0,0 +1,135 @@
+#include "../../operator.h"
+#include "../../handle.h"
+#include "infiniop/ops/rope_kv_cache.h"
+
+#ifdef ENABLE_CPU_API
+#include "cpu/rope_kv_cache_cpu.h"
+#endif
+
+__C infiniStatus_t infiniopCreateRoPEKVCacheDescriptor(
+    infiniopHandle_t handle,
+    infiniopRoPEKVCacheDescriptor_t *desc_ptr,
+    infiniopTensorDescriptor_t q,
+    infiniopTensorDescriptor_t k,
+    infiniopTensorDescriptor_t v,
+    infiniopTensorDescriptor_t k_cache,
+    infiniopTensorDescriptor_t v_cache,
+    infiniopTensorDescriptor_t pos_ids,
+    infiniopTensorDescriptor_t sin_table,
+    infiniopTensorDescriptor_t cos_table,
+    size_t pos) {
+    return infiniopCreateRoPEKVCacheExDescriptor(
+        handle, desc_ptr, q, k, v, k_cache, v_cache, pos_ids, sin_table, cos_table, pos,
+        0.f, nullptr, INFINIOP_ROPE_ALGO_GPT_J);
+}
+
+__C infiniStatus_t infiniopCreateRoPEKVCacheExDescriptor(
+    infiniopHandle_t handle,
+    infiniopRoPEKVCacheDescriptor_t *desc_ptr,
+    infiniopTensorDescriptor_t q,
+    infiniopTensorDescriptor_t k,
+    infiniopTensorDescriptor_t v,
+    infiniopTensorDescriptor_t k_cache,
+    infiniopTensorDescriptor_t v_cache,
+    infiniopTensorDescriptor_t pos_ids,
+    infiniopTensorDescriptor_t sin_table,
+    infiniopTensorDescriptor_t cos_table,
+    size_t pos,
+    float theta,
+    const infiniopRoPEScaling_t *scaling,
+    infiniopRoPEAlgo_t algo) {
+
+#define CREATE(CASE, NAMESPACE)                                                      \
+    case CASE:                                                                       \
+        return op::rope_kv_cache::NAMESPACE::Descriptor::create(                     \
+            handle,                                                                  \
+            reinterpret_cast<op::rope_kv_cache::NAMESPACE::Descriptor **>(desc_ptr), \
+            q,                                                                       \
+            k,                                                                       \
+            v,                                                                       \
+            k_cache,                                                                 \
+            v_cache,                                                                 \
+            pos_ids,                                                                 \
+            sin_table,                                                               \
+            cos_table,                                                               \
+            pos,                                                                     \
+            theta,                                                                   \
+            scaling,                                                                 \
+            algo)
+
+    switch (handle->device) {
+#ifdef ENABLE_CPU_API
+        CREATE(INFINI_DEVICE_CPU, cpu);
+#endif
+    }
+
+#undef CREATE
+
+    return INFINI_STATUS_DEVICE_TYPE_NOT_SUPPORTED;
+}
+
+__C infiniStatus_t infiniopGetRoPEKVCacheWorkspaceSize(infiniopRoPEKVCacheDescriptor_t desc, size_t *size) {
+
+#define GET(CASE, NAMESPACE)                                                                         \
+    case CASE:                                                                                       \
+        *size = reinterpret_cast<op::rope_kv_cache::NAMESPACE::Descriptor *>(desc)->workspaceSize(); \
+        return INFINI_STATUS_SUCCESS
+
+    switch (desc->device_type) {
+#ifdef ENABLE_CPU_API
+        GET(INFINI_DEVICE_CPU, cpu);
+#endif
+    }
+
+#undef GET
+
+    return INFINI_STATUS_DEVICE_TYPE_NOT_SUPPORTED;
+}
+
+__C infiniStatus_t infiniopRoPEKVCache(
+    infiniopRoPEKVCacheDescriptor_t desc,
+    void *workspace,
+    size_t workspace_size,
+    void *q,
+    const void *k,
+    const void *v,
+    void *k_cache,
+    void *v_cache,
+    const void *pos_ids,
+    const void *sin_table,
+    const void *cos_table,
+    void *stream) {
+
+#define CALCULATE(CASE, NAMESPACE)                                                            \
+    case CASE:                                                                                \
+        return reinterpret_cast<op::rope_kv_cache::NAMESPACE::Descriptor *>(desc)->calculate( \
+            workspace, workspace_size, q, k, v, k_cache, v_cache, pos_ids, sin_table, cos_table, stream)
+
+    switch (desc->device_type) {
+#ifdef ENABLE_CPU_API
+        CALCULATE(INFINI_DEVICE_CPU, cpu);
+#endif
+    }
+
+#undef CALCULATE
+
+    return INFINI_STATUS_DEVICE_TYPE_NOT_SUPPORTED;
+}
+
+__C infiniStatus_t infiniopDestroyRoPEKVCacheDescriptor(infiniopRoPEKVCacheDescriptor_t desc) {
+
+#define DESTROY(CASE, NAMESPACE)                                                   \
+    case CASE:                                                                     \
+        delete reinterpret_cast<op::rope_kv_cache::NAMESPACE::Descriptor *>(desc); \
+        return INFINI_STATUS_SUCCESS
+
+    switch (desc->device_type) {
+#ifdef ENABLE_CPU_API
+        DESTROY(INFINI_DEVICE_CPU, cpu);
+#endif
+    }
+
+#undef DESTROY
+
+    return INFINI_STATUS_DEVICE_TYPE_NOT_SUPPORTED;
+}
@@ -0,0 +1,30 @@
+#include "scatter_cpu.h"
+#include "../../../devices/cpu/common_cpu.h"
+#include "../../gather/cpu/index_copy_cpu.h"
+
+namespace op::scatter::cpu {
+
+Descriptor::~Descriptor() = default;
+
+infiniStatus_t Descriptor::create(
+    infiniopHandle_t handle,
+    Descriptor **desc_ptr,
+    infiniopTensorDescriptor_t y_desc,
+    infiniopTensorDescriptor_t x_desc,
+    infiniopTensorDescriptor_t indices_desc,
+    int axis) {
+    auto result = op::gather::IndexCopyInfo::create(y_desc, x_desc, indices_desc, axis, true);
+    CHECK_RESULT(result);
+    *desc_ptr = new Descriptor(nullptr, result.take(), handle->device, handle->device_id);
+    return INFINI_STATUS_SUCCESS;
+}
+
+infiniStatus_t Descriptor::calculate(
+    void *y,
+    const void *x,
+    const void *indices,
+    void *stream) const {
+    return op::gather::cpu::indexCopy(_info, y, x, indices);
+}
+
+} // namespace op::scatter::cpu
@@ -0,0 +1,8 @@
+#ifndef __SCATTER_CPU_H__
+#define __SCATTER_CPU_H__
+
+#include "../scatter.h"
+
+DESCRIPTOR(cpu)
+
+#endif // __SCATTER_CPU_H__
@@ -0,0 +1,43 @@
+#ifndef __SCATTER_H__
+#define __SCATTER_H__
+
+#include "../../operator.h"
+#include "../gather/info.h"
+
+#define DESCRIPTOR(NAMESPACE)                             \
+                                                          \
+    namespace op::scatter::NAMESPACE {                    \
+    class Descriptor final : public InfiniopDescriptor {  \
+        struct Opaque;                                    \
+        Opaque *_opaque;                                  \
+        op::gather::IndexCopyInfo _info;                  \
+                                                          \
+        Descriptor(                                       \
+            Opaque *opaque,                               \
+            op::gather::IndexCopyInfo info,               \
+            infiniDevice_t device_type,                   \
+            int device_id)                                \
+            : InfiniopDescriptor{device_type, device_id}, \
+              _opaque(opaque),                            \
+              _info(std::move(info)) {}                   \
+                                                          \
+    public:                                               \
+        ~Descriptor();                                    \
+                                                          \
+        static infiniStatus_t create(                     \
+            infiniopHandle_t handle,                      \
+            Descriptor **desc_ptr,                        \
+            infiniopTensorDescriptor_t y_desc,            \
+            infiniopTensorDescriptor_t x_desc,            \
+            infiniopTensorDescriptor_t indices_desc,      \
+            int axis);                                    \
+                                                          \
+        infiniStatus_t calculate(                         \
+            void *y,                                      \
+            const void *x,                                \
+            const void *indices,                          \
+            void *stream) const;                          \
+    };                                                    \
+    }
+
+#endif // __SCATTER_H__
@@ -0,0 +1,193 @@
+#include "softmax_cpu.h"
+#include "../../../devices/cpu/common_cpu.h"
+#include "../../../reduce/cpu/reduce.h"
+
+namespace op::softmax::cpu {
+
+Descriptor::~Descriptor() {}
+
+infiniStatus_t Descriptor::create(
+    infiniopHandle_t handle,
+    Descriptor **desc_ptr,
+    infiniopTensorDescriptor_t y_desc,
+    infiniopTensorDescriptor_t x_desc,
+    infiniopTensorDescriptor_t mask_desc,
+    int axis,
+    float temperature,
+    bool log) {
+    auto result = SoftmaxInfo::create(y_desc, x_desc, mask_desc, axis, temperature, log);
+    CHECK_RESULT(result);
+    *desc_ptr = new Descriptor(nullptr, result.take(), 0, handle->device, handle->device_id);
+    return INFINI_STATUS_SUCCESS;
+}
+
+// 每次转换成 float 参与归约的元素数，保证中间结果留在 L1 中
+constexpr size_t BLOCK_SIZE = 256;
+// 行数不足以占满线程时，长于此值的行在行内切分给各线程
+constexpr size_t MIN_SPLIT_LEN = 16384;
+
+// 一行数据，Tmask 为 void 表示无掩码；CONTIGUOUS 时 axis 维步长为 1，内层循环可以向量化
+template <typename T, typename Tmask, bool CONTIGUOUS>
+struct SoftmaxRow {
+    const SoftmaxInfo &info;
+    T *y;
+    const T *x;
+    const Tmask *mask;
+
+    // 把 [j, j + len) 的 logits 转成 float 写入 buf
+    void load(float *buf, size_t j, size_t len) const {
+        const ptrdiff_t x_stride = CONTIGUOUS ? 1 : info.x_stride_axis;
+        const float inv_temperature = 1.f / info.temperature;
+        for (size_t k = 0; k < len; k++) {
+            buf[k] = op::common_cpu::loadFloat(x[(j + k) * x_stride]) * inv_temperature;
+        }
+        if constexpr (std::is_same<Tmask, bool>::value) {
+            const ptrdiff_t mask_stride = CONTIGUOUS ? 1 : info.mask_stride_axis;
+            for (size_t k = 0; k < len; k++) {
+                buf[k] = mask[(j + k) * mask_stride] ? buf[k] : -std::numeric_limits<float>::infinity();
+            }
+        } else if constexpr (!std::is_void<Tmask>::value) {
+            const ptrdiff_t mask_stride = CONTIGUOUS ? 1 : info.mask_stride_axis;
+            for (size_t k = 0; k < len; k++) {
+                buf[k] += op::common_cpu::loadFloat(mask[(j + k) * mask_stride]);
+            }
+        }
+    }
+
+    op::common_cpu::reduce_op::SoftmaxStat reduce(size_t begin, size_t end) const {
+        float buf[BLOCK_SIZE];
+        op::common_cpu::reduce_op::SoftmaxStat stat;
+        for (size_t j = begin; j < end; j += BLOCK_SIZE) {
+            size_t len = std::min(BLOCK_SIZE, end - j);
+            load(buf, j, len);
+            stat.update(buf, len);
+        }
+        return stat;
+    }
+
+    void normalize(size_t begin, size_t end, const op::common_cpu::reduce_op::SoftmaxStat &stat) const {
+        const ptrdiff_t y_stride = CONTIGUOUS ? 1 : info.y_stride_axis;
+        // 整行都被掩盖
+        if (stat.sum == 0.f) {
+            float val = info.log ? -std::numeric_limits<float>::infinity() : 0.f;
+            for (size_t j = begin; j < end; j++) {
+                y[j * y_stride] = utils::cast<T>(val);
+            }
+            return;
+        }
+
+        float buf[BLOCK_SIZE];
+        const float log_sum = stat.max + std::log(stat.sum),
+                    inv_sum = 1.f / stat.sum;
+        for (size_t j = begin; j < end; j += BLOCK_SIZE) {
+            size_t len = std::min(BLOCK_SIZE, end - j);
+            load(buf, j, len);
+            if (info.log) {
+                for (size_t k = 0; k < len; k++) {
+                    op::common_cpu::storeFloat(y[(j + k) * y_stride], buf[k] - log_sum);
+                }
+            } else {
+                for (size_t k = 0; k < len; k++) {
+                    op::common_cpu::storeFloat(y[(j + k) * y_stride], op::common_cpu::fastExp(buf[k] - stat.max) * inv_sum);
+                }
+            }
+        }
+    }
+};
+
+template <typename T, typename Tmask, bool CONTIGUOUS>
+void softmax(const SoftmaxInfo &info, T *y, const T *x, const Tmask *mask) {
+    const size_t ndim = info.row_shape.size(),
+                 len = info.axis_len;
+    auto row = [&](size_t r) {
+        auto y_ = y + op::common_cpu::indexToOffset(r, ndim, info.row_shape.data(), info.y_row_strides.data());
+        auto x_ = x + op::common_cpu::indexToOffset(r, ndim, info.row_shape.data(), info.x_row_strides.data());
+        const Tmask *mask_ = nullptr;
+        if constexpr (!std::is_void<Tmask>::value) {
+            mask_ = mask + op::common_cpu::indexToOffset(r, ndim, info.row_shape.data(), info.mask_row_strides.data());
+        }
+        return SoftmaxRow<T, Tmask, CONTIGUOUS>{info, y_, x_, mask_};
+    };
+
+    const size_t nthreads = op::common_cpu::maxThreads();
+
+    if (info.n_rows >= nthreads || len < MIN_SPLIT_LEN) {
+        // 按行并行
+#pragma omp parallel for
+        for (ptrdiff_t r = 0; r < ptrdiff_t(info.n_rows); r++) {
+            auto row_ = row(r);
+            row_.normalize(0, len, row_.reduce(0, len));
+        }
+    } else {
+        // 行少而长（如对整个词表求概率），每行切分给各线程，归约结果合并后再归一化
+        const size_t chunk = (len + nthreads - 1) / nthreads;
+        std::vector<op::common_cpu::reduce_op::SoftmaxStat> stats(nthreads);
+        for (size_t r = 0; r < info.n_rows; r++) {
+            auto row_ = row(r);
+#pragma omp parallel for
+            for (ptrdiff_t t = 0; t < ptrdiff_t(nthreads); t++) {
+                stats[t] = row_.reduce(std::min(t * chunk, len), std::min((t + 1) * chunk, len));
+            }
+            op::common_cpu::reduce_op::SoftmaxStat stat;
+            for (const auto &s : stats) {
+                stat.merge(s);
+            }
+#pragma omp parallel for
+            for (ptrdiff_t t = 0; t < ptrdiff_t(nthreads); t++) {
+                row_.normalize(std::min(t * chunk, len), std::min((t + 1) * chunk, len), stat);
+            }
+        }
+    }
+}
+
+template <typename T, typename Tmask>
+infiniStatus_t dispatchStride(const SoftmaxInfo &info, void *y, const void *x, const void *mask) {
+    bool contiguous = info.y_stride_axis == 1
+                   && info.x_stride_axis == 1
+                   && (!info.hasMask() || info.mask_stride_axis == 1);
+    if (contiguous) {
+        softmax<T, Tmask, true>(info, (T *)y, (const T *)x, (const Tmask *)mask);
+    } else {
+        softmax<T, Tmask, false>(info, (T *)y, (const T *)x, (const Tmask *)mask);
+    }
+    return INFINI_STATUS_SUCCESS;
+}
+
+template <typename T>
+infiniStatus_t dispatchMask(const SoftmaxInfo &info, void *y, const void *x, const void *mask) {
+    switch (info.mask_dtype) {
+    case INFINI_DTYPE_INVALID:
+        return dispatchStride<T, void>(info, y, x, mask);
+    case INFINI_DTYPE_BOOL:
+        return dispatchStride<T, bool>(info, y, x, mask);
+    case INFINI_DTYPE_F32:
+        return dispatchStride<T, float>(info, y, x, mask);
+    default:
+        return dispatchStride<T, T>(info, y, x, mask);
+    }
+}
+
+infiniStatus_t Descriptor::calculate(
+    void *workspace, size_t workspace_size,
+    void *y,
+    const void *x,
+    const void *mask,
+    void *stream) const {
+
+    if (_info.hasMask() && mask == nullptr) {
+        return INFINI_STATUS_NULL_POINTER;
+    }
+
+    switch (_info.dtype) {
+    case INFINI_DTYPE_F16:
+        return dispatchMask<fp16_t>(_info, y, x, mask);
+    case INFINI_DTYPE_BF16:
+        return dispatchMask<bf16_t>(_info, y, x, mask);
+    case INFINI_DTYPE_F32:
+        return dispatchMask<float>(_info, y, x, mask);
+    default:
+        return INFINI_STATUS_BAD_TENSOR_DTYPE;
+    }
+}
+
+} // namespace op::softmax::cpu
@@ -0,0 +1,8 @@
+#ifndef __SOFTMAX_CPU_H__
+#define __SOFTMAX_CPU_H__
+
+#include "../softmax.h"
+
+DESCRIPTOR(cpu)
+
+#endif // __SOFTMAX_CPU_H__
@@ -0,0 +1,88 @@
+#ifndef __SOFTMAX_INFO_H__
+#define __SOFTMAX_INFO_H__
+
+#include "../../../utils.h"
+#include "../../tensor.h"
+#include <cmath>
+#include <vector>
+
+namespace op::softmax {
+
+class SoftmaxInfo {
+    SoftmaxInfo() = default;
+
+public:
+    infiniDtype_t dtype;
+    // 掩码类型，INFINI_DTYPE_INVALID 表示无掩码
+    infiniDtype_t mask_dtype;
+    float temperature;
+    bool log;
+
+    // 归一化的维度
+    size_t axis_len;
+    ptrdiff_t y_stride_axis, x_stride_axis, mask_stride_axis;
+
+    // 其余维度构成的“行”，用于计算每行的起始偏移
+    size_t n_rows;
+    std::vector<size_t> row_shape;
+    std::vector<ptrdiff_t> y_row_strides, x_row_strides, mask_row_strides;
+
+    bool hasMask() const { return mask_dtype != INFINI_DTYPE_INVALID; }
+
+    static utils::Result<SoftmaxInfo> create(
+        infiniopTensorDescriptor_t y_desc,
+        infiniopTensorDescriptor_t x_desc,
+        infiniopTensorDescriptor_t mask_desc,
+        int axis,
+        float temperature,
+        bool log) {
+
+        auto dtype = y_desc->dtype();
+        CHECK_OR_RETURN(x_desc->dtype() == dtype, INFINI_STATUS_BAD_TENSOR_DTYPE);
+        CHECK_DTYPE(dtype, INFINI_DTYPE_F16, INFINI_DTYPE_BF16, INFINI_DTYPE_F32);
+        CHECK_SAME_SHAPE(y_desc->shape(), x_desc->shape());
+        CHECK_OR_RETURN(std::isfinite(temperature) && temperature > 0.f, INFINI_STATUS_BAD_PARAM);
+
+        auto ndim = ptrdiff_t(x_desc->ndim());
+        CHECK_OR_RETURN(ndim > 0, INFINI_STATUS_BAD_TENSOR_SHAPE);
+        if (axis < 0) {
+            axis += int(ndim);
+        }
+        CHECK_OR_RETURN(axis >= 0 && axis < ndim, INFINI_STATUS_BAD_PARAM);
+
+        auto mask_dtype = INFINI_DTYPE_INVALID;
+        if (mask_desc) {
+            mask_dtype = mask_desc->dtype();
+            CHECK_OR_RETURN(mask_dtype == INFINI_DTYPE_BOOL || mask_dtype == dtype || mask_dtype == INFINI_DTYPE_F32,
+                            INFINI_STATUS_BAD_TENSOR_DTYPE);
+            CHECK_SAME_SHAPE(mask_desc->shape(), x_desc->shape());
+        }
+
+        SoftmaxInfo info;
+        info.dtype = dtype;
+        info.mask_dtype = mask_dtype;
+        info.temperature = temperature;
+        info.log = log;
+        info.axis_len = x_desc->dim(axis);
+        info.y_stride_axis = y_desc->stride(axis);
+        info.x_stride_axis = x_desc->stride(axis);
+        info.mask_stride_axis = mask_desc ? mask_desc->stride(axis) : 0;
+        info.n_rows = 1;
+        for (ptrdiff_t i = 0; i < ndim; ++i) {
+            if (i == axis) {
+                continue;
+            }
+            info.n_rows *= x_desc->dim(i);
+            info.row_shape.push_back(x_desc->dim(i));
+            info.y_row_strides.push_back(y_desc->stride(i));
+            info.x_row_strides.push_back(x_desc->stride(i));
+            info.mask_row_strides.push_back(mask_desc ? mask_desc->stride(i) : 0);
+        }
+
+        return utils::Result<SoftmaxInfo>(std::move(info));
+    }
+};
+
+} // namespace op::softmax
+
+#endif // __SOFTMAX_INFO_H__
@@ -1,16 +1,99 @@
 #ifndef __INFINIOP_REDUCE_CPU_H__
 #define __INFINIOP_REDUCE_CPU_H__
 #include "../../../utils.h"
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <cstring>
 
 #ifdef ENABLE_OMP
 #include <omp.h>
 #endif
 
+#include <limits>
 #include <type_traits>
 
 namespace op::common_cpu {
 
+// expf 的快速近似（Cephes 多项式），相对误差约 2e-7，不含查表和分支，可被编译器向量化。
+// 小于 -87.3 的输入（包括 -inf）返回 0，NaN 原样返回。
+inline float fastExp(float x) {
+    constexpr float
+        LOG2E = 1.44269504088896341f,
+        LN2_HI = 0.693359375f,
+        LN2_LO = -2.12194440e-4f,
+        ROUND = 12582912.f; // 1.5 * 2^23，加减后得到就近取整的结果
+    // 输入范围 [-87.3365448, 88.3762626] 的位模式
+    constexpr uint32_t
+        MIN_X = 0xc2aeac50u,
+        MAX_X = 0x42b0c0a5u;
+
+    // 钳位和特殊值都在整数上用掩码处理：浮点比较在默认的 -ftrapping-math 下会被编译成分支，循环不能向量化。
+    // 负数的位模式越大值越小，正数按有符号整数比较；NaN 也被钳位，保证后面转换成整数是有定义的
+    uint32_t x_bits;
+    std::memcpy(&x_bits, &x, sizeof(x_bits));
+    const uint32_t
+        under = -uint32_t(x_bits > MIN_X),
+        over = -uint32_t(int32_t(x_bits) > int32_t(MAX_X)),
+        nan = -uint32_t((x_bits & 0x7fffffffu) > 0x7f800000u),
+        clamped = (x_bits & ~(under | over)) | (MIN_X & under) | (MAX_X & over);
+    float x_;
+    std::memcpy(&x_, &clamped, sizeof(x_));
+
+    float n = (x_ * LOG2E + ROUND) - ROUND;
+    float r = x_ - n * LN2_HI - n * LN2_LO;
+
+    float p = 1.9875691500e-4f;
+    p = p * r + 1.3981999507e-3f;
+    p = p * r + 8.3334519073e-3f;
+    p = p * r + 4.1665795894e-2f;
+    p = p * r + 1.6666665459e-1f;
+    p = p * r + 5.0000001201e-1f;
+    p = p * r * r + r + 1.f;
+
+    // 2^n
+    int32_t bits = (int32_t(n) + 127) << 23;
+    float pow2n;
+    std::memcpy(&pow2n, &bits, sizeof(float));
+
+    float y = p * pow2n;
+    uint32_t y_bits;
+    std::memcpy(&y_bits, &y, sizeof(y_bits));
+    y_bits = (y_bits & ~(under | nan)) | (x_bits & nan);
+    std::memcpy(&y, &y_bits, sizeof(y));
+    return y;
+}
+
+// 同时求 sin(x) 和 cos(x)：在 double 下把 x 约减到 [-pi/4, pi/4]，再用 Cephes 的 float 多项式求值，
+// 绝对误差约 1e-7。x 可以很大（如位置 * 频率），约减不损失精度；象限选择不含分支，可被编译器向量化。
+inline void fastSinCos(double x, float &sin_x, float &cos_x) {
+    constexpr double
+        TWO_OVER_PI = 0.63661977236758134308,
+        PI_OVER_2_HI = 1.57079632673412561417, // pi/2 的高 33 位，与整数相乘没有舍入误差
+        PI_OVER_2_LO = 6.07710050650619224932e-11;
+
+    double k = std::floor(x * TWO_OVER_PI + 0.5);
+    float r = float((x - k * PI_OVER_2_HI) - k * PI_OVER_2_LO);
+    float r2 = r * r;
+
+    float s = -1.9515295891e-4f;
+    s = s * r2 + 8.3321608736e-3f;
+    s = s * r2 - 1.6666654611e-1f;
+    s = s * r2 * r + r;
+
+    float c = 2.443315711809948e-5f;
+    c = c * r2 - 1.388731625493765e-3f;
+    c = c * r2 + 4.166664568298827e-2f;
+    c = c * r2 * r2 - 0.5f * r2 + 1.f;
+
+    // 按象限交换并取反
+    int64_t q = int64_t(k);
+    float sin_ = (q & 1) ? c : s,
+          cos_ = (q & 1) ? s : c;
+    sin_x = (q & 2) ? -sin_ : sin_;
+    cos_x = ((q + 1) & 2) ? -cos_ : cos_;
+}
+
 namespace reduce_op {
 
 template <typename T>
@@ -66,6 +149,95 @@ T sumSquared(const T *data, size_t len, ptrdiff_t stride = 1) {
 float sumSquared(const fp16_t *data, size_t len, ptrdiff_t stride = 1);
 float sumSquared(const bf16_t *data, size_t len, ptrdiff_t stride = 1);
 
+// 在线 softmax 的归约状态：已见元素的最大值，以及以该最大值为基准的指数和
+struct SoftmaxStat {
+    float max = -std::numeric_limits<float>::infinity();
+    float sum = 0.f;
+
+    // 合并一段连续数据，只需读一遍数据
+    void update(const float *data, size_t len) {
+        float block_max = max;
+        for (size_t i = 0; i < len; i++) {
+            block_max = std::max(block_max, data[i]);
+        }
+        if (block_max == -std::numeric_limits<float>::infinity()) {
+            return;
+        }
+        if (block_max > max) {
+            // 之前没有有效元素（max 为 -inf）时 sum 为 0，不做缩放
+            sum = max == -std::numeric_limits<float>::infinity() ? 0.f : sum * fastExp(max - block_max);
+            max = block_max;
+        }
+        float block_sum = 0.f;
+        for (size_t i = 0; i < len; i++) {
+            block_sum += fastExp(data[i] - max);
+        }
+        sum += block_sum;
+    }
+
+    // 合并另一段数据的归约结果
+    void merge(const SoftmaxStat &other) {
+        if (other.max == -std::numeric_limits<float>::infinity()) {
+            return;
+        }
+        if (max == -std::numeric_limits<float>::infinity()) {
+            *this = other;
+        } else if (other.max > max) {
+            sum = sum * fastExp(max - other.max) + other.sum;
+            max = other.max;
+        } else {
+            sum += other.sum * fastExp(other.max - max);
+        }
+    }
+};
+
+// Welford 算法的归约状态：元素数、均值以及离差平方和，一遍读数据得到均值和方差
+template <typename T>
+struct MeanVarStat {
+    static constexpr size_t LANES = 8;
+
+    T n = 0;
+    T mean = 0;
+    T m2 = 0;
+
+    T variance() const { return n > 0 ? m2 / n : T(0); }
+
+    // 合并一段连续数据；各条通道独立地做 Welford 更新，使内层循环可以向量化
+    void update(const T *data, size_t len) {
+        T lane_mean[LANES] = {}, lane_m2[LANES] = {}, lane_n = 0;
+        size_t i = 0;
+        for (; i + LANES <= len; i += LANES) {
+            lane_n += 1;
+            T inv_n = T(1) / lane_n;
+            for (size_t l = 0; l < LANES; l++) {
+                T delta = data[i + l] - lane_mean[l];
+                lane_mean[l] += delta * inv_n;
+                lane_m2[l] += delta * (data[i + l] - lane_mean[l]);
+            }
+        }
+        if (lane_n > 0) {
+            for (size_t l = 0; l < LANES; l++) {
+                merge({lane_n, lane_mean[l], lane_m2[l]});
+            }
+        }
+        for (; i < len; i++) {
+            merge({T(1), data[i], T(0)});
+        }
+    }
+
+    // 合并另一段数据的归约结果（Chan 等人的并行公式）
+    void merge(const MeanVarStat &other) {
+        if (other.n == 0) {
+            return;
+        }
+        T total = n + other.n,
+          delta = other.mean - mean;
+        mean += delta * other.n / total;
+        m2 += other.m2 + delta * delta * n * other.n / total;
+        n = total;
+    }
+};
+
 } // namespace reduce_op
 
 } // namespace op::common_cpu
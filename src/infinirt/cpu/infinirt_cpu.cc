@@ -1,4 +1,5 @@
 #include "infinirt_cpu.h"
+#include "../../utils/stream_copy.h"
 #include <cstdlib>
 #include <cstring>
 
@@ -72,7 +73,13 @@ infiniStatus_t freeHost(void *ptr) {
 }
 
 infiniStatus_t memcpy(void *dst, const void *src, size_t size, infinirtMemcpyKind_t kind) {
-    std::memcpy(dst, src, size);
+    // 大块拷贝的目标短期内不会被再次读取，绕过缓存写入，避免挤出其他热数据
+    if (size >= utils::streamingThreshold()) {
+        utils::streamCopy(dst, src, size);
+        utils::streamFence();
+    } else {
+        std::memcpy(dst, src, size);
+    }
     return INFINI_STATUS_SUCCESS;
 }
 
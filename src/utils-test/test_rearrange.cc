@@ -1,4 +1,5 @@
 #include "utils_test.h"
+#include <cstdint>
 #include <cstring>
 #include <iostream>
 #include <numeric>
@@ -45,16 +46,21 @@ size_t check_equal(
     return fails;
 }
 
+template <typename T = float>
 int test_transpose_any(size_t index, std::vector<size_t> shape, std::vector<ptrdiff_t> strides_a, std::vector<ptrdiff_t> strides_b) {
     auto numel = std::accumulate(shape.begin(), shape.end(), (size_t)1, std::multiplies<size_t>());
-    std::vector<float> a(numel);
-    std::vector<float> b(numel);
+    std::vector<T> a(numel);
+    std::vector<T> b(numel);
     for (size_t i = 0; i < numel; i++) {
-        a[i] = (float)i / numel;
+        if constexpr (std::is_floating_point<T>::value) {
+            a[i] = (T)i / numel;
+        } else {
+            a[i] = (T)i;
+        }
     }
 
-    utils::rearrange(b.data(), a.data(), shape.data(), strides_b.data(), strides_a.data(), shape.size(), sizeof(float));
-    auto fails = check_equal<float>(a.data(), b.data(), shape, strides_a, strides_b);
+    utils::rearrange(b.data(), a.data(), shape.data(), strides_b.data(), strides_a.data(), shape.size(), sizeof(T));
+    auto fails = check_equal<T>(a.data(), b.data(), shape, strides_a, strides_b);
     if (fails > 0) {
         std::cout << "test_transpose " << index << " failed" << std::endl;
         return 1;
@@ -68,5 +74,14 @@ int test_rearrange() {
     return test_transpose_any(1, {3, 5}, {5, 1}, {1, 3})
          + test_transpose_any(2, {1, 2048}, {2048, 1}, {2048, 1})
          + test_transpose_any(3, {2, 2, 2, 4}, {16, 8, 1, 2}, {16, 8, 4, 1})
-         + test_transpose_any(4, {2, 2, 2, 2, 4}, {32, 16, 8, 1, 2}, {32, 16, 8, 4, 1});
+         + test_transpose_any(4, {2, 2, 2, 2, 4}, {32, 16, 8, 1, 2}, {32, 16, 8, 4, 1})
+         // 分块转置，包括不满一块的边缘
+         + test_transpose_any(5, {33, 70}, {70, 1}, {1, 33})
+         + test_transpose_any<uint16_t>(6, {4, 17, 40}, {680, 40, 1}, {17, 1, 68})
+         + test_transpose_any<uint8_t>(7, {35, 3, 48}, {144, 48, 1}, {1, 35 * 48, 35})
+         + test_transpose_any<double>(8, {16, 3, 9}, {27, 9, 1}, {1, 144, 16})
+         // 按字节切分给多线程，切分点落在 unit 中间
+         + test_transpose_any(9, {1024, 1024}, {1024, 1}, {1024, 1})
+         + test_transpose_any(10, {3, 5, 4096}, {5 * 4096, 4096, 1}, {4096, 3 * 4096, 1})
+         + test_transpose_any(11, {40, 30, 50}, {30 * 50, 50, 1}, {50, 40 * 50, 1});
 }
@@ -3,6 +3,7 @@
 
 #include "utils/custom_types.h"
 #include "utils/rearrange.h"
+#include "utils/stream_copy.h"
 
 inline size_t infiniSizeOf(infiniDtype_t dtype) {
     switch (dtype) {
@@ -1,4 +1,5 @@
 #include "custom_types.h"
+#include <cmath>
 #include <cstdint>
 #include <cstring>
 
@@ -83,3 +84,56 @@ bf16_t _f32_to_bf16(float val) {
 
     return bf16_t{bf16_bits};
 }
+
+float _f8_to_f32(fp8_t val) {
+    uint32_t sign = static_cast<uint32_t>(val._v & 0x80) << 24;
+    uint32_t exponent = (val._v >> 3) & 0xF;
+    uint32_t mantissa = val._v & 0x7;
+
+    float out;
+    if (exponent == 0xF && mantissa == 0x7) {
+        // e4m3fn 只有 NaN，没有 Inf
+        uint32_t bits32 = sign | 0x7FC00000;
+        std::memcpy(&out, &bits32, sizeof(out));
+    } else if (exponent == 0) {
+        // 非规格化数：mantissa * 2^-9
+        out = static_cast<float>(mantissa) * (1.f / 512.f);
+        if (sign) {
+            out = -out;
+        }
+    } else {
+        uint32_t bits32 = sign | ((exponent + 127 - 7) << 23) | (mantissa << 20);
+        std::memcpy(&out, &bits32, sizeof(out));
+    }
+    return out;
+}
+
+fp8_t _f32_to_f8(float val) {
+    uint32_t bits32;
+    std::memcpy(&bits32, &val, sizeof(bits32));
+    uint8_t sign = static_cast<uint8_t>((bits32 >> 24) & 0x80);
+    bits32 &= 0x7FFFFFFF;
+
+    // NaN
+    if (bits32 > 0x7F800000) {
+        return fp8_t{static_cast<uint8_t>(sign | 0x7F)};
+    }
+    // 超出表示范围时饱和到最大有限值 448（含 Inf）
+    if (bits32 >= 0x43E00000) {
+        return fp8_t{static_cast<uint8_t>(sign | 0x7E)};
+    }
+    // 小于最小规格化数 2^-6 时按非规格化数舍入，舍入到 8 时恰好得到最小规格化数
+    if (bits32 < 0x3C800000) {
+        float abs_val;
+        std::memcpy(&abs_val, &bits32, sizeof(abs_val));
+        auto mantissa = static_cast<uint8_t>(std::nearbyint(abs_val * 512.f));
+        return fp8_t{static_cast<uint8_t>(sign | mantissa)};
+    }
+    // 规格化数：保留 3 位尾数并舍入到最近偶数，进位可能溢出到最大值以上
+    const uint32_t rounding_bias = 0x0007FFFF + ((bits32 >> 20) & 1);
+    uint32_t f8_bits = ((bits32 + rounding_bias) >> 20) - ((127 - 7) << 3);
+    if (f8_bits > 0x7E) {
+        f8_bits = 0x7E;
+    }
+    return fp8_t{static_cast<uint8_t>(sign | f8_bits)};
+}
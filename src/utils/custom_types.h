@@ -13,12 +13,21 @@ struct CustomBFloat16 {
 };
 typedef struct CustomBFloat16 bf16_t;
 
+// FP8 E4M3 (OCP "e4m3fn": no infinities, max finite value 448)
+struct CustomFloat8 {
+    uint8_t _v;
+};
+typedef struct CustomFloat8 fp8_t;
+
 float _f16_to_f32(fp16_t val);
 fp16_t _f32_to_f16(float val);
 
 float _bf16_to_f32(bf16_t val);
 bf16_t _f32_to_bf16(float val);
 
+float _f8_to_f32(fp8_t val);
+fp8_t _f32_to_f8(float val);
+
 namespace utils {
 // General template for non-fp16_t conversions
 template <typename TypeTo, typename TypeFrom>
@@ -41,6 +50,14 @@ TypeTo cast(TypeFrom val) {
         return _bf16_to_f32(val);
     } else if constexpr (std::is_same<TypeFrom, bf16_t>::value && !std::is_same<TypeTo, float>::value) {
         return static_cast<TypeTo>(_bf16_to_f32(val));
+    } else if constexpr (std::is_same<TypeTo, fp8_t>::value && std::is_same<TypeFrom, float>::value) {
+        return _f32_to_f8(val);
+    } else if constexpr (std::is_same<TypeTo, fp8_t>::value && !std::is_same<TypeFrom, float>::value) {
+        return _f32_to_f8(static_cast<float>(val));
+    } else if constexpr (std::is_same<TypeFrom, fp8_t>::value && std::is_same<TypeTo, float>::value) {
+        return _f8_to_f32(val);
+    } else if constexpr (std::is_same<TypeFrom, fp8_t>::value && !std::is_same<TypeTo, float>::value) {
+        return static_cast<TypeTo>(_f8_to_f32(val));
     } else {
         return static_cast<TypeTo>(val);
     }
@@ -1,6 +1,8 @@
 #include "rearrange.h"
 #include "check.h"
+#include "stream_copy.h"
 #include <algorithm>
+#include <cstdint>
 #include <cstring>
 #include <vector>
 
@@ -97,33 +99,184 @@ const ptrdiff_t *RearrangeMeta::idx_strides() const { return _meta.data() + 2; }
 const ptrdiff_t *RearrangeMeta::dst_strides() const { return idx_strides() + ndim(); }
 const ptrdiff_t *RearrangeMeta::src_strides() const { return dst_strides() + ndim(); }
 
-void RearrangeMeta::launch(void *dst_, const void *src_) const {
-    auto const ndim_ = ndim();
-    auto const count_ = count();
-    auto const unit_ = unit();
-    auto const idx_strides_ = idx_strides();
-    auto const dst_strides_ = dst_strides();
-    auto const src_strides_ = src_strides();
-    // 执行 rearrange
-    if (count_ == 1) {
-        std::memcpy(dst_, src_, unit_);
+// 转置一块：dst 的第 ib 行第 ia 列 = src 的第 ia 行第 ib 列。
+// 整块时把 src 的 N 行读进局部缓冲，在缓冲中转置后逐行写出，读写都是连续的
+template <class T, size_t N>
+static void transposeTile(
+    char *dst, const char *src,
+    ptrdiff_t dst_stride, ptrdiff_t src_stride,
+    size_t na, size_t nb) {
+
+    if (na == N && nb == N) {
+        T in[N][N], out[N][N];
+        for (size_t ia = 0; ia < N; ++ia) {
+            std::memcpy(in[ia], src + ia * src_stride, sizeof(in[ia]));
+        }
+        for (size_t ib = 0; ib < N; ++ib) {
+            for (size_t ia = 0; ia < N; ++ia) {
+                out[ib][ia] = in[ia][ib];
+            }
+        }
+        for (size_t ib = 0; ib < N; ++ib) {
+            std::memcpy(dst + ib * dst_stride, out[ib], sizeof(out[ib]));
+        }
     } else {
-#pragma omp parallel for
-        for (ptrdiff_t i = 0; i < (ptrdiff_t)count_; ++i) {
-            auto dst = reinterpret_cast<char *>(dst_);
-            auto src = reinterpret_cast<const char *>(src_);
-            auto rem = i;
-            for (size_t j = 0; j < ndim_; ++j) {
-                auto k = rem / idx_strides_[j];
-                dst += k * dst_strides_[j];
-                src += k * src_strides_[j];
-                rem %= idx_strides_[j];
+        for (size_t ia = 0; ia < na; ++ia) {
+            for (size_t ib = 0; ib < nb; ++ib) {
+                std::memcpy(dst + ib * dst_stride + ia * sizeof(T), src + ia * src_stride + ib * sizeof(T), sizeof(T));
             }
-            std::memcpy(dst, src, unit_);
         }
     }
 }
 
+// 二维转置子问题：dst 在 a 维连续，src 在 b 维连续。
+// 其余维度作为外层循环，(a, b) 平面按 N x N 分块，每块在 L1 中完成，避免逐元素的 memcpy 和下标分解
+template <class T, size_t N>
+static bool launchTransposeTiled(const RearrangeMeta &meta, size_t a, size_t b, void *dst_, const void *src_) {
+    auto const ndim = meta.ndim();
+    auto const idx_strides = meta.idx_strides();
+    auto const dst_strides = meta.dst_strides();
+    auto const src_strides = meta.src_strides();
+    auto len = [&](size_t i) {
+        return size_t(i == 0 ? meta.count() : idx_strides[i - 1]) / idx_strides[i];
+    };
+
+    const size_t la = len(a), lb = len(b);
+    if (la < N || lb < N) {
+        return false;
+    }
+
+    std::vector<size_t> rest;
+    for (size_t i = 0; i < ndim; ++i) {
+        if (i != a && i != b) {
+            rest.push_back(i);
+        }
+    }
+    const size_t outer = meta.count() / (la * lb),
+                 strips = (la + N - 1) / N;
+    const ptrdiff_t src_stride = src_strides[a],
+                    dst_stride = dst_strides[b];
+
+#pragma omp parallel for
+    for (ptrdiff_t task = 0; task < ptrdiff_t(outer * strips); ++task) {
+        auto dst = reinterpret_cast<char *>(dst_);
+        auto src = reinterpret_cast<const char *>(src_);
+        size_t rem = task / strips;
+        for (auto it = rest.rbegin(); it != rest.rend(); ++it) {
+            auto l = len(*it);
+            dst += (rem % l) * dst_strides[*it];
+            src += (rem % l) * src_strides[*it];
+            rem /= l;
+        }
+        const size_t ia = task % strips * N,
+                     na = std::min(N, la - ia);
+        for (size_t ib = 0; ib < lb; ib += N) {
+            transposeTile<T, N>(
+                dst + ia * sizeof(T) + ib * dst_stride,
+                src + ia * src_stride + ib * sizeof(T),
+                dst_stride, src_stride,
+                na, std::min(N, lb - ib));
+        }
+    }
+    return true;
+}
+
+// 元素粒度的转置交给分块转置，否则返回 false
+static bool launchTranspose(const RearrangeMeta &meta, void *dst, const void *src) {
+    auto const unit = ptrdiff_t(meta.unit());
+    auto const ndim = meta.ndim();
+    auto const dst_strides = meta.dst_strides();
+    auto const src_strides = meta.src_strides();
+
+    size_t a = ndim, b = ndim;
+    for (size_t i = 0; i < ndim; ++i) {
+        if (dst_strides[i] == unit) {
+            a = i;
+        }
+        if (src_strides[i] == unit) {
+            b = i;
+        }
+    }
+    if (a == ndim || b == ndim || a == b) {
+        return false;
+    }
+
+    switch (unit) {
+    case 1:
+        return launchTransposeTiled<uint8_t, 16>(meta, a, b, dst, src);
+    case 2:
+        return launchTransposeTiled<uint16_t, 16>(meta, a, b, dst, src);
+    case 4:
+        return launchTransposeTiled<uint32_t, 8>(meta, a, b, dst, src);
+    case 8:
+        return launchTransposeTiled<uint64_t, 8>(meta, a, b, dst, src);
+    default:
+        return false;
+    }
+}
+
+// 每个线程至少搬运的字节数，避免小规模的拷贝也启动全部线程
+constexpr size_t MIN_BYTES_PER_THREAD = 1 << 16;
+// 线程间的切分点按缓存行对齐
+constexpr size_t SPLIT_ALIGN = 64;
+
+// 短于一个缓存行的 unit 流式写入无法整行提交，仍走普通拷贝
+constexpr size_t MIN_STREAMING_UNIT = 64;
+
+// 搬运展平后字节区间 [begin, end) 的数据
+static void copyRange(
+    const RearrangeMeta &meta,
+    char *dst, const char *src,
+    size_t begin, size_t end,
+    bool streaming) {
+
+    meta.forEachRange(begin, end, [=](ptrdiff_t dst_offset, ptrdiff_t src_offset, size_t len) {
+        if (streaming) {
+            streamCopy(dst + dst_offset, src + src_offset, len);
+        } else {
+            std::memcpy(dst + dst_offset, src + src_offset, len);
+        }
+    });
+    if (streaming) {
+        streamFence();
+    }
+}
+
+void RearrangeMeta::launch(void *dst, const void *src) const {
+    launch(dst, src, count() * unit() >= streamingThreshold());
+}
+
+void RearrangeMeta::launch(void *dst_, const void *src_, bool streaming) const {
+    auto const dst = reinterpret_cast<char *>(dst_);
+    auto const src = reinterpret_cast<const char *>(src_);
+    auto const total = count() * unit();
+
+    // 元素粒度的转置走分块，分块的写入不足一个缓存行，不使用流式写入
+    if (launchTranspose(*this, dst_, src_)) {
+        return;
+    }
+
+    streaming = streaming && unit() >= MIN_STREAMING_UNIT;
+
+    // 按总字节数而不是 unit 个数切分：unit 少而大（如连续拷贝）时在 unit 内切分，
+    // unit 多而小时每个线程负责一段连续的 unit
+    size_t nthreads = 1;
+#ifdef ENABLE_OMP
+    nthreads = std::min(size_t(omp_get_max_threads()), (total + MIN_BYTES_PER_THREAD - 1) / MIN_BYTES_PER_THREAD);
+#endif
+    if (nthreads <= 1) {
+        copyRange(*this, dst, src, 0, total, streaming);
+        return;
+    }
+    auto split = [&](size_t t) {
+        return t == nthreads ? total : t * total / nthreads / SPLIT_ALIGN * SPLIT_ALIGN;
+    };
+#pragma omp parallel for num_threads(nthreads)
+    for (ptrdiff_t t = 0; t < ptrdiff_t(nthreads); ++t) {
+        copyRange(*this, dst, src, split(t), split(t + 1), streaming);
+    }
+}
+
 void rearrange(
     void *dst,
     const void *src,
@@ -2,6 +2,7 @@
 #define __INFINIUTILS_REARRANGE_H__
 
 #include "result.hpp"
+#include <algorithm>
 #include <cstddef>
 #include <vector>
 
@@ -27,12 +28,58 @@ public:
     const ptrdiff_t *dst_strides() const;
     const ptrdiff_t *src_strides() const;
 
+    // 目标超过 streamingThreshold() 时自动使用流式写入
     void launch(void *dst, const void *src) const;
+    // 显式指定是否使用流式写入
+    void launch(void *dst, const void *src, bool streaming) const;
+
+    // 遍历展平后的区间 [begin, end)（以 create 时的 element_size 计），对其中每段连续的数据调用
+    // f(dst_offset, src_offset, len)。只在起点分解一次多维下标，之后逐 unit 进位递推偏移；区间的首尾可以落在 unit 中间
+    template <class F>
+    void forEachRange(size_t begin, size_t end, F &&f) const;
 
     // 拆分 unit 到更小的规模以利于并行
     utils::Result<RearrangeMeta> distributeUnit(const std::vector<size_t> &candidates) const;
 };
 
+template <class F>
+void RearrangeMeta::forEachRange(size_t begin, size_t end, F &&f) const {
+    auto const ndim_ = ndim();
+    auto const unit_ = unit();
+    auto const idx_strides_ = idx_strides();
+    auto const dst_strides_ = dst_strides();
+    auto const src_strides_ = src_strides();
+
+    std::vector<size_t> idx(ndim_), lens(ndim_);
+    ptrdiff_t dst = 0, src = 0;
+    size_t rem = begin / unit_,
+           offset = begin % unit_;
+    for (size_t j = 0; j < ndim_; ++j) {
+        lens[j] = size_t(j == 0 ? count() : idx_strides_[j - 1]) / idx_strides_[j];
+        idx[j] = rem / idx_strides_[j];
+        dst += idx[j] * dst_strides_[j];
+        src += idx[j] * src_strides_[j];
+        rem %= idx_strides_[j];
+    }
+
+    while (begin < end) {
+        auto n = std::min(unit_ - offset, end - begin);
+        f(dst + ptrdiff_t(offset), src + ptrdiff_t(offset), n);
+        begin += n;
+        offset = 0;
+        for (size_t j = ndim_; j-- > 0;) {
+            dst += dst_strides_[j];
+            src += src_strides_[j];
+            if (++idx[j] < lens[j]) {
+                break;
+            }
+            dst -= lens[j] * dst_strides_[j];
+            src -= lens[j] * src_strides_[j];
+            idx[j] = 0;
+        }
+    }
+}
+
 void rearrange(
     void *dst,
     const void *src,
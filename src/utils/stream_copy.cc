@@ -0,0 +1,65 @@
+#include "stream_copy.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace utils {
+
+// 比一般的末级缓存份额更大的写入才值得绕过缓存
+constexpr size_t DEFAULT_STREAMING_THRESHOLD = size_t(8) << 20;
+// 预取 src 的超前距离
+constexpr size_t PREFETCH_DISTANCE = 512;
+
+size_t streamingThreshold() {
+    static const size_t threshold = [] {
+        auto env = std::getenv("INFINI_STREAMING_THRESHOLD");
+        if (env == nullptr || *env == '\0') {
+            return DEFAULT_STREAMING_THRESHOLD;
+        }
+        char *end;
+        auto val = std::strtoull(env, &end, 10);
+        return *end == '\0' ? size_t(val) : DEFAULT_STREAMING_THRESHOLD;
+    }();
+    return threshold;
+}
+
+void streamCopy(void *dst_, const void *src_, size_t size) {
+#ifdef __SSE2__
+    auto dst = reinterpret_cast<char *>(dst_);
+    auto src = reinterpret_cast<const char *>(src_);
+    // 流式写入要求 dst 按 16 字节对齐，不对齐的头尾走普通拷贝
+    auto head = std::min(size, size_t(-reinterpret_cast<uintptr_t>(dst) & 15));
+    std::memcpy(dst, src, head);
+    dst += head;
+    src += head;
+    size -= head;
+    // 每次写满一个缓存行，让写合并缓冲整行提交
+    for (; size >= 64; size -= 64, dst += 64, src += 64) {
+        _mm_prefetch(src + PREFETCH_DISTANCE, _MM_HINT_NTA);
+        auto a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+        auto b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 16));
+        auto c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 32));
+        auto d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 48));
+        _mm_stream_si128(reinterpret_cast<__m128i *>(dst), a);
+        _mm_stream_si128(reinterpret_cast<__m128i *>(dst + 16), b);
+        _mm_stream_si128(reinterpret_cast<__m128i *>(dst + 32), c);
+        _mm_stream_si128(reinterpret_cast<__m128i *>(dst + 48), d);
+    }
+    std::memcpy(dst, src, size);
+#else
+    std::memcpy(dst_, src_, size);
+#endif
+}
+
+void streamFence() {
+#ifdef __SSE2__
+    _mm_sfence();
+#endif
+}
+
+} // namespace utils
@@ -0,0 +1,20 @@
+#ifndef __INFINIUTILS_STREAM_COPY_H__
+#define __INFINIUTILS_STREAM_COPY_H__
+
+#include <cstddef>
+
+namespace utils {
+
+// 超过此字节数的拷贝默认使用流式写入，可用环境变量 INFINI_STREAMING_THRESHOLD 覆盖
+size_t streamingThreshold();
+
+// 以非临时（绕过缓存）的方式写入 dst，并预取 src；
+// 平台不支持时退化为 memcpy。写入对其他线程可见前需要调用 streamFence
+void streamCopy(void *dst, const void *src, size_t size);
+
+// 保证之前的流式写入全局可见
+void streamFence();
+
+} // namespace utils
+
+#endif // __INFINIUTILS_STREAM_COPY_H__
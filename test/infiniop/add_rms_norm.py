@@ -0,0 +1,175 @@
+import torch
+import ctypes
+from ctypes import c_uint64
+from libinfiniop import (
+    LIBINFINIOP,
+    TestTensor,
+    get_test_devices,
+    check_error,
+    test_operator,
+    get_args,
+    debug,
+    get_tolerance,
+    profile_operation,
+    TestWorkspace,
+    InfiniDtype,
+    InfiniDtypeNames,
+    InfiniDeviceNames,
+    infiniopOperatorDescriptor_t,
+)
+
+# ==============================================================================
+#  Configuration (Internal Use Only)
+# ==============================================================================
+# These are not meant to be imported from other modules
+_TEST_CASES_ = [
+    # shape, stride, inplace
+    ((1, 4), None, False),
+    ((1, 4), None, True),
+    ((16, 2048), None, False),
+    ((16, 2048), None, True),
+    ((16, 2048), (4096, 1), False),
+    ((16, 2048), (4096, 1), True),
+]
+
+# w (weight) types
+# Note: 'None' means the same as input dtype
+_WEIGHT_DTYPES = [None, InfiniDtype.F32]
+# x types used for testing
+_TENSOR_DTYPES = [InfiniDtype.F16, InfiniDtype.BF16, InfiniDtype.F32]
+
+# Form the test cases by appending each element of _WEIGHT_DTYPES to each tuple in _TEST_CASES_
+_TEST_CASES = [
+    test_case + (w_dtype,) for test_case in _TEST_CASES_ for w_dtype in _WEIGHT_DTYPES
+]
+
+# Tolerance map for different data types
+_TOLERANCE_MAP = {
+    InfiniDtype.F16: {"atol": 2e-3, "rtol": 2e-3},
+    InfiniDtype.BF16: {"atol": 8e-3, "rtol": 8e-3},
+    InfiniDtype.F32: {"atol": 1e-5, "rtol": 1e-5},
+}
+
+DEBUG = False
+PROFILE = False
+NUM_PRERUN = 10
+NUM_ITERATIONS = 1000
+
+
+def add_rms_norm(y, residual_out, a, b, w, eps):
+    torch.add(a, b, out=residual_out)
+    x = residual_out.to(torch.float32)
+    rms = torch.rsqrt(torch.mean(x * x, dim=-1, keepdim=True) + eps)
+    y.copy_(x * rms * w.to(torch.float32))
+
+
+def test(
+    handle,
+    device,
+    shape,
+    stride,
+    inplace,
+    w_dtype=InfiniDtype.F32,
+    dtype=InfiniDtype.F16,
+    sync=None,
+):
+    w_dtype = w_dtype if w_dtype else dtype
+    print(
+        f"Testing AddRMSNorm on {InfiniDeviceNames[device]} with shape:{shape} stride:{stride} inplace:{inplace}"
+        f" w_dtype:{InfiniDtypeNames[w_dtype]} dtype:{InfiniDtypeNames[dtype]}"
+    )
+
+    y = TestTensor(shape, stride, dtype, device, mode="ones")
+    a = TestTensor(shape, stride, dtype, device, scale=0.01)
+    b = TestTensor(shape, stride, dtype, device, scale=0.01)
+    residual_out = (
+        a if inplace else TestTensor(shape, stride, dtype, device, mode="zeros")
+    )
+    w = TestTensor(shape[-1:], None, w_dtype, device)
+
+    eps = 1e-6
+    ans_y = torch.empty_like(y.torch_tensor())
+    ans_residual = torch.empty_like(a.torch_tensor())
+    add_rms_norm(
+        ans_y, ans_residual, a.torch_tensor(), b.torch_tensor(), w.torch_tensor(), eps
+    )
+
+    if sync is not None:
+        sync()
+
+    descriptor = infiniopOperatorDescriptor_t()
+
+    check_error(
+        LIBINFINIOP.infiniopCreateAddRMSNormDescriptor(
+            handle,
+            ctypes.byref(descriptor),
+            y.descriptor,
+            residual_out.descriptor,
+            a.descriptor,
+            b.descriptor,
+            w.descriptor,
+            eps,
+        )
+    )
+
+    # Invalidate the shape and strides in the descriptor to prevent them from being directly used by the kernel
+    for tensor in [y, a, b, w] + ([] if inplace else [residual_out]):
+        tensor.destroy_desc()
+
+    workspace_size = c_uint64(0)
+    check_error(
+        LIBINFINIOP.infiniopGetAddRMSNormWorkspaceSize(
+            descriptor, ctypes.byref(workspace_size)
+        )
+    )
+    workspace = TestWorkspace(workspace_size.value, y.device)
+
+    def lib_add_rms_norm():
+        check_error(
+            LIBINFINIOP.infiniopAddRMSNorm(
+                descriptor,
+                workspace.data(),
+                workspace_size.value,
+                y.data(),
+                residual_out.data(),
+                a.data(),
+                b.data(),
+                w.data(),
+                None,
+            )
+        )
+
+    lib_add_rms_norm()
+
+    atol, rtol = get_tolerance(_TOLERANCE_MAP, dtype)
+    if DEBUG:
+        debug(residual_out.actual_tensor(), ans_residual, atol=atol, rtol=rtol)
+        debug(y.actual_tensor(), ans_y, atol=atol, rtol=rtol)
+    assert torch.allclose(
+        residual_out.actual_tensor(), ans_residual, atol=atol, rtol=rtol
+    )
+    assert torch.allclose(y.actual_tensor(), ans_y, atol=atol, rtol=rtol)
+
+    # Profiling workflow
+    if PROFILE:
+        # fmt: off
+        profile_operation("PyTorch", lambda: add_rms_norm(ans_y, ans_residual, a.torch_tensor(), b.torch_tensor(), w.torch_tensor(), eps), device, NUM_PRERUN, NUM_ITERATIONS)
+        profile_operation("    lib", lambda: lib_add_rms_norm(), device, NUM_PRERUN, NUM_ITERATIONS)
+        # fmt: on
+    check_error(LIBINFINIOP.infiniopDestroyAddRMSNormDescriptor(descriptor))
+
+
+if __name__ == "__main__":
+    args = get_args()
+
+    # Configure testing options
+    DEBUG = args.debug
+    PROFILE = args.profile
+    NUM_PRERUN = args.num_prerun
+    NUM_ITERATIONS = args.num_iterations
+
+    # Execute tests
+    for device in get_test_devices(args):
+        test_operator(device, test, _TEST_CASES, _TENSOR_DTYPES)
+
+    print("\033[92mTest passed!\033[0m")
@@ -1,5 +1,6 @@
 import torch
 import ctypes
+import math
 from ctypes import c_uint64
 from libinfiniop import (
     LIBINFINIOP,
@@ -15,6 +16,7 @@ from libinfiniop import (
     InfiniDtype,
     InfiniDtypeNames,
     InfiniDeviceNames,
+    InfiniDeviceEnum,
     infiniopOperatorDescriptor_t,
 )
 from enum import Enum, auto
@@ -34,6 +36,16 @@ _TEST_CASES_ = [
     ((28, 15, 15), None, None),
 ]
 
+_MASKED_TEST_CASES = [
+    # shape, scale, window, alibi_max_bias, with_bias
+    ((32, 20, 512), 1.0, 64, 0.0, False),
+    ((32, 20, 512), 1.0, 0, 8.0, False),
+    ((12, 5, 30), 1.0, 8, 8.0, True),
+    ((20, 20), 1.0, 4, 0.0, True),
+    ((32, 20, 512), 0.125, 0, 0.0, False),
+    ((4, 3, 1000), 0.125, 0, 0.0, True),
+]
+
 # Data types used for testing
 _TENSOR_DTYPES = [InfiniDtype.F16, InfiniDtype.BF16, InfiniDtype.F32]
 
@@ -74,6 +86,40 @@ def causal_softmax(x):
     return torch.nn.functional.softmax(masked, dim=-1, dtype=type)
 
 
+def alibi_slopes(n_head, max_bias):
+    n_floor = 2 ** math.floor(math.log2(n_head))
+    m0 = 2.0 ** (-max_bias / n_floor)
+    m1 = 2.0 ** (-max_bias / 2 / n_floor)
+    return torch.tensor(
+        [
+            m0 ** (h + 1) if h < n_floor else m1 ** (2 * (h - n_floor) + 1)
+            for h in range(n_head)
+        ]
+    )
+
+
+def masked_causal_softmax(x, scale, window, alibi_max_bias, bias):
+    type = x.dtype
+    seq_len, total_seq_len = x.shape[-2:]
+    pos = torch.arange(total_seq_len - seq_len, total_seq_len, device=x.device)
+    pos = pos.unsqueeze(-1)
+    j = torch.arange(total_seq_len, device=x.device).unsqueeze(0)
+    visible = j <= pos
+    if window > 0:
+        visible &= j > pos - window
+    logits = x.to(torch.float32) * scale
+    if bias is not None:
+        logits = logits + bias.to(torch.float32)
+    if alibi_max_bias > 0:
+        n_head = x.shape[0] if x.ndim == 3 else 1
+        slopes = alibi_slopes(n_head, alibi_max_bias).to(x.device)
+        logits = logits + (slopes.view(-1, 1, 1) * (j - pos)).reshape(
+            *x.shape[:-2], seq_len, total_seq_len
+        )
+    logits = logits.masked_fill(~visible, -torch.inf)
+    return torch.nn.functional.softmax(logits, dim=-1).to(type)
+
+
 def test(
     handle,
     device,
@@ -150,6 +196,84 @@ def test(
     check_error(LIBINFINIOP.infiniopDestroyCausalSoftmaxDescriptor(descriptor))
 
 
+def test_masked(
+    handle,
+    device,
+    shape,
+    scale,
+    window,
+    alibi_max_bias,
+    with_bias,
+    dtype=InfiniDtype.F16,
+    sync=None,
+):
+    print(
+        f"Testing CausalSoftmaxEx on {InfiniDeviceNames[device]} with shape:{shape} scale:{scale} window:{window} alibi_max_bias:{alibi_max_bias} with_bias:{with_bias} dtype:{InfiniDtypeNames[dtype]}"
+    )
+
+    x = TestTensor(shape, None, dtype, device)
+    y = TestTensor(shape, None, dtype, device)
+    bias = TestTensor(shape[-2:], None, dtype, device) if with_bias else None
+    ans = masked_causal_softmax(
+        x.torch_tensor(),
+        scale,
+        window,
+        alibi_max_bias,
+        bias.torch_tensor() if with_bias else None,
+    )
+
+    if sync is not None:
+        sync()
+
+    descriptor = infiniopOperatorDescriptor_t()
+    check_error(
+        LIBINFINIOP.infiniopCreateCausalSoftmaxExDescriptor(
+            handle,
+            ctypes.byref(descriptor),
+            y.descriptor,
+            x.descriptor,
+            bias.descriptor if with_bias else None,
+            scale,
+            window,
+            alibi_max_bias,
+        )
+    )
+
+    # Invalidate the shape and strides in the descriptor to prevent them from being directly used by the kernel
+    for tensor in [x, y] + ([bias] if with_bias else []):
+        tensor.destroy_desc()
+
+    workspace_size = c_uint64(0)
+    check_error(
+        LIBINFINIOP.infiniopGetCausalSoftmaxWorkspaceSize(
+            descriptor, ctypes.byref(workspace_size)
+        )
+    )
+    workspace = TestWorkspace(workspace_size.value, x.device)
+
+    check_error(
+        LIBINFINIOP.infiniopCausalSoftmaxEx(
+            descriptor,
+            workspace.data(),
+            workspace_size.value,
+            y.data(),
+            x.data(),
+            bias.data() if with_bias else None,
+            None,
+        )
+    )
+
+    if sync is not None:
+        sync()
+
+    atol, rtol = get_tolerance(_TOLERANCE_MAP, dtype)
+    if DEBUG:
+        debug(y.actual_tensor(), ans, atol=atol, rtol=rtol)
+    assert torch.allclose(y.actual_tensor(), ans, atol=atol, rtol=rtol)
+
+    check_error(LIBINFINIOP.infiniopDestroyCausalSoftmaxDescriptor(descriptor))
+
+
 if __name__ == "__main__":
     args = get_args()
 
@@ -161,5 +285,8 @@ if __name__ == "__main__":
 
     for device in get_test_devices(args):
         test_operator(device, test, _TEST_CASES, _TENSOR_DTYPES)
+        # 滑动窗口与偏置掩码目前只有 CPU 实现
+        if device == InfiniDeviceEnum.CPU:
+            test_operator(device, test_masked, _MASKED_TEST_CASES, _TENSOR_DTYPES)
 
     print("\033[92mTest passed!\033[0m")
@@ -17,6 +17,9 @@ from libinfiniop import (
     InfiniDtypeNames,
     InfiniDeviceNames,
     infiniopOperatorDescriptor_t,
+    ConvWeightHint,
+    ConvActivation,
+    InfiniStatus,
 )
 from enum import Enum, auto
 from typing import List, Tuple
@@ -30,7 +33,7 @@ PROFILE = False
 NUM_PRERUN = 10
 NUM_ITERATIONS = 1000
 _TEST_CASES = [
-    # x_shape, x_stride, w_shape, w_stride, pads, strides, dilations, x_strides
+    # x_shape, x_stride, w_shape, w_stride, pads, strides, dilations, groups
     (
         (32, 3, 4),
         (12, 4, 1),
@@ -39,6 +42,7 @@ _TEST_CASES = [
         (1,),
         (1,),
         (1,),
+        1,
     ),
     (
         (1, 3, 4, 4),
@@ -48,6 +52,7 @@ _TEST_CASES = [
         (1, 1),
         (1, 2),
         (2, 1),
+        1,
     ),
     (
         (32, 3, 32, 32),
@@ -57,6 +62,7 @@ _TEST_CASES = [
         (2, 2),
         (2, 2),
         (1, 1),
+        1,
     ),
     (
         (1, 1, 4, 4, 4),
@@ -66,6 +72,7 @@ _TEST_CASES = [
         (1, 1, 1),
         (1, 1, 1),
         (1, 1, 1),
+        1,
     ),
     (
         (32, 3, 32, 32, 32),
@@ -75,6 +82,106 @@ _TEST_CASES = [
         (3, 2, 2),
         (4, 3, 3),
         (2, 2, 1),
+        1,
+    ),
+    # Winograd F(4x4, 3x3), channel and tile counts not multiples of the block size
+    (
+        (2, 16, 14, 14),
+        (16 * 14 * 14, 14 * 14, 14, 1),
+        (33, 16, 3, 3),
+        (144, 9, 3, 1),
+        (1, 1),
+        (1, 1),
+        (1, 1),
+        1,
+    ),
+    # Winograd F(2x2, 3x3)
+    (
+        (1, 16, 4, 30),
+        (16 * 4 * 30, 4 * 30, 30, 1),
+        (16, 16, 3, 3),
+        (144, 9, 3, 1),
+        (0, 0),
+        (1, 1),
+        (1, 1),
+        1,
+    ),
+    # im2col + GEMM
+    (
+        (1, 64, 7, 9),
+        (64 * 7 * 9, 7 * 9, 9, 1),
+        (30, 64, 1, 1),
+        (64, 1, 1, 1),
+        (0, 0),
+        (1, 1),
+        (1, 1),
+        1,
+    ),
+    # Grouped convolution
+    (
+        (2, 16, 9, 11),
+        (16 * 9 * 11, 9 * 11, 11, 1),
+        (32, 4, 3, 3),
+        (36, 9, 3, 1),
+        (1, 1),
+        (1, 1),
+        (1, 1),
+        4,
+    ),
+    # Depthwise convolution
+    (
+        (2, 24, 13, 15),
+        (24 * 13 * 15, 13 * 15, 15, 1),
+        (24, 1, 3, 3),
+        (9, 9, 3, 1),
+        (1, 1),
+        (1, 1),
+        (1, 1),
+        24,
+    ),
+    # 1-D depthwise convolution, as in Mamba-style models
+    (
+        (2, 70, 100),
+        (70 * 100, 100, 1),
+        (70, 1, 4),
+        (4, 4, 1),
+        (3,),
+        (1,),
+        (1,),
+        70,
+    ),
+    # Channels-last (NHWC) input and output
+    (
+        (2, 16, 9, 11),
+        (9 * 11 * 16, 1, 11 * 16, 16),
+        (33, 16, 3, 3),
+        (144, 9, 3, 1),
+        (1, 1),
+        (2, 1),
+        (1, 1),
+        1,
+    ),
+    # Channels-last depthwise convolution
+    (
+        (2, 130, 13, 15),
+        (13 * 15 * 130, 1, 15 * 130, 130),
+        (130, 1, 5, 5),
+        (25, 25, 5, 1),
+        (2, 2),
+        (1, 1),
+        (1, 1),
+        130,
+    ),
+    # Padding wider than the kernel, so some windows fall entirely outside the input
+    (
+        (2, 8, 5, 6),
+        (8 * 5 * 6, 5 * 6, 6, 1),
+        (16, 8, 3, 3),
+        (72, 9, 3, 1),
+        (4, 3),
+        (2, 1),
+        (1, 2),
+        1,
     ),
 ]
 
@@ -95,24 +202,42 @@ NUM_PRERUN = 10
 NUM_ITERATIONS = 1000
 
 
-def conv(x, w, stride, padding, dilation, y_tensor, bias=None):
+def conv(x, w, stride, padding, dilation, groups, y_tensor, bias=None):
     match len(x.shape) - 2:
         case 1:
             y_tensor.copy_(
                 F.conv1d(
-                    x, w, bias=bias, stride=stride, padding=padding, dilation=dilation
+                    x,
+                    w,
+                    bias=bias,
+                    stride=stride,
+                    padding=padding,
+                    dilation=dilation,
+                    groups=groups,
                 )
             )
         case 2:
             y_tensor.copy_(
                 F.conv2d(
-                    x, w, bias=bias, stride=stride, padding=padding, dilation=dilation
+                    x,
+                    w,
+                    bias=bias,
+                    stride=stride,
+                    padding=padding,
+                    dilation=dilation,
+                    groups=groups,
                 )
             )
         case 3:
             y_tensor.copy_(
                 F.conv3d(
-                    x, w, bias=bias, stride=stride, padding=padding, dilation=dilation
+                    x,
+                    w,
+                    bias=bias,
+                    stride=stride,
+                    padding=padding,
+                    dilation=dilation,
+                    groups=groups,
                 )
             )
         case _:
@@ -126,6 +251,7 @@ def inferShapeStride(
     pads: List[int],
     strides: List[int],
     dilations: List[int],
+    channels_last: bool = False,
 ) -> Tuple[Tuple[int, ...], Tuple[int, ...]]:
     assert (
         len(x_shape)
@@ -143,9 +269,17 @@ def inferShapeStride(
         for i in range(len(pads))
     ]
     output_shape = (x_shape[0], w_shape[0]) + tuple(output_dims)
-    output_strides = [1]
-    for s in reversed(output_shape[1:]):
-        output_strides.insert(0, output_strides[0] * s)
+    # Lay the output out in the same order as the input: channels first or last
+    order = (
+        [0] + list(range(2, len(output_shape))) + [1]
+        if channels_last
+        else range(len(output_shape))
+    )
+    output_strides = [0] * len(output_shape)
+    stride = 1
+    for i in reversed(order):
+        output_strides[i] = stride
+        stride *= output_shape[i]
     output_strides = tuple(output_strides)
     return output_shape, output_strides
 
@@ -167,13 +301,17 @@ def test(
     pads,
     strides,
     dilations,
+    groups,
     tensor_dtype=InfiniDtype.F16,
     sync=None,
 ):
     assert len(pads) == len(strides) == len(dilations)
     x = TestTensor(x_shape, x_stride, dt=tensor_dtype, device=device, scale=0.01)
     w = TestTensor(w_shape, w_stride, dt=tensor_dtype, device=device, scale=0.01)
-    y_shape, y_stride = inferShapeStride(x_shape, w_shape, pads, strides, dilations)
+    channels_last = x_stride[1] == 1 and x_stride[-1] == x_shape[1]
+    y_shape, y_stride = inferShapeStride(
+        x_shape, w_shape, pads, strides, dilations, channels_last
+    )
     y = TestTensor(y_shape, y_stride, dt=tensor_dtype, device=device)
 
     b = (
@@ -182,7 +320,7 @@ def test(
         else None
     )
     print(
-        f"Testing Conv on {InfiniDeviceNames[device]} with x_shape: {x_shape}, w_shape: {w_shape}, b_shape: {w_shape[0]}, pads: {pads}, strides: {strides}, dilations: {dilations}, x_stride: {x_stride} dtype:{InfiniDtypeNames[tensor_dtype]}"
+        f"Testing Conv on {InfiniDeviceNames[device]} with x_shape: {x_shape}, w_shape: {w_shape}, b_shape: {w_shape[0]}, pads: {pads}, strides: {strides}, dilations: {dilations}, groups: {groups}, x_stride: {x_stride} dtype:{InfiniDtypeNames[tensor_dtype]}"
     )
     conv(
         x.torch_tensor(),
@@ -190,6 +328,7 @@ def test(
         strides,
         pads,
         dilations,
+        groups,
         y.torch_tensor(),
         b.torch_tensor() if b is not None else None,
     )
@@ -210,6 +349,7 @@ def test(
             tuple_to_void_p(strides),
             tuple_to_void_p(dilations),
             len(pads),
+            groups,
         )
     )
 
@@ -246,10 +386,42 @@ def test(
         debug(y.actual_tensor(), y.torch_tensor(), atol=atol, rtol=rtol)
     assert torch.allclose(y.actual_tensor(), y.torch_tensor(), atol=atol, rtol=rtol)
 
+    # Cached preprocessed weights must give the same result on every call
+    check_error(
+        LIBINFINIOP.infiniopSetConvWeightHint(descriptor, ConvWeightHint.CONSTANT)
+    )
+    for _ in range(2):
+        y.actual_tensor().zero_()
+        lib_conv()
+        assert torch.allclose(
+            y.actual_tensor(), y.torch_tensor(), atol=atol, rtol=rtol
+        )
+    check_error(
+        LIBINFINIOP.infiniopSetConvWeightHint(descriptor, ConvWeightHint.DEFAULT)
+    )
+
+    # Fused activation epilogue, skipped on backends that cannot fuse it
+    for activation, fn in [
+        (ConvActivation.RELU, F.relu),
+        (ConvActivation.SILU, F.silu),
+    ]:
+        status = LIBINFINIOP.infiniopSetConvActivation(descriptor, activation)
+        if status == InfiniStatus.NOT_IMPLEMENTED:
+            continue
+        check_error(status)
+        lib_conv()
+        ans = fn(y.torch_tensor().float()).to(y.torch_tensor().dtype)
+        if DEBUG:
+            debug(y.actual_tensor(), ans, atol=atol, rtol=rtol)
+        assert torch.allclose(y.actual_tensor(), ans, atol=atol, rtol=rtol)
+    check_error(
+        LIBINFINIOP.infiniopSetConvActivation(descriptor, ConvActivation.NONE)
+    )
+
     # Profiling workflow
     if PROFILE:
         # fmt: off
-        profile_operation("PyTorch", lambda: conv(x.torch_tensor(), w.torch_tensor(), strides, pads, dilations, b.torch_tensor() if b is not None else None), device, NUM_PRERUN, NUM_ITERATIONS)
+        profile_operation("PyTorch", lambda: conv(x.torch_tensor(), w.torch_tensor(), strides, pads, dilations, groups, y.torch_tensor(), b.torch_tensor() if b is not None else None), device, NUM_PRERUN, NUM_ITERATIONS)
         profile_operation("    lib", lambda: lib_conv(), device, NUM_PRERUN, NUM_ITERATIONS)
         # fmt: on
     check_error(LIBINFINIOP.infiniopDestroyConvDescriptor(descriptor))
@@ -0,0 +1,135 @@
+import torch
+import ctypes
+from libinfiniop import (
+    LIBINFINIOP,
+    TestTensor,
+    get_test_devices,
+    check_error,
+    test_operator,
+    get_args,
+    debug,
+    profile_operation,
+    InfiniDtype,
+    InfiniDtypeNames,
+    InfiniDeviceNames,
+    infiniopOperatorDescriptor_t,
+)
+
+# ==============================================================================
+#  Configuration (Internal Use Only)
+# ==============================================================================
+# These are not meant to be imported from other modules
+_TEST_CASES_ = [
+    # x_shape, x_stride, axis, n_indices
+    # 词嵌入查表
+    ((1000, 64), None, 0, 37),
+    ((32000, 512), None, 0, 5),
+    ((4, 7, 5), None, 1, 2),
+    ((4, 7, 5), (80, 10, 1), -1, 9),
+    ((16, 1024), (2048, 1), 0, 1),
+    ((3, 1 << 20), None, 0, 2),
+]
+
+_INDEX_DTYPES = [InfiniDtype.I32, InfiniDtype.I64]
+
+_TEST_CASES = [
+    test_case + (index_dtype,)
+    for test_case in _TEST_CASES_
+    for index_dtype in _INDEX_DTYPES
+]
+
+# Data types used for testing
+_TENSOR_DTYPES = [InfiniDtype.F16, InfiniDtype.BF16, InfiniDtype.F32]
+
+DEBUG = False
+PROFILE = False
+NUM_PRERUN = 10
+NUM_ITERATIONS = 1000
+
+
+def test(
+    handle,
+    device,
+    x_shape,
+    x_stride=None,
+    axis=0,
+    n_indices=1,
+    index_dtype=InfiniDtype.I32,
+    dtype=InfiniDtype.F16,
+    sync=None,
+):
+    print(
+        f"Testing Gather on {InfiniDeviceNames[device]} with x_shape:{x_shape} x_stride:{x_stride} axis:{axis} "
+        f"n_indices:{n_indices} index_dtype:{InfiniDtypeNames[index_dtype]} dtype:{InfiniDtypeNames[dtype]}"
+    )
+
+    y_shape = list(x_shape)
+    y_shape[axis] = n_indices
+    y_shape = tuple(y_shape)
+
+    x = TestTensor(x_shape, x_stride, dtype, device)
+    y = TestTensor(y_shape, None, dtype, device, mode="zeros")
+    indices = TestTensor.from_torch(
+        torch.randint(0, x_shape[axis], (n_indices,)), index_dtype, device
+    )
+
+    ans = torch.index_select(x.torch_tensor(), axis, indices.torch_tensor().long())
+
+    if sync is not None:
+        sync()
+
+    descriptor = infiniopOperatorDescriptor_t()
+    check_error(
+        LIBINFINIOP.infiniopCreateGatherDescriptor(
+            handle,
+            ctypes.byref(descriptor),
+            y.descriptor,
+            x.descriptor,
+            indices.descriptor,
+            axis,
+        )
+    )
+
+    # Invalidate the shape and strides in the descriptor to prevent them from being directly used by the kernel
+    for tensor in [x, y, indices]:
+        tensor.destroy_desc()
+
+    def lib_gather():
+        check_error(
+            LIBINFINIOP.infiniopGather(
+                descriptor, y.data(), x.data(), indices.data(), None
+            )
+        )
+
+    lib_gather()
+
+    if sync is not None:
+        sync()
+
+    if DEBUG:
+        debug(y.actual_tensor(), ans, atol=0, rtol=0)
+    assert torch.equal(y.actual_tensor(), ans)
+
+    # Profiling workflow
+    if PROFILE:
+        # fmt: off
+        profile_operation("PyTorch", lambda: torch.index_select(x.torch_tensor(), axis, indices.torch_tensor().long()), device, NUM_PRERUN, NUM_ITERATIONS)
+        profile_operation("    lib", lambda: lib_gather(), device, NUM_PRERUN, NUM_ITERATIONS)
+        # fmt: on
+
+    check_error(LIBINFINIOP.infiniopDestroyGatherDescriptor(descriptor))
+
+
+if __name__ == "__main__":
+    args = get_args()
+
+    # Configure testing options
+    DEBUG = args.debug
+    PROFILE = args.profile
+    NUM_PRERUN = args.num_prerun
+    NUM_ITERATIONS = args.num_iterations
+
+    for device in get_test_devices(args):
+        test_operator(device, test, _TEST_CASES, _TENSOR_DTYPES)
+
+    print("\033[92mTest passed!\033[0m")
@@ -0,0 +1,272 @@
+from ctypes import c_uint64
+import ctypes
+import sys
+import os
+import math
+
+sys.path.insert(0, os.path.abspath(os.path.join(os.path.dirname(__file__), "..", "..")))
+from libinfiniop import (
+    LIBINFINIOP,
+    TestTensor,
+    get_test_devices,
+    check_error,
+    test_operator,
+    get_args,
+    debug,
+    get_tolerance,
+    profile_operation,
+    TestWorkspace,
+    InfiniDtype,
+    InfiniDtypeNames,
+    InfiniDeviceNames,
+    infiniopOperatorDescriptor_t,
+)
+
+import torch
+
+# 量化缓存的取值上限
+_QUANT_MAX = {
+    InfiniDtype.I8: 127.0,
+    InfiniDtype.F8: 448.0,
+}
+
+
+def dequantize(cache, scale):
+    if scale is None:
+        return cache.to(torch.float32)
+    return cache.to(torch.float32) * scale.to(torch.float32).unsqueeze(-1)
+
+
+def alibi_slopes(n_head, max_bias):
+    n_floor = 2 ** math.floor(math.log2(n_head))
+    m0 = 2.0 ** (-max_bias / n_floor)
+    m1 = 2.0 ** (-max_bias / 2 / n_floor)
+    return torch.tensor(
+        [
+            m0 ** (h + 1) if h < n_floor else m1 ** (2 * (h - n_floor) + 1)
+            for h in range(n_head)
+        ]
+    )
+
+
+def attention(q, k_cache, v_cache, pos, window, alibi_max_bias):
+    # q: [n_q_head, seq_len, head_dim], cache: [n_kv_head, >= pos + seq_len, head_dim]
+    type = q.dtype
+    n_q_head, seq_len, head_dim = q.shape
+    n_kv_head = k_cache.shape[0]
+    total_seq_len = pos + seq_len
+
+    k = k_cache[:, :total_seq_len, :].repeat_interleave(n_q_head // n_kv_head, dim=0)
+    v = v_cache[:, :total_seq_len, :].repeat_interleave(n_q_head // n_kv_head, dim=0)
+
+    scores = torch.einsum("hqd,hkd->hqk", q.to(torch.float32), k) / (head_dim**0.5)
+    i = torch.arange(pos, total_seq_len, device=q.device).unsqueeze(-1)
+    j = torch.arange(total_seq_len, device=q.device).unsqueeze(0)
+    mask = j <= i
+    if window > 0:
+        mask &= j > i - window
+    if alibi_max_bias > 0:
+        slopes = alibi_slopes(n_q_head, alibi_max_bias).to(q.device)
+        scores = scores + slopes.view(-1, 1, 1) * (j - i)
+    scores = scores.masked_fill(~mask, -torch.inf)
+    weights = torch.nn.functional.softmax(scores, dim=-1)
+    return torch.einsum("hqk,hkd->qhd", weights, v).to(type)
+
+
+def test(
+    handle,
+    device,
+    n_q_head,
+    n_kv_head,
+    seq_len,
+    head_dim,
+    pos,
+    cache_len,
+    cache_dtype=None,
+    static_scale=False,
+    window=0,
+    alibi_max_bias=0.0,
+    dtype=InfiniDtype.F16,
+    sync=None,
+):
+    quantized = cache_dtype is not None
+    cache_dtype = cache_dtype if quantized else dtype
+    print(
+        f"Testing KVCacheAttention on {InfiniDeviceNames[device]} with n_q_head:{n_q_head} n_kv_head:{n_kv_head} seq_len:{seq_len} head_dim:{head_dim} pos:{pos} "
+        f"cache_len:{cache_len} dtype:{InfiniDtypeNames[dtype]} cache_dtype:{InfiniDtypeNames[cache_dtype]} static_scale:{static_scale} window:{window} alibi_max_bias:{alibi_max_bias}"
+    )
+
+    out = TestTensor([seq_len, n_q_head, head_dim], None, dtype, device, mode="zeros")
+    q = TestTensor([n_q_head, seq_len, head_dim], None, dtype, device, scale=0.1)
+    k = TestTensor([n_kv_head, seq_len, head_dim], None, dtype, device, scale=0.1)
+    v = TestTensor([n_kv_head, seq_len, head_dim], None, dtype, device, scale=0.1)
+    cache_mode = "zeros" if quantized else "random"
+    k_cache = TestTensor(
+        [n_kv_head, cache_len, head_dim], None, cache_dtype, device, mode=cache_mode
+    )
+    v_cache = TestTensor(
+        [n_kv_head, cache_len, head_dim], None, cache_dtype, device, mode=cache_mode
+    )
+    k_scale, v_scale = None, None
+    if quantized:
+        if static_scale:
+            # 输入在 [0, 0.1) 之间，静态缩放覆盖整个取值范围
+            scale_strides = [1, 0]
+            scale_mode, scale = "ones", 0.1 / _QUANT_MAX[cache_dtype]
+        else:
+            scale_strides = None
+            scale_mode, scale = "zeros", None
+        k_scale, v_scale = [
+            TestTensor(
+                [n_kv_head, cache_len],
+                scale_strides,
+                InfiniDtype.F32,
+                device,
+                mode=scale_mode,
+                scale=scale,
+            )
+            for _ in range(2)
+        ]
+
+    if sync is not None:
+        sync()
+
+    descriptor = infiniopOperatorDescriptor_t()
+    check_error(
+        LIBINFINIOP.infiniopCreateKVCacheAttentionDescriptor(
+            handle,
+            ctypes.byref(descriptor),
+            out.descriptor,
+            q.descriptor,
+            k.descriptor,
+            v.descriptor,
+            k_cache.descriptor,
+            v_cache.descriptor,
+            k_scale.descriptor if quantized else None,
+            v_scale.descriptor if quantized else None,
+            pos,
+            window,
+            alibi_max_bias,
+        )
+    )
+
+    # Invalidate the shape and strides in the descriptor to prevent them from being directly used by the kernel
+    for tensor in [out, q, k, v, k_cache, v_cache] + (
+        [k_scale, v_scale] if quantized else []
+    ):
+        tensor.destroy_desc()
+
+    workspace_size = c_uint64(0)
+    check_error(
+        LIBINFINIOP.infiniopGetKVCacheAttentionWorkspaceSize(
+            descriptor, ctypes.byref(workspace_size)
+        )
+    )
+    workspace = TestWorkspace(workspace_size.value, out.device)
+
+    def lib_kv_cache_attention():
+        check_error(
+            LIBINFINIOP.infiniopKVCacheAttention(
+                descriptor,
+                workspace.data(),
+                workspace_size.value,
+                out.data(),
+                q.data(),
+                k.data(),
+                v.data(),
+                k_cache.data(),
+                v_cache.data(),
+                k_scale.data() if quantized else None,
+                v_scale.data() if quantized else None,
+                None,
+            )
+        )
+
+    lib_kv_cache_attention()
+
+    k_full = dequantize(
+        k_cache.actual_tensor(), k_scale.actual_tensor() if quantized else None
+    )
+    v_full = dequantize(
+        v_cache.actual_tensor(), v_scale.actual_tensor() if quantized else None
+    )
+
+    # 新的 k/v 必须被写入缓存，量化误差不超过一个量化步长
+    atol, rtol = get_tolerance(_TOLERANCE_MAP, dtype)
+    if quantized:
+        cache_atol, cache_rtol = 0.1 / _QUANT_MAX[cache_dtype], 0.0625
+    else:
+        cache_atol, cache_rtol = 0, 0
+    for new, full in [(k, k_full), (v, v_full)]:
+        assert torch.allclose(
+            full[:, pos : pos + seq_len, :],
+            new.torch_tensor().to(torch.float32),
+            atol=cache_atol,
+            rtol=cache_rtol,
+        )
+
+    def torch_attention():
+        return attention(
+            q.torch_tensor(), k_full, v_full, pos, window, alibi_max_bias
+        )
+
+    ans = torch_attention()
+
+    # Validate results
+    if DEBUG:
+        debug(out.actual_tensor(), ans, atol=atol, rtol=rtol)
+    assert torch.allclose(out.actual_tensor(), ans, atol=atol, rtol=rtol)
+
+    # Profiling workflow
+    if PROFILE:
+        # fmt: off
+        profile_operation("PyTorch", lambda: torch_attention(), device, NUM_PRERUN, NUM_ITERATIONS)
+        profile_operation("    lib", lambda: lib_kv_cache_attention(), device, NUM_PRERUN, NUM_ITERATIONS)
+        # fmt: on
+    check_error(LIBINFINIOP.infiniopDestroyKVCacheAttentionDescriptor(descriptor))
+
+
+if __name__ == "__main__":
+    _TENSOR_DTYPES = [InfiniDtype.F16, InfiniDtype.F32]
+
+    # Tolerance map for different data types
+    _TOLERANCE_MAP = {
+        InfiniDtype.F16: {"atol": 1e-4, "rtol": 1e-2},
+        InfiniDtype.F32: {"atol": 1e-5, "rtol": 1e-3},
+    }
+
+    DEBUG = False
+    PROFILE = False
+    NUM_PRERUN = 10
+    NUM_ITERATIONS = 1000
+    test_cases = [
+        # n_q_head, n_kv_head, seq_len, head_dim, pos, cache_len, cache_dtype, static_scale, window, alibi_max_bias
+        # prefill
+        (32, 4, 5, 64, 0, 2048, None, False, 0, 0.0),
+        (32, 4, 5, 64, 0, 2048, InfiniDtype.I8, False, 0, 0.0),
+        (32, 4, 5, 64, 0, 2048, InfiniDtype.F8, False, 0, 0.0),
+        # decode
+        (32, 4, 1, 64, 3, 2048, None, False, 0, 0.0),
+        (32, 4, 1, 64, 3, 2048, InfiniDtype.I8, False, 0, 0.0),
+        (32, 4, 1, 64, 3, 2048, InfiniDtype.I8, True, 0, 0.0),
+        (32, 4, 1, 64, 3, 2048, InfiniDtype.F8, True, 0, 0.0),
+        # sliding window / alibi
+        (32, 4, 7, 64, 100, 2048, None, False, 16, 0.0),
+        (32, 4, 1, 64, 100, 2048, InfiniDtype.I8, False, 16, 8.0),
+        (12, 4, 3, 32, 5, 64, None, False, 0, 8.0),
+        # for test
+        (8, 4, 2, 16, 1, 8, InfiniDtype.I8, False, 0, 0.0),
+        (28, 28, 15, 128, 0, 2048, InfiniDtype.F8, False, 0, 0.0),
+    ]
+    args = get_args()
+
+    # Configure testing options
+    DEBUG = args.debug
+    PROFILE = args.profile
+    NUM_PRERUN = args.num_prerun
+    NUM_ITERATIONS = args.num_iterations
+
+    # Execute tests
+    for device in get_test_devices(args):
+        test_operator(device, test, test_cases, _TENSOR_DTYPES)
+    print("\033[92mTest passed!\033[0m")
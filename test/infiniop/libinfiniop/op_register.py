@@ -2,6 +2,8 @@ from .structs import (
     infiniopHandle_t,
     infiniopTensorDescriptor_t,
     infiniopOperatorDescriptor_t,
+    RoPEScaling,
+    LogitsProcessor,
 )
 
 from ctypes import c_int32, c_void_p, c_size_t, POINTER, c_float
@@ -55,6 +57,45 @@ def add_(lib):
     ]
 
 
+@OpRegister.operator
+def add_rms_norm_(lib):
+    lib.infiniopCreateAddRMSNormDescriptor.restype = c_int32
+    lib.infiniopCreateAddRMSNormDescriptor.argtypes = [
+        infiniopHandle_t,
+        POINTER(infiniopOperatorDescriptor_t),
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        c_float,
+    ]
+
+    lib.infiniopGetAddRMSNormWorkspaceSize.restype = c_int32
+    lib.infiniopGetAddRMSNormWorkspaceSize.argtypes = [
+        infiniopOperatorDescriptor_t,
+        POINTER(c_size_t),
+    ]
+
+    lib.infiniopAddRMSNorm.restype = c_int32
+    lib.infiniopAddRMSNorm.argtypes = [
+        infiniopOperatorDescriptor_t,
+        c_void_p,
+        c_size_t,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+    ]
+
+    lib.infiniopDestroyAddRMSNormDescriptor.restype = c_int32
+    lib.infiniopDestroyAddRMSNormDescriptor.argtypes = [
+        infiniopOperatorDescriptor_t,
+    ]
+
+
 @OpRegister.operator
 def attention_(lib):
     lib.infiniopCreateAttentionDescriptor.restype = c_int32
@@ -105,6 +146,18 @@ def causal_softmax_(lib):
         infiniopTensorDescriptor_t,
     ]
 
+    lib.infiniopCreateCausalSoftmaxExDescriptor.restype = c_int32
+    lib.infiniopCreateCausalSoftmaxExDescriptor.argtypes = [
+        infiniopHandle_t,
+        POINTER(infiniopOperatorDescriptor_t),
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        c_float,
+        c_size_t,
+        c_float,
+    ]
+
     lib.infiniopGetCausalSoftmaxWorkspaceSize.restype = c_int32
     lib.infiniopGetCausalSoftmaxWorkspaceSize.argtypes = [
         infiniopOperatorDescriptor_t,
@@ -120,6 +173,17 @@ def causal_softmax_(lib):
         c_void_p,
     ]
 
+    lib.infiniopCausalSoftmaxEx.restype = c_int32
+    lib.infiniopCausalSoftmaxEx.argtypes = [
+        infiniopOperatorDescriptor_t,
+        c_void_p,
+        c_size_t,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+    ]
+
     lib.infiniopDestroyCausalSoftmaxDescriptor.restype = c_int32
     lib.infiniopDestroyCausalSoftmaxDescriptor.argtypes = [
         infiniopOperatorDescriptor_t,
@@ -167,6 +231,33 @@ def conv_(lib):
     pass
 
 
+@OpRegister.operator
+def gather_(lib):
+    lib.infiniopCreateGatherDescriptor.restype = c_int32
+    lib.infiniopCreateGatherDescriptor.argtypes = [
+        infiniopHandle_t,
+        POINTER(infiniopOperatorDescriptor_t),
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        c_int32,
+    ]
+
+    lib.infiniopGather.restype = c_int32
+    lib.infiniopGather.argtypes = [
+        infiniopOperatorDescriptor_t,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+    ]
+
+    lib.infiniopDestroyGatherDescriptor.restype = c_int32
+    lib.infiniopDestroyGatherDescriptor.argtypes = [
+        infiniopOperatorDescriptor_t,
+    ]
+
+
 @OpRegister.operator
 def gemm_(lib):
     lib.infiniopCreateGemmDescriptor.restype = c_int32
@@ -203,6 +294,94 @@ def gemm_(lib):
     ]
 
 
+@OpRegister.operator
+def kv_cache_attention_(lib):
+    lib.infiniopCreateKVCacheAttentionDescriptor.restype = c_int32
+    lib.infiniopCreateKVCacheAttentionDescriptor.argtypes = [
+        infiniopHandle_t,
+        POINTER(infiniopOperatorDescriptor_t),
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        c_size_t,
+        c_size_t,
+        c_float,
+    ]
+
+    lib.infiniopGetKVCacheAttentionWorkspaceSize.restype = c_int32
+    lib.infiniopGetKVCacheAttentionWorkspaceSize.argtypes = [
+        infiniopOperatorDescriptor_t,
+        POINTER(c_size_t),
+    ]
+
+    lib.infiniopKVCacheAttention.restype = c_int32
+    lib.infiniopKVCacheAttention.argtypes = [
+        infiniopOperatorDescriptor_t,
+        c_void_p,
+        c_size_t,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+    ]
+
+    lib.infiniopDestroyKVCacheAttentionDescriptor.restype = c_int32
+    lib.infiniopDestroyKVCacheAttentionDescriptor.argtypes = [
+        infiniopOperatorDescriptor_t,
+    ]
+
+
+@OpRegister.operator
+def layer_norm_(lib):
+    lib.infiniopCreateLayerNormDescriptor.restype = c_int32
+    lib.infiniopCreateLayerNormDescriptor.argtypes = [
+        infiniopHandle_t,
+        POINTER(infiniopOperatorDescriptor_t),
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        c_float,
+    ]
+
+    lib.infiniopGetLayerNormWorkspaceSize.restype = c_int32
+    lib.infiniopGetLayerNormWorkspaceSize.argtypes = [
+        infiniopOperatorDescriptor_t,
+        POINTER(c_size_t),
+    ]
+
+    lib.infiniopLayerNorm.restype = c_int32
+    lib.infiniopLayerNorm.argtypes = [
+        infiniopOperatorDescriptor_t,
+        c_void_p,
+        c_size_t,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+    ]
+
+    lib.infiniopDestroyLayerNormDescriptor.restype = c_int32
+    lib.infiniopDestroyLayerNormDescriptor.argtypes = [
+        infiniopOperatorDescriptor_t,
+    ]
+
+
 @OpRegister.operator
 def mul_(lib):
     lib.infiniopCreateMulDescriptor.restype = c_int32
@@ -244,6 +423,7 @@ def random_sample_(lib):
         infiniopHandle_t,
         POINTER(infiniopOperatorDescriptor_t),
         infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
     ]
 
     lib.infiniopGetRandomSampleWorkspaceSize.restype = c_int32
@@ -266,6 +446,21 @@ def random_sample_(lib):
         c_void_p,
     ]
 
+    lib.infiniopRandomSampleBatched.restype = c_int32
+    lib.infiniopRandomSampleBatched.argtypes = [
+        infiniopOperatorDescriptor_t,
+        c_void_p,
+        c_size_t,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+        POINTER(LogitsProcessor),
+        c_void_p,
+    ]
+
     lib.infiniopDestroyRandomSampleDescriptor.restype = c_int32
     lib.infiniopDestroyRandomSampleDescriptor.argtypes = [
         infiniopOperatorDescriptor_t,
@@ -282,6 +477,12 @@ def rearrange_(lib):
         infiniopTensorDescriptor_t,
     ]
 
+    lib.infiniopSetRearrangeHint.restype = c_int32
+    lib.infiniopSetRearrangeHint.argtypes = [
+        infiniopOperatorDescriptor_t,
+        c_int32,
+    ]
+
     lib.infiniopRearrange.restype = c_int32
     lib.infiniopRearrange.argtypes = [
         infiniopOperatorDescriptor_t,
@@ -351,6 +552,43 @@ def rms_norm_(lib):
     ]
 
 
+@OpRegister.operator
+def rms_norm_quant_(lib):
+    lib.infiniopCreateRMSNormQuantDescriptor.restype = c_int32
+    lib.infiniopCreateRMSNormQuantDescriptor.argtypes = [
+        infiniopHandle_t,
+        POINTER(infiniopOperatorDescriptor_t),
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        c_float,
+    ]
+
+    lib.infiniopGetRMSNormQuantWorkspaceSize.restype = c_int32
+    lib.infiniopGetRMSNormQuantWorkspaceSize.argtypes = [
+        infiniopOperatorDescriptor_t,
+        POINTER(c_size_t),
+    ]
+
+    lib.infiniopRMSNormQuant.restype = c_int32
+    lib.infiniopRMSNormQuant.argtypes = [
+        infiniopOperatorDescriptor_t,
+        c_void_p,
+        c_size_t,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+    ]
+
+    lib.infiniopDestroyRMSNormQuantDescriptor.restype = c_int32
+    lib.infiniopDestroyRMSNormQuantDescriptor.argtypes = [
+        infiniopOperatorDescriptor_t,
+    ]
+
+
 @OpRegister.operator
 def rope_(lib):
     lib.infiniopCreateRoPEDescriptor.restype = c_int32
@@ -363,6 +601,31 @@ def rope_(lib):
         infiniopTensorDescriptor_t,
     ]
 
+    lib.infiniopCreateRoPEThetaDescriptor.restype = c_int32
+    lib.infiniopCreateRoPEThetaDescriptor.argtypes = [
+        infiniopHandle_t,
+        POINTER(infiniopOperatorDescriptor_t),
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        c_float,
+        POINTER(RoPEScaling),
+    ]
+
+    lib.infiniopCreateRoPEExDescriptor.restype = c_int32
+    lib.infiniopCreateRoPEExDescriptor.argtypes = [
+        infiniopHandle_t,
+        POINTER(infiniopOperatorDescriptor_t),
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        c_float,
+        POINTER(RoPEScaling),
+        c_int32,
+    ]
+
     lib.infiniopGetRoPEWorkspaceSize.restype = c_int32
     lib.infiniopGetRoPEWorkspaceSize.argtypes = [
         infiniopOperatorDescriptor_t,
@@ -387,6 +650,133 @@ def rope_(lib):
     ]
 
 
+@OpRegister.operator
+def rope_kv_cache_(lib):
+    lib.infiniopCreateRoPEKVCacheDescriptor.restype = c_int32
+    lib.infiniopCreateRoPEKVCacheDescriptor.argtypes = [
+        infiniopHandle_t,
+        POINTER(infiniopOperatorDescriptor_t),
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        c_size_t,
+    ]
+
+    lib.infiniopCreateRoPEKVCacheExDescriptor.restype = c_int32
+    lib.infiniopCreateRoPEKVCacheExDescriptor.argtypes = [
+        infiniopHandle_t,
+        POINTER(infiniopOperatorDescriptor_t),
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        c_size_t,
+        c_float,
+        POINTER(RoPEScaling),
+        c_int32,
+    ]
+
+    lib.infiniopGetRoPEKVCacheWorkspaceSize.restype = c_int32
+    lib.infiniopGetRoPEKVCacheWorkspaceSize.argtypes = [
+        infiniopOperatorDescriptor_t,
+        POINTER(c_size_t),
+    ]
+
+    lib.infiniopRoPEKVCache.restype = c_int32
+    lib.infiniopRoPEKVCache.argtypes = [
+        infiniopOperatorDescriptor_t,
+        c_void_p,
+        c_size_t,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+    ]
+
+    lib.infiniopDestroyRoPEKVCacheDescriptor.restype = c_int32
+    lib.infiniopDestroyRoPEKVCacheDescriptor.argtypes = [
+        infiniopOperatorDescriptor_t,
+    ]
+
+
+@OpRegister.operator
+def scatter_(lib):
+    lib.infiniopCreateScatterDescriptor.restype = c_int32
+    lib.infiniopCreateScatterDescriptor.argtypes = [
+        infiniopHandle_t,
+        POINTER(infiniopOperatorDescriptor_t),
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        c_int32,
+    ]
+
+    lib.infiniopScatter.restype = c_int32
+    lib.infiniopScatter.argtypes = [
+        infiniopOperatorDescriptor_t,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+    ]
+
+    lib.infiniopDestroyScatterDescriptor.restype = c_int32
+    lib.infiniopDestroyScatterDescriptor.argtypes = [
+        infiniopOperatorDescriptor_t,
+    ]
+
+
+@OpRegister.operator
+def softmax_(lib):
+    lib.infiniopCreateSoftmaxDescriptor.restype = c_int32
+    lib.infiniopCreateSoftmaxDescriptor.argtypes = [
+        infiniopHandle_t,
+        POINTER(infiniopOperatorDescriptor_t),
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        infiniopTensorDescriptor_t,
+        c_int32,
+        c_float,
+        c_int32,
+    ]
+
+    lib.infiniopGetSoftmaxWorkspaceSize.restype = c_int32
+    lib.infiniopGetSoftmaxWorkspaceSize.argtypes = [
+        infiniopOperatorDescriptor_t,
+        POINTER(c_size_t),
+    ]
+
+    lib.infiniopSoftmax.restype = c_int32
+    lib.infiniopSoftmax.argtypes = [
+        infiniopOperatorDescriptor_t,
+        c_void_p,
+        c_size_t,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+        c_void_p,
+    ]
+
+    lib.infiniopDestroySoftmaxDescriptor.restype = c_int32
+    lib.infiniopDestroySoftmaxDescriptor.argtypes = [
+        infiniopOperatorDescriptor_t,
+    ]
+
+
 @OpRegister.operator
 def sub_(lib):
     lib.infiniopCreateSubDescriptor.restype = c_int32
@@ -468,6 +858,17 @@ def conv_(lib):
         c_void_p,
         c_void_p,
         c_size_t,
+        c_size_t,
+    ]
+    lib.infiniopSetConvWeightHint.restype = c_int32
+    lib.infiniopSetConvWeightHint.argtypes = [
+        infiniopOperatorDescriptor_t,
+        c_int32,
+    ]
+    lib.infiniopSetConvActivation.restype = c_int32
+    lib.infiniopSetConvActivation.argtypes = [
+        infiniopOperatorDescriptor_t,
+        c_int32,
     ]
     lib.infiniopGetConvWorkspaceSize.restype = c_int32
     lib.infiniopGetConvWorkspaceSize.argtypes = [
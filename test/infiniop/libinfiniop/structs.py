@@ -1,4 +1,4 @@
-from ctypes import c_int, Structure, POINTER
+from ctypes import c_int, c_float, c_size_t, Structure, POINTER
 
 
 class TensorDescriptor(Structure):
@@ -20,3 +20,71 @@ class OpDescriptor(Structure):
 
 
 infiniopOperatorDescriptor_t = POINTER(OpDescriptor)
+
+
+class InfiniStatus:
+    SUCCESS = 0
+    INTERNAL_ERROR = 1
+    NOT_IMPLEMENTED = 2
+    BAD_PARAM = 3
+    NULL_POINTER = 4
+    DEVICE_TYPE_NOT_SUPPORTED = 5
+    DEVICE_NOT_FOUND = 6
+    DEVICE_NOT_INITIALIZED = 7
+    DEVICE_ARCHITECTURE_NOT_SUPPORTED = 8
+    BAD_TENSOR_DTYPE = 10
+    BAD_TENSOR_SHAPE = 11
+    BAD_TENSOR_STRIDES = 12
+    INSUFFICIENT_WORKSPACE = 13
+
+
+class RoPEAlgo:
+    GPT_J = 0
+    GPT_NEOX = 1
+
+
+class RoPEScaling(Structure):
+    NONE = 0
+    LINEAR = 1
+    NTK = 2
+    YARN = 3
+
+    _fields_ = [
+        ("type", c_int),
+        ("factor", c_float),
+        ("original_max_position_embeddings", c_size_t),
+        ("beta_fast", c_float),
+        ("beta_slow", c_float),
+        ("attention_factor", c_float),
+    ]
+
+
+class LogitsProcessor(Structure):
+    _fields_ = [
+        ("token_ids", POINTER(c_int)),
+        ("num_tokens", c_size_t),
+        ("repetition_penalty", c_float),
+        ("frequency_penalty", c_float),
+        ("presence_penalty", c_float),
+        ("bias_token_ids", POINTER(c_int)),
+        ("bias_values", POINTER(c_float)),
+        ("num_bias", c_size_t),
+        ("min_p", c_float),
+    ]
+
+
+class RearrangeHint:
+    DEFAULT = 0
+    STREAMING = 1
+    CACHED = 2
+
+
+class ConvWeightHint:
+    DEFAULT = 0
+    CONSTANT = 1
+
+
+class ConvActivation:
+    NONE = 0
+    RELU = 1
+    SILU = 2
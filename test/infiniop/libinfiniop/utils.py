@@ -122,7 +122,9 @@ class TestTensor(CTensor):
 
 
 def to_torch_dtype(dt: InfiniDtype, compatability_mode=False):
-    if dt == InfiniDtype.I8:
+    if dt == InfiniDtype.BOOL:
+        return torch.bool
+    elif dt == InfiniDtype.I8:
         return torch.int8
     elif dt == InfiniDtype.I16:
         return torch.int16
@@ -132,6 +134,8 @@ def to_torch_dtype(dt: InfiniDtype, compatability_mode=False):
         return torch.int64
     elif dt == InfiniDtype.U8:
         return torch.uint8
+    elif dt == InfiniDtype.F8:
+        return torch.float8_e4m3fn
     elif dt == InfiniDtype.F16:
         return torch.float16
     elif dt == InfiniDtype.BF16:
@@ -1,6 +1,6 @@
 import torch
 import ctypes
-from ctypes import c_uint64
+from ctypes import c_uint64, c_int, c_float, POINTER
 from libinfiniop import (
     LIBINFINIOP,
     TestTensor,
@@ -15,7 +15,9 @@ from libinfiniop import (
     InfiniDtype,
     InfiniDtypeNames,
     InfiniDeviceNames,
+    InfiniDeviceEnum,
     infiniopOperatorDescriptor_t,
+    LogitsProcessor,
 )
 
 # ==============================================================================
@@ -33,9 +35,40 @@ _TEST_CASES = [
     (16384, 0.15, 0, 1, 2.0),
     (32000, 0.08, 0.8, 50, 1.0),
     (32000, 0.08, 1.0, 25, 1.0),
+    (4096, 0.3, 0.95, 1000, 1.0),
+    (151936, 0.08, 0.8, 50, 1.0),
+    (151936, 0.0, 0.8, 50, 1.0),
     # (119696, 0.01, 1.0, 100, 1.0),
 ]
 
+# voc, batch; 每行的 random_val/topp/topk/temperature 循环取自 _BATCHED_PARAMS，贪心和随机采样的行混在一起
+_BATCHED_TEST_CASES = [
+    (512, 7),
+    (4096, 64),
+    (32000, 3),
+]
+
+_BATCHED_PARAMS = [
+    (0.8, 0.8, 3, 0.5),
+    (0.0, 0.9, 5, 1.0),
+    (0.15, 0.85, 10, 2.0),
+    (0.5, 0.9, 1, 1.0),
+    (0.08, 1.0, 25, 1.0),
+    (0.3, 0.95, 100, 0.7),
+]
+
+# voc, batch; 每行的 repetition/frequency/presence 惩罚和 min_p 循环取自 _PROCESSOR_PARAMS
+_PROCESSOR_TEST_CASES = [
+    (512, 4),
+    (32000, 6),
+]
+
+_PROCESSOR_PARAMS = [
+    (1.3, 0.0, 0.0, 0.0),
+    (1.0, 0.2, 0.5, 0.0),
+    (1.2, 0.1, 0.1, 0.5),
+]
+
 # Data types used for testing
 _TENSOR_DTYPES = [InfiniDtype.F16, InfiniDtype.BF16]
 
@@ -51,7 +84,7 @@ NUM_PRERUN = 10
 NUM_ITERATIONS = 1000
 
 
-def random_sample(data, random_val, topp, topk, voc, temperature):
+def random_sample(data, random_val, topp, topk, voc, temperature, min_p=0.0):
     if topp > 0 and topk > 1:
         sorted_vals, sorted_indices = torch.sort(data, descending=True)
 
@@ -60,6 +93,9 @@ def random_sample(data, random_val, topp, topk, voc, temperature):
         cum_probs = torch.cumsum(probs, dim=0)
 
         k_index = min(topk, voc) - 1
+        if min_p > 0:
+            # 概率不低于最大概率的 min_p 倍的词才保留
+            k_index = min(k_index, int((probs >= probs[0] * min_p).sum()) - 1)
         threshold = min(cum_probs[k_index], topp) * random_val
 
         try:
@@ -176,6 +212,216 @@ def test(
     check_error(LIBINFINIOP.infiniopDestroyRandomSampleDescriptor(descriptor))
 
 
+def test_batched(
+    handle,
+    device,
+    voc,
+    batch,
+    dtype=InfiniDtype.F16,
+    sync=None,
+):
+    print(
+        f"Testing batched RandomSample on {InfiniDeviceNames[device]} with voc:{voc} batch:{batch} dtype:{InfiniDtypeNames[dtype]}"
+    )
+
+    params = [_BATCHED_PARAMS[i % len(_BATCHED_PARAMS)] for i in range(batch)]
+    logits = TestTensor.from_torch(
+        torch.stack([torch.randperm(voc).float() * 0.0001 for _ in range(batch)]),
+        dtype,
+        device,
+    )
+    ans = torch.stack(
+        [
+            random_sample(
+                logits.torch_tensor()[i], random_val, topp, topk, voc, temperature
+            ).to(torch.int32)
+            for i, (random_val, topp, topk, temperature) in enumerate(params)
+        ]
+    )
+
+    indices = TestTensor([batch], None, InfiniDtype.I32, device, mode="zeros")
+    random_val, topp, topk, temperature = [
+        TestTensor.from_torch(torch.tensor(column), dt, device)
+        for column, dt in zip(
+            zip(*params),
+            [InfiniDtype.F32, InfiniDtype.F32, InfiniDtype.I32, InfiniDtype.F32],
+        )
+    ]
+
+    if sync is not None:
+        sync()
+
+    descriptor = infiniopOperatorDescriptor_t()
+    check_error(
+        LIBINFINIOP.infiniopCreateRandomSampleDescriptor(
+            handle,
+            ctypes.byref(descriptor),
+            indices.descriptor,
+            logits.descriptor,
+        )
+    )
+
+    for tensor in [logits, indices]:
+        tensor.destroy_desc()
+
+    workspace_size = c_uint64(0)
+    check_error(
+        LIBINFINIOP.infiniopGetRandomSampleWorkspaceSize(
+            descriptor, ctypes.byref(workspace_size)
+        )
+    )
+    workspace = TestWorkspace(workspace_size.value, device)
+
+    check_error(
+        LIBINFINIOP.infiniopRandomSampleBatched(
+            descriptor,
+            workspace.data(),
+            workspace_size.value,
+            indices.data(),
+            logits.data(),
+            random_val.data(),
+            topp.data(),
+            topk.data(),
+            temperature.data(),
+            None,
+            None,
+        )
+    )
+
+    if sync is not None:
+        sync()
+
+    actual = indices.actual_tensor()
+    for i in range(batch):
+        assert (
+            actual[i] == ans[i]
+            or logits.actual_tensor()[i][actual[i]] == logits.torch_tensor()[i][ans[i]]
+        )
+
+    check_error(LIBINFINIOP.infiniopDestroyRandomSampleDescriptor(descriptor))
+
+
+def process_logits(logits, token_ids, repetition, frequency, presence, bias_ids, bias):
+    logits = logits.float().clone()
+    logits.index_add_(0, bias_ids, bias)
+    ids, counts = torch.unique(token_ids, return_counts=True)
+    x = logits[ids]
+    x = torch.where(x > 0, x / repetition, x * repetition)
+    logits[ids] = x - frequency * counts - presence
+    return logits
+
+
+def test_processors(
+    handle,
+    device,
+    voc,
+    batch,
+    dtype=InfiniDtype.F16,
+    sync=None,
+):
+    print(
+        f"Testing RandomSample with logits processors on {InfiniDeviceNames[device]} with voc:{voc} batch:{batch} dtype:{InfiniDtypeNames[dtype]}"
+    )
+
+    sample_params = [_BATCHED_PARAMS[i % len(_BATCHED_PARAMS)] for i in range(batch)]
+    logits = TestTensor.from_torch(
+        torch.stack([torch.randperm(voc).float() * 0.0001 for _ in range(batch)]),
+        dtype,
+        device,
+    )
+
+    # 惩罚作用在概率最大的词上，偏置既有屏蔽也有抬升，下标可以重复
+    processors = (LogitsProcessor * batch)()
+    keep_alive = []
+    ans, processed = [], []
+    for i in range(batch):
+        repetition, frequency, presence, min_p = _PROCESSOR_PARAMS[
+            i % len(_PROCESSOR_PARAMS)
+        ]
+        row = logits.torch_tensor()[i]
+        top = torch.topk(row.float(), 8).indices
+        token_ids = torch.cat([top, top[:3], torch.randint(0, voc, (32,))]).to(torch.int32)
+        bias_ids = torch.cat([top[:2], torch.randint(0, voc, (6,))]).to(torch.int32)
+        bias = torch.tensor([-100.0, 0.01, 0.02, -0.01, 0.03, 1.0, -100.0, 0.005])
+        keep_alive += [token_ids, bias_ids, bias]
+        processors[i] = LogitsProcessor(
+            ctypes.cast(token_ids.data_ptr(), POINTER(c_int)),
+            token_ids.numel(),
+            repetition,
+            frequency,
+            presence,
+            ctypes.cast(bias_ids.data_ptr(), POINTER(c_int)),
+            ctypes.cast(bias.data_ptr(), POINTER(c_float)),
+            bias_ids.numel(),
+            min_p,
+        )
+
+        x = process_logits(
+            row,
+            token_ids.long(),
+            repetition,
+            frequency,
+            presence,
+            bias_ids.long(),
+            bias,
+        )
+        random_val, topp, topk, temperature = sample_params[i]
+        ans.append(random_sample(x, random_val, topp, topk, voc, temperature, min_p))
+        processed.append(x)
+
+    indices = TestTensor([batch], None, InfiniDtype.I32, device, mode="zeros")
+    random_val, topp, topk, temperature = [
+        TestTensor.from_torch(torch.tensor(column), dt, device)
+        for column, dt in zip(
+            zip(*sample_params),
+            [InfiniDtype.F32, InfiniDtype.F32, InfiniDtype.I32, InfiniDtype.F32],
+        )
+    ]
+
+    descriptor = infiniopOperatorDescriptor_t()
+    check_error(
+        LIBINFINIOP.infiniopCreateRandomSampleDescriptor(
+            handle,
+            ctypes.byref(descriptor),
+            indices.descriptor,
+            logits.descriptor,
+        )
+    )
+
+    for tensor in [logits, indices]:
+        tensor.destroy_desc()
+
+    workspace_size = c_uint64(0)
+    check_error(
+        LIBINFINIOP.infiniopGetRandomSampleWorkspaceSize(
+            descriptor, ctypes.byref(workspace_size)
+        )
+    )
+    workspace = TestWorkspace(workspace_size.value, device)
+
+    check_error(
+        LIBINFINIOP.infiniopRandomSampleBatched(
+            descriptor,
+            workspace.data(),
+            workspace_size.value,
+            indices.data(),
+            logits.data(),
+            random_val.data(),
+            topp.data(),
+            topk.data(),
+            temperature.data(),
+            processors,
+            None,
+        )
+    )
+
+    actual = indices.actual_tensor()
+    for i in range(batch):
+        assert actual[i] == ans[i] or processed[i][actual[i]] == processed[i][ans[i]]
+
+    check_error(LIBINFINIOP.infiniopDestroyRandomSampleDescriptor(descriptor))
+
+
 if __name__ == "__main__":
     args = get_args()
 
@@ -187,5 +433,9 @@ if __name__ == "__main__":
     # Execute tests
     for device in get_test_devices(args):
         test_operator(device, test, _TEST_CASES, _TENSOR_DTYPES)
+        # 批量采样目前只有 CPU 实现
+        if device == InfiniDeviceEnum.CPU:
+            test_operator(device, test_batched, _BATCHED_TEST_CASES, _TENSOR_DTYPES)
+            test_operator(device, test_processors, _PROCESSOR_TEST_CASES, _TENSOR_DTYPES)
 
     print("\033[92mTest passed!\033[0m")
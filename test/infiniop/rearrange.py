@@ -14,6 +14,8 @@ from libinfiniop import (
     InfiniDtypeNames,
     InfiniDeviceNames,
     infiniopOperatorDescriptor_t,
+    RearrangeHint,
+    InfiniDeviceEnum,
 )
 
 
@@ -75,17 +77,44 @@ _TEST_CASES = [
         row_major_strides((3, 4, 50, 50, 5, 7)),  # x_stride
         column_major_strides((3, 4, 50, 50, 5, 7)),  # y_stride
     ),
+    # large units, big enough to take the streaming-store path by default
+    ((4, 1024, 1024), (1024 * 1024, 1024, 1), (1024, 4 * 1024, 1)),
 ]
 
 # Data types used for testing
 _TENSOR_DTYPES = [InfiniDtype.F16, InfiniDtype.F32]
 
+# Rearrange with dtype conversion: (shape, x_stride, y_stride, x_dtype), y dtype from _CAST_DTYPES
+_CAST_TEST_CASES_ = [
+    ((100, 100), (100, 1), (100, 1)),
+    ((4, 6, 64), (64, 4 * 64, 1), (6 * 64, 64, 1)),
+    ((2001, 2001), (1, 2001), (2001, 1)),
+    (
+        (3, 4, 7, 53, 9),
+        row_major_strides((3, 4, 7, 53, 9)),
+        column_major_strides((3, 4, 7, 53, 9)),
+    ),
+]
+_CAST_DTYPES = [InfiniDtype.F16, InfiniDtype.BF16, InfiniDtype.F32]
+_CAST_TEST_CASES = [
+    test_case + (x_dtype,)
+    for test_case in _CAST_TEST_CASES_
+    for x_dtype in _CAST_DTYPES
+]
+
 # Tolerance map for different data types
 _TOLERANCE_MAP = {
     InfiniDtype.F16: {"atol": 0, "rtol": 0},
     InfiniDtype.F32: {"atol": 0, "rtol": 0},
 }
 
+# Conversions round differently from torch, allow one unit in the last place
+_CAST_TOLERANCE_MAP = {
+    InfiniDtype.F16: {"atol": 0, "rtol": 1e-3},
+    InfiniDtype.BF16: {"atol": 0, "rtol": 8e-3},
+    InfiniDtype.F32: {"atol": 0, "rtol": 0},
+}
+
 DEBUG = False
 PROFILE = False
 NUM_PRERUN = 10
@@ -134,6 +163,18 @@ def test(
         debug(y.actual_tensor(), y.torch_tensor(), atol=atol, rtol=rtol)
     assert torch.allclose(y.actual_tensor(), y.torch_tensor(), atol=atol, rtol=rtol)
 
+    # Explicit store hints must not change the result
+    for hint in [RearrangeHint.STREAMING, RearrangeHint.CACHED]:
+        check_error(LIBINFINIOP.infiniopSetRearrangeHint(descriptor, hint))
+        y.actual_tensor().zero_()
+        lib_rearrange()
+        assert torch.allclose(
+            y.actual_tensor(), y.torch_tensor(), atol=atol, rtol=rtol
+        )
+    check_error(
+        LIBINFINIOP.infiniopSetRearrangeHint(descriptor, RearrangeHint.DEFAULT)
+    )
+
     # Profiling workflow
     if PROFILE:
         # fmt: off
@@ -144,6 +185,49 @@ def test(
     check_error(LIBINFINIOP.infiniopDestroyRearrangeDescriptor(descriptor))
 
 
+def test_cast(
+    handle,
+    device,
+    shape,
+    x_stride,
+    y_stride,
+    x_dtype,
+    dtype=InfiniDtype.F16,
+    sync=None,
+):
+    print(
+        f"Testing Rearrange with cast on {InfiniDeviceNames[device]} with shape:{shape} x_stride:{x_stride} y_stride:{y_stride} "
+        f"dtype:{InfiniDtypeNames[x_dtype]}->{InfiniDtypeNames[dtype]}"
+    )
+
+    x = TestTensor(shape, x_stride, x_dtype, device)
+    y = TestTensor(shape, y_stride, dtype, device, mode="ones")
+
+    rearrange_torch(y.torch_tensor(), x.torch_tensor(), shape, y_stride)
+
+    if sync is not None:
+        sync()
+
+    descriptor = infiniopOperatorDescriptor_t()
+    check_error(
+        LIBINFINIOP.infiniopCreateRearrangeDescriptor(
+            handle, ctypes.byref(descriptor), y.descriptor, x.descriptor
+        )
+    )
+
+    for tensor in [x, y]:
+        tensor.destroy_desc()
+
+    check_error(LIBINFINIOP.infiniopRearrange(descriptor, y.data(), x.data(), None))
+
+    atol, rtol = get_tolerance(_CAST_TOLERANCE_MAP, dtype)
+    if DEBUG:
+        debug(y.actual_tensor(), y.torch_tensor(), atol=atol, rtol=rtol)
+    assert torch.allclose(y.actual_tensor(), y.torch_tensor(), atol=atol, rtol=rtol)
+
+    check_error(LIBINFINIOP.infiniopDestroyRearrangeDescriptor(descriptor))
+
+
 if __name__ == "__main__":
     args = get_args()
     # Configure testing options
@@ -155,5 +239,8 @@ if __name__ == "__main__":
     # Execute tests
     for device in get_test_devices(args):
         test_operator(device, test, _TEST_CASES, _TENSOR_DTYPES)
+        # Conversion during rearrange is only implemented on CPU
+        if device == InfiniDeviceEnum.CPU:
+            test_operator(device, test_cast, _CAST_TEST_CASES, _CAST_DTYPES)
 
     print("\033[92mTest passed!\033[0m")
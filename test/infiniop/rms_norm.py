@@ -15,6 +15,7 @@ from libinfiniop import (
     InfiniDtype,
     InfiniDtypeNames,
     InfiniDeviceNames,
+    InfiniDeviceEnum,
     infiniopOperatorDescriptor_t,
 )
 
@@ -30,6 +31,10 @@ _TEST_CASES_ = [
     ((16, 2048), (16, 2048), (2048,), None, None),
     ((16, 2048), (16, 2048), (2048,), (4096, 1), (4096, 1)),
     ((16, 2048), (16, 2048), (2048,), (4096, 1), (4096, 1)),
+    # N-D 输入，前面的维度合并为行
+    ((2, 4, 2048), (2, 4, 2048), (2048,), None, None),
+    # 行少而宽
+    ((1, 32768), (1, 32768), (32768,), None, None),
 ]
 
 # w (weight) types
@@ -43,6 +48,16 @@ _TEST_CASES = [
     test_case + (w_dtype,) for test_case in _TEST_CASES_ for w_dtype in _WEIGHT_DTYPES
 ]
 
+# 行维不能合并、保持多于二维的输入目前只有 CPU 实现
+_CPU_TEST_CASES_ = [
+    ((2, 4, 512), (2, 4, 512), (512,), None, (8192, 1024, 1)),
+]
+_CPU_TEST_CASES = [
+    test_case + (w_dtype,)
+    for test_case in _CPU_TEST_CASES_
+    for w_dtype in _WEIGHT_DTYPES
+]
+
 # Tolerance map for different data types
 _TOLERANCE_MAP = {
     InfiniDtype.F16: {"atol": 2e-3, "rtol": 2e-3},
@@ -158,5 +173,7 @@ if __name__ == "__main__":
     # Execute tests
     for device in get_test_devices(args):
         test_operator(device, test, _TEST_CASES, _TENSOR_DTYPES)
+        if device == InfiniDeviceEnum.CPU:
+            test_operator(device, test, _CPU_TEST_CASES, _TENSOR_DTYPES)
 
     print("\033[92mTest passed!\033[0m")
@@ -0,0 +1,178 @@
+import torch
+import ctypes
+from ctypes import c_uint64
+from libinfiniop import (
+    LIBINFINIOP,
+    TestTensor,
+    get_test_devices,
+    check_error,
+    test_operator,
+    get_args,
+    debug,
+    get_tolerance,
+    profile_operation,
+    TestWorkspace,
+    InfiniDtype,
+    InfiniDtypeNames,
+    InfiniDeviceNames,
+    infiniopOperatorDescriptor_t,
+)
+
+# ==============================================================================
+#  Configuration (Internal Use Only)
+# ==============================================================================
+# These are not meant to be imported from other modules
+_TEST_CASES_ = [
+    # shape, x_stride, y_stride
+    ((1, 4), None, None),
+    ((16, 2048), None, None),
+    ((16, 2048), (4096, 1), None),
+    ((16, 2048), (4096, 1), (4096, 1)),
+    ((5, 4095), None, None),
+]
+
+# w (weight) types
+# Note: 'None' means the same as input dtype
+_WEIGHT_DTYPES = [None, InfiniDtype.F32]
+# y (quantized output) types
+_QUANT_DTYPES = [InfiniDtype.I8, InfiniDtype.F8]
+# x types used for testing
+_TENSOR_DTYPES = [InfiniDtype.F16, InfiniDtype.BF16, InfiniDtype.F32]
+
+_TEST_CASES = [
+    test_case + (w_dtype, q_dtype)
+    for test_case in _TEST_CASES_
+    for w_dtype in _WEIGHT_DTYPES
+    for q_dtype in _QUANT_DTYPES
+]
+
+# 量化类型能表示的最大绝对值
+_QUANT_MAX = {
+    InfiniDtype.I8: 127.0,
+    InfiniDtype.F8: 448.0,
+}
+
+# 反量化结果的误差上限，以量化步长（scale）为单位
+_QUANT_STEP_TOLERANCE = {
+    InfiniDtype.I8: 0.5,
+    InfiniDtype.F8: 16.0,
+}
+
+DEBUG = False
+PROFILE = False
+NUM_PRERUN = 10
+NUM_ITERATIONS = 1000
+
+
+def rms_norm_quant(x, w, eps, q_dtype):
+    x = x.to(torch.float32)
+    n = x * torch.rsqrt(torch.mean(x * x, dim=-1, keepdim=True) + eps)
+    n = n * w.to(torch.float32)
+    absmax = n.abs().amax(dim=-1)
+    scale = torch.where(absmax > 0, absmax / _QUANT_MAX[q_dtype], 1.0)
+    return n, scale
+
+
+def test(
+    handle,
+    device,
+    shape,
+    x_stride,
+    y_stride,
+    w_dtype=InfiniDtype.F32,
+    q_dtype=InfiniDtype.I8,
+    dtype=InfiniDtype.F16,
+    sync=None,
+):
+    w_dtype = w_dtype if w_dtype else dtype
+    print(
+        f"Testing RMSNormQuant on {InfiniDeviceNames[device]} with shape:{shape} x_stride:{x_stride} y_stride:{y_stride}"
+        f" w_dtype:{InfiniDtypeNames[w_dtype]} q_dtype:{InfiniDtypeNames[q_dtype]} dtype:{InfiniDtypeNames[dtype]}"
+    )
+
+    y = TestTensor(shape, y_stride, q_dtype, device, mode="zeros")
+    scale = TestTensor(shape[:1], None, InfiniDtype.F32, device, mode="zeros")
+    x = TestTensor(shape, x_stride, dtype, device, scale=0.01)
+    w = TestTensor(shape[-1:], None, w_dtype, device)
+
+    eps = 1e-6
+    ans, ans_scale = rms_norm_quant(x.torch_tensor(), w.torch_tensor(), eps, q_dtype)
+
+    if sync is not None:
+        sync()
+
+    descriptor = infiniopOperatorDescriptor_t()
+
+    check_error(
+        LIBINFINIOP.infiniopCreateRMSNormQuantDescriptor(
+            handle,
+            ctypes.byref(descriptor),
+            y.descriptor,
+            scale.descriptor,
+            x.descriptor,
+            w.descriptor,
+            eps,
+        )
+    )
+
+    # Invalidate the shape and strides in the descriptor to prevent them from being directly used by the kernel
+    for tensor in [y, scale, x, w]:
+        tensor.destroy_desc()
+
+    workspace_size = c_uint64(0)
+    check_error(
+        LIBINFINIOP.infiniopGetRMSNormQuantWorkspaceSize(
+            descriptor, ctypes.byref(workspace_size)
+        )
+    )
+    workspace = TestWorkspace(workspace_size.value, y.device)
+
+    def lib_rms_norm_quant():
+        check_error(
+            LIBINFINIOP.infiniopRMSNormQuant(
+                descriptor,
+                workspace.data(),
+                workspace_size.value,
+                y.data(),
+                scale.data(),
+                x.data(),
+                w.data(),
+                None,
+            )
+        )
+
+    lib_rms_norm_quant()
+
+    # 缩放因子取自归一化结果的行最大值，反量化的误差不超过量化步长的给定倍数
+    actual_scale = scale.actual_tensor()
+    dequantized = y.actual_tensor().to(torch.float32) * actual_scale.unsqueeze(-1)
+    atol = _QUANT_STEP_TOLERANCE[q_dtype] * actual_scale.unsqueeze(-1)
+    if DEBUG:
+        debug(actual_scale, ans_scale, atol=0, rtol=1e-3)
+        debug(dequantized, ans, atol=atol.max().item(), rtol=0)
+    assert torch.allclose(actual_scale, ans_scale, atol=0, rtol=1e-3)
+    assert torch.all((dequantized - ans).abs() <= atol * (1 + 1e-3))
+
+    # Profiling workflow
+    if PROFILE:
+        # fmt: off
+        profile_operation("PyTorch", lambda: rms_norm_quant(x.torch_tensor(), w.torch_tensor(), eps, q_dtype), device, NUM_PRERUN, NUM_ITERATIONS)
+        profile_operation("    lib", lambda: lib_rms_norm_quant(), device, NUM_PRERUN, NUM_ITERATIONS)
+        # fmt: on
+    check_error(LIBINFINIOP.infiniopDestroyRMSNormQuantDescriptor(descriptor))
+
+
+if __name__ == "__main__":
+    args = get_args()
+
+    # Configure testing options
+    DEBUG = args.debug
+    PROFILE = args.profile
+    NUM_PRERUN = args.num_prerun
+    NUM_ITERATIONS = args.num_iterations
+
+    # Execute tests
+    for device in get_test_devices(args):
+        test_operator(device, test, _TEST_CASES, _TENSOR_DTYPES)
+
+    print("\033[92mTest passed!\033[0m")
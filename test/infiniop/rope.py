@@ -17,7 +17,10 @@ from libinfiniop import (
     InfiniDeviceEnum,
     InfiniDeviceNames,
     infiniopOperatorDescriptor_t,
+    RoPEAlgo,
+    RoPEScaling,
 )
+import math
 from enum import Enum, auto
 
 # ==============================================================================
@@ -62,6 +65,25 @@ _TEST_CASES = [
     for inplace_item in _INPLACE
 ]
 
+# 不传 sin/cos 表、由 theta 在核函数内计算旋转角的用例
+_THETA_TEST_CASES = [
+    # (shape, pos_start, theta, scaling)
+    ((10, 32, 64), 0, 1e4, None),
+    ((4, 8, 128), 100000, 5e5, None),
+    ((7, 4, 128), 5000, 1e4, (RoPEScaling.LINEAR, 4.0, 0)),
+    ((7, 4, 128), 5000, 1e4, (RoPEScaling.NTK, 8.0, 0)),
+    ((7, 4, 128), 50000, 1e4, (RoPEScaling.YARN, 16.0, 4096)),
+]
+
+# GPT-NeoX 布局的用例
+_NEOX_TEST_CASES = [
+    # (shape, x_strides, y_strides, use_table)
+    ((10, 32, 64), None, None, True),
+    ((3, 32, 128), (8000, 200, 1), (7000, 128, 1), True),
+    ((1, 2, 256), None, None, True),
+    ((10, 32, 64), None, None, False),
+]
+
 DEBUG = False
 PROFILE = False
 NUM_PRERUN = 10
@@ -91,6 +113,17 @@ def rotary_embedding(ans, t, sin, cos, device):
     ans[..., 1::2] = t_out_odd.to(dt)
 
 
+def rotary_embedding_neox(ans, t, sin, cos):
+    dh = t.shape[2]
+    dt = t.dtype
+    t_first = t[..., : dh // 2].float()
+    t_second = t[..., dh // 2 :].float()
+    cos = cos.float().unsqueeze(1)
+    sin = sin.float().unsqueeze(1)
+    ans[..., : dh // 2] = (t_first * cos - t_second * sin).to(dt)
+    ans[..., dh // 2 :] = (t_first * sin + t_second * cos).to(dt)
+
+
 def sin_cos_table(pos, dim, device, theta, dtype):
     assert dim % 2 == 0, "Embedding dimension must be even."
     freqs = 1.0 / (theta ** (torch.arange(0, dim, 2)[: (dim // 2)].float() / dim))
@@ -101,6 +134,38 @@ def sin_cos_table(pos, dim, device, theta, dtype):
     )
 
 
+def inv_freq_and_attention_factor(dim, theta, scaling):
+    """与 HuggingFace transformers 中各 rope_init_fn 一致的频率计算"""
+    type_, factor, original_max_position_embeddings = scaling or (
+        RoPEScaling.NONE,
+        1.0,
+        0,
+    )
+    base = theta
+    if type_ == RoPEScaling.NTK:
+        base = theta * factor ** (dim / (dim - 2))
+    inv_freq = 1.0 / (base ** (torch.arange(0, dim, 2, dtype=torch.float64) / dim))
+    attention_factor = 1.0
+    if type_ == RoPEScaling.LINEAR:
+        inv_freq = inv_freq / factor
+    elif type_ == RoPEScaling.YARN:
+
+        def correction_dim(num_rotations):
+            return (
+                dim
+                * math.log(original_max_position_embeddings / (num_rotations * 2 * math.pi))
+            ) / (2 * math.log(base))
+
+        low = max(math.floor(correction_dim(32)), 0)
+        high = min(math.ceil(correction_dim(1)), dim - 1)
+        if low == high:
+            high += 0.001
+        ramp = ((torch.arange(dim // 2, dtype=torch.float64) - low) / (high - low)).clamp(0, 1)
+        inv_freq = inv_freq / factor * ramp + inv_freq * (1 - ramp)
+        attention_factor = 0.1 * math.log(factor) + 1.0
+    return inv_freq, attention_factor
+
+
 def test(
     handle,
     device,
@@ -211,6 +276,183 @@ def test(
     check_error(LIBINFINIOP.infiniopDestroyRoPEDescriptor(descriptor))
 
 
+def test_theta(
+    handle,
+    device,
+    shape,
+    pos_start,
+    theta,
+    scaling,
+    dtype=torch.float32,
+    sync=None,
+):
+    print(
+        f"Testing RoPE with theta on {InfiniDeviceNames[device]} with shape:{shape} pos_start:{pos_start} theta:{theta} scaling:{scaling} dtype:{InfiniDtypeNames[dtype]}"
+    )
+    x = TestTensor(shape, None, dtype, device)
+    y = TestTensor(shape, None, dtype, device)
+    pos = TestTensor.from_torch(
+        torch.arange(pos_start, pos_start + shape[0]), InfiniDtype.I64, device
+    )
+
+    inv_freq, attention_factor = inv_freq_and_attention_factor(shape[2], theta, scaling)
+    angles = torch.outer(pos.torch_tensor().cpu().double(), inv_freq)
+    rotary_embedding(
+        y.torch_tensor(),
+        x.torch_tensor(),
+        (torch.sin(angles) * attention_factor).to(x.torch_tensor().device),
+        (torch.cos(angles) * attention_factor).to(x.torch_tensor().device),
+        device,
+    )
+
+    if sync is not None:
+        sync()
+
+    scaling_ = None
+    if scaling is not None:
+        scaling_ = RoPEScaling(scaling[0], scaling[1], scaling[2], 0.0, 0.0, 0.0)
+
+    descriptor = infiniopOperatorDescriptor_t()
+    check_error(
+        LIBINFINIOP.infiniopCreateRoPEThetaDescriptor(
+            handle,
+            ctypes.byref(descriptor),
+            y.descriptor,
+            x.descriptor,
+            pos.descriptor,
+            theta,
+            ctypes.byref(scaling_) if scaling_ is not None else None,
+        )
+    )
+
+    # Invalidate the shape and strides in the descriptor to prevent them from being directly used by the kernel
+    for tensor in [y, x, pos]:
+        tensor.destroy_desc()
+
+    workspace_size = c_uint64(0)
+    check_error(
+        LIBINFINIOP.infiniopGetRoPEWorkspaceSize(
+            descriptor, ctypes.byref(workspace_size)
+        )
+    )
+    workspace = TestWorkspace(workspace_size.value, x.device)
+
+    check_error(
+        LIBINFINIOP.infiniopRoPE(
+            descriptor,
+            workspace.data(),
+            workspace_size.value,
+            y.data(),
+            x.data(),
+            pos.data(),
+            None,
+            None,
+            None,
+        )
+    )
+
+    if sync is not None:
+        sync()
+
+    atol, rtol = get_tolerance(_TOLERANCE_MAP, dtype)
+    if DEBUG:
+        debug(y.actual_tensor(), y.torch_tensor(), atol=atol, rtol=rtol)
+    assert torch.allclose(y.actual_tensor(), y.torch_tensor(), atol=atol, rtol=rtol)
+
+    check_error(LIBINFINIOP.infiniopDestroyRoPEDescriptor(descriptor))
+
+
+def test_neox(
+    handle,
+    device,
+    shape,
+    x_strides,
+    y_strides,
+    use_table,
+    dtype=torch.float32,
+    sync=None,
+):
+    print(
+        f"Testing RoPE with GPT-NeoX layout on {InfiniDeviceNames[device]} with shape:{shape} x_strides:{x_strides} y_strides:{y_strides} use_table:{use_table} dtype:{InfiniDtypeNames[dtype]}"
+    )
+    x = TestTensor(shape, x_strides, dtype, device)
+    y = TestTensor(shape, y_strides, dtype, device)
+    theta = 1e4
+    pos = TestTensor.from_torch(torch.arange(0, x.shape[0]), InfiniDtype.I32, device)
+    sin_table, cos_table = sin_cos_table(
+        pos.torch_tensor(), x.shape[2], x.device, theta, dtype
+    )
+    rotary_embedding_neox(
+        y.torch_tensor(),
+        x.torch_tensor(),
+        sin_table.torch_tensor(),
+        cos_table.torch_tensor(),
+    )
+
+    if sync is not None:
+        sync()
+
+    descriptor = infiniopOperatorDescriptor_t()
+    check_error(
+        LIBINFINIOP.infiniopCreateRoPEExDescriptor(
+            handle,
+            ctypes.byref(descriptor),
+            y.descriptor,
+            x.descriptor,
+            pos.descriptor,
+            sin_table.descriptor if use_table else None,
+            cos_table.descriptor if use_table else None,
+            theta,
+            None,
+            RoPEAlgo.GPT_NEOX,
+        )
+    )
+
+    # Invalidate the shape and strides in the descriptor to prevent them from being directly used by the kernel
+    for tensor in [y, x, pos, sin_table, cos_table]:
+        tensor.destroy_desc()
+
+    workspace_size = c_uint64(0)
+    check_error(
+        LIBINFINIOP.infiniopGetRoPEWorkspaceSize(
+            descriptor, ctypes.byref(workspace_size)
+        )
+    )
+    workspace = TestWorkspace(workspace_size.value, x.device)
+
+    def lib_rope():
+        check_error(
+            LIBINFINIOP.infiniopRoPE(
+                descriptor,
+                workspace.data(),
+                workspace_size.value,
+                y.data(),
+                x.data(),
+                pos.data(),
+                sin_table.data() if use_table else None,
+                cos_table.data() if use_table else None,
+                None,
+            )
+        )
+
+    lib_rope()
+
+    if sync is not None:
+        sync()
+
+    atol, rtol = get_tolerance(_TOLERANCE_MAP, dtype)
+    if DEBUG:
+        debug(y.actual_tensor(), y.torch_tensor(), atol=atol, rtol=rtol)
+    assert torch.allclose(y.actual_tensor(), y.torch_tensor(), atol=atol, rtol=rtol)
+
+    if PROFILE:
+        profile_operation(
+            "    lib", lambda: lib_rope(), device, NUM_PRERUN, NUM_ITERATIONS
+        )
+
+    check_error(LIBINFINIOP.infiniopDestroyRoPEDescriptor(descriptor))
+
+
 if __name__ == "__main__":
     args = get_args()
 
@@ -223,5 +465,9 @@ if __name__ == "__main__":
     # Execute tests
     for device in get_test_devices(args):
         test_operator(device, test, _TEST_CASES, _TENSOR_DTYPES)
+        # 由 theta 计算旋转角和 GPT-NeoX 布局目前只有 CPU 实现
+        if device == InfiniDeviceEnum.CPU:
+            test_operator(device, test_theta, _THETA_TEST_CASES, _TENSOR_DTYPES)
+            test_operator(device, test_neox, _NEOX_TEST_CASES, _TENSOR_DTYPES)
 
     print("\033[92mTest passed!\033[0m")
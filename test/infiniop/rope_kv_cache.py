@@ -0,0 +1,221 @@
+import torch
+import ctypes
+from ctypes import c_uint64
+from libinfiniop import (
+    LIBINFINIOP,
+    TestTensor,
+    get_test_devices,
+    check_error,
+    test_operator,
+    get_args,
+    debug,
+    get_tolerance,
+    profile_operation,
+    TestWorkspace,
+    InfiniDtype,
+    InfiniDtypeNames,
+    InfiniDeviceNames,
+    infiniopOperatorDescriptor_t,
+    RoPEAlgo,
+)
+
+# ==============================================================================
+#  Configuration (Internal Use Only)
+# ==============================================================================
+# These are not meant to be imported from other modules
+_TEST_CASES = [
+    # (seq_len, n_q_head, n_kv_head, head_dim, pos, cache_len, q_strides)
+    # prefill
+    (7, 32, 8, 128, 0, 64, None),
+    (5, 8, 8, 64, 0, 16, (1024, 64, 1)),
+    # decode
+    (1, 32, 8, 128, 37, 64, None),
+    (1, 12, 4, 32, 3, 8, (800, 64, 1)),
+]
+
+# 不传 sin/cos 表由 theta 计算旋转角，以及 GPT-NeoX 的配对方式
+_EX_TEST_CASES = [
+    # (seq_len, n_q_head, n_kv_head, head_dim, pos, cache_len, q_strides, algo, use_table)
+    (7, 32, 8, 128, 0, 64, None, RoPEAlgo.GPT_NEOX, True),
+    (1, 12, 4, 32, 3, 8, (800, 64, 1), RoPEAlgo.GPT_NEOX, True),
+    (7, 32, 8, 128, 0, 64, None, RoPEAlgo.GPT_J, False),
+    (1, 32, 8, 128, 37, 64, None, RoPEAlgo.GPT_NEOX, False),
+]
+
+# Data types used for testing
+_TENSOR_DTYPES = [InfiniDtype.F16, InfiniDtype.BF16, InfiniDtype.F32]
+
+# Tolerance map for different data types
+_TOLERANCE_MAP = {
+    InfiniDtype.F16: {"atol": 1e-3, "rtol": 1e-2},
+    InfiniDtype.BF16: {"atol": 5e-3, "rtol": 5e-2},
+    InfiniDtype.F32: {"atol": 1e-4, "rtol": 1e-3},
+}
+
+DEBUG = False
+PROFILE = False
+NUM_PRERUN = 10
+NUM_ITERATIONS = 1000
+
+
+def rotary_embedding(t, sin, cos, algo=RoPEAlgo.GPT_J):
+    # t: [seq_len, n_head, head_dim], sin/cos: [seq_len, head_dim // 2]
+    dt = t.dtype
+    if algo == RoPEAlgo.GPT_NEOX:
+        half = t.shape[-1] // 2
+        first, second = slice(0, half), slice(half, None)
+    else:
+        first, second = slice(0, None, 2), slice(1, None, 2)
+    t0 = t[..., first].float()
+    t1 = t[..., second].float()
+    cos = cos.float().unsqueeze(1)
+    sin = sin.float().unsqueeze(1)
+    ans = torch.empty_like(t)
+    ans[..., first] = (t0 * cos - t1 * sin).to(dt)
+    ans[..., second] = (t0 * sin + t1 * cos).to(dt)
+    return ans
+
+
+def sin_cos_table(table_len, dim, theta):
+    freqs = 1.0 / (theta ** (torch.arange(0, dim, 2).float() / dim))
+    angles = torch.outer(torch.arange(table_len).float(), freqs)
+    return torch.sin(angles), torch.cos(angles)
+
+
+def test(
+    handle,
+    device,
+    seq_len,
+    n_q_head,
+    n_kv_head,
+    head_dim,
+    pos,
+    cache_len,
+    q_strides=None,
+    algo=RoPEAlgo.GPT_J,
+    use_table=True,
+    dtype=InfiniDtype.F16,
+    sync=None,
+):
+    print(
+        f"Testing RoPEKVCache on {InfiniDeviceNames[device]} with seq_len:{seq_len} n_q_head:{n_q_head} n_kv_head:{n_kv_head} "
+        f"head_dim:{head_dim} pos:{pos} cache_len:{cache_len} q_strides:{q_strides} algo:{algo} use_table:{use_table} dtype:{InfiniDtypeNames[dtype]}"
+    )
+
+    q = TestTensor([seq_len, n_q_head, head_dim], q_strides, dtype, device)
+    k = TestTensor([seq_len, n_kv_head, head_dim], None, dtype, device)
+    v = TestTensor([seq_len, n_kv_head, head_dim], None, dtype, device)
+    k_cache = TestTensor([n_kv_head, cache_len, head_dim], None, dtype, device)
+    v_cache = TestTensor([n_kv_head, cache_len, head_dim], None, dtype, device)
+    pos_ids = TestTensor.from_torch(
+        torch.arange(pos, pos + seq_len), InfiniDtype.I32, device
+    )
+    theta = 1e4
+    sin, cos = sin_cos_table(cache_len, head_dim, theta)
+    if use_table:
+        sin_table = TestTensor.from_torch(sin, dtype, device)
+        cos_table = TestTensor.from_torch(cos, dtype, device)
+        sin, cos = sin_table.torch_tensor(), cos_table.torch_tensor()
+    else:
+        sin_table = cos_table = None
+
+    # 参考结果：旋转后的 q，以及写入新 k/v 后的缓存
+    sin_, cos_ = sin[pos : pos + seq_len], cos[pos : pos + seq_len]
+    q_ans = rotary_embedding(q.torch_tensor(), sin_, cos_, algo)
+    k_cache_ans = k_cache.torch_tensor().clone()
+    v_cache_ans = v_cache.torch_tensor().clone()
+    k_cache_ans[:, pos : pos + seq_len, :] = rotary_embedding(
+        k.torch_tensor(), sin_, cos_, algo
+    ).transpose(0, 1)
+    v_cache_ans[:, pos : pos + seq_len, :] = v.torch_tensor().transpose(0, 1)
+
+    if sync is not None:
+        sync()
+
+    descriptor = infiniopOperatorDescriptor_t()
+    check_error(
+        LIBINFINIOP.infiniopCreateRoPEKVCacheExDescriptor(
+            handle,
+            ctypes.byref(descriptor),
+            q.descriptor,
+            k.descriptor,
+            v.descriptor,
+            k_cache.descriptor,
+            v_cache.descriptor,
+            pos_ids.descriptor,
+            sin_table.descriptor if use_table else None,
+            cos_table.descriptor if use_table else None,
+            pos,
+            theta,
+            None,
+            algo,
+        )
+    )
+
+    # Invalidate the shape and strides in the descriptor to prevent them from being directly used by the kernel
+    for tensor in [q, k, v, k_cache, v_cache, pos_ids, sin_table, cos_table]:
+        if tensor is not None:
+            tensor.destroy_desc()
+
+    workspace_size = c_uint64(0)
+    check_error(
+        LIBINFINIOP.infiniopGetRoPEKVCacheWorkspaceSize(
+            descriptor, ctypes.byref(workspace_size)
+        )
+    )
+    workspace = TestWorkspace(workspace_size.value, q.device)
+
+    def lib_rope_kv_cache():
+        check_error(
+            LIBINFINIOP.infiniopRoPEKVCache(
+                descriptor,
+                workspace.data(),
+                workspace_size.value,
+                q.data(),
+                k.data(),
+                v.data(),
+                k_cache.data(),
+                v_cache.data(),
+                pos_ids.data(),
+                sin_table.data() if use_table else None,
+                cos_table.data() if use_table else None,
+                None,
+            )
+        )
+
+    lib_rope_kv_cache()
+
+    if sync is not None:
+        sync()
+
+    atol, rtol = get_tolerance(_TOLERANCE_MAP, dtype)
+    if DEBUG:
+        debug(q.actual_tensor(), q_ans, atol=atol, rtol=rtol)
+        debug(k_cache.actual_tensor(), k_cache_ans, atol=atol, rtol=rtol)
+    assert torch.allclose(q.actual_tensor(), q_ans, atol=atol, rtol=rtol)
+    assert torch.allclose(k_cache.actual_tensor(), k_cache_ans, atol=atol, rtol=rtol)
+    assert torch.equal(v_cache.actual_tensor(), v_cache_ans)
+
+    if PROFILE:
+        # q 在原地旋转，重复执行只影响数值，不影响耗时
+        # fmt: off
+        profile_operation("    lib", lambda: lib_rope_kv_cache(), device, NUM_PRERUN, NUM_ITERATIONS)
+        # fmt: on
+
+    check_error(LIBINFINIOP.infiniopDestroyRoPEKVCacheDescriptor(descriptor))
+
+
+if __name__ == "__main__":
+    args = get_args()
+
+    # Configure testing options
+    DEBUG = args.debug
+    PROFILE = args.profile
+    NUM_PRERUN = args.num_prerun
+    NUM_ITERATIONS = args.num_iterations
+
+    for device in get_test_devices(args):
+        test_operator(device, test, _TEST_CASES, _TENSOR_DTYPES)
+        test_operator(device, test, _EX_TEST_CASES, _TENSOR_DTYPES)
+
+    print("\033[92mTest passed!\033[0m")
@@ -0,0 +1,139 @@
+import torch
+import ctypes
+from libinfiniop import (
+    LIBINFINIOP,
+    TestTensor,
+    get_test_devices,
+    check_error,
+    test_operator,
+    get_args,
+    debug,
+    profile_operation,
+    InfiniDtype,
+    InfiniDtypeNames,
+    InfiniDeviceNames,
+    infiniopOperatorDescriptor_t,
+)
+
+# ==============================================================================
+#  Configuration (Internal Use Only)
+# ==============================================================================
+# These are not meant to be imported from other modules
+_TEST_CASES_ = [
+    # y_shape, y_stride, axis, n_indices
+    ((1000, 64), None, 0, 37),
+    # 把新的 K/V 写入 [n_kv_head, n_slot, head_dim] 缓存的任意槽位
+    ((8, 512, 128), None, 1, 3),
+    ((8, 512, 128), (128, 1024, 1), 1, 16),
+    ((4, 7, 5), (80, 10, 1), -1, 4),
+    ((4, 1 << 20), None, 0, 2),
+]
+
+_INDEX_DTYPES = [InfiniDtype.I32, InfiniDtype.I64]
+
+_TEST_CASES = [
+    test_case + (index_dtype,)
+    for test_case in _TEST_CASES_
+    for index_dtype in _INDEX_DTYPES
+]
+
+# Data types used for testing
+_TENSOR_DTYPES = [InfiniDtype.F16, InfiniDtype.BF16, InfiniDtype.F32]
+
+DEBUG = False
+PROFILE = False
+NUM_PRERUN = 10
+NUM_ITERATIONS = 1000
+
+
+def scatter(y, x, axis, indices):
+    y.index_copy_(axis, indices, x)
+
+
+def test(
+    handle,
+    device,
+    y_shape,
+    y_stride=None,
+    axis=0,
+    n_indices=1,
+    index_dtype=InfiniDtype.I32,
+    dtype=InfiniDtype.F16,
+    sync=None,
+):
+    print(
+        f"Testing Scatter on {InfiniDeviceNames[device]} with y_shape:{y_shape} y_stride:{y_stride} axis:{axis} "
+        f"n_indices:{n_indices} index_dtype:{InfiniDtypeNames[index_dtype]} dtype:{InfiniDtypeNames[dtype]}"
+    )
+
+    x_shape = list(y_shape)
+    x_shape[axis] = n_indices
+    x_shape = tuple(x_shape)
+
+    y = TestTensor(y_shape, y_stride, dtype, device)
+    x = TestTensor(x_shape, None, dtype, device)
+    # 索引不能重复
+    indices = TestTensor.from_torch(
+        torch.randperm(y_shape[axis])[:n_indices], index_dtype, device
+    )
+
+    scatter(y.torch_tensor(), x.torch_tensor(), axis, indices.torch_tensor().long())
+
+    if sync is not None:
+        sync()
+
+    descriptor = infiniopOperatorDescriptor_t()
+    check_error(
+        LIBINFINIOP.infiniopCreateScatterDescriptor(
+            handle,
+            ctypes.byref(descriptor),
+            y.descriptor,
+            x.descriptor,
+            indices.descriptor,
+            axis,
+        )
+    )
+
+    # Invalidate the shape and strides in the descriptor to prevent them from being directly used by the kernel
+    for tensor in [x, y, indices]:
+        tensor.destroy_desc()
+
+    def lib_scatter():
+        check_error(
+            LIBINFINIOP.infiniopScatter(
+                descriptor, y.data(), x.data(), indices.data(), None
+            )
+        )
+
+    lib_scatter()
+
+    if sync is not None:
+        sync()
+
+    if DEBUG:
+        debug(y.actual_tensor(), y.torch_tensor(), atol=0, rtol=0)
+    assert torch.equal(y.actual_tensor(), y.torch_tensor())
+
+    # Profiling workflow
+    if PROFILE:
+        # fmt: off
+        profile_operation("PyTorch", lambda: scatter(y.torch_tensor(), x.torch_tensor(), axis, indices.torch_tensor().long()), device, NUM_PRERUN, NUM_ITERATIONS)
+        profile_operation("    lib", lambda: lib_scatter(), device, NUM_PRERUN, NUM_ITERATIONS)
+        # fmt: on
+
+    check_error(LIBINFINIOP.infiniopDestroyScatterDescriptor(descriptor))
+
+
+if __name__ == "__main__":
+    args = get_args()
+
+    # Configure testing options
+    DEBUG = args.debug
+    PROFILE = args.profile
+    NUM_PRERUN = args.num_prerun
+    NUM_ITERATIONS = args.num_iterations
+
+    for device in get_test_devices(args):
+        test_operator(device, test, _TEST_CASES, _TENSOR_DTYPES)
+
+    print("\033[92mTest passed!\033[0m")
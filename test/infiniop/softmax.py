@@ -0,0 +1,194 @@
+import torch
+import ctypes
+from ctypes import c_uint64
+from libinfiniop import (
+    LIBINFINIOP,
+    TestTensor,
+    get_test_devices,
+    check_error,
+    test_operator,
+    get_args,
+    debug,
+    get_tolerance,
+    profile_operation,
+    TestWorkspace,
+    InfiniDtype,
+    InfiniDtypeNames,
+    InfiniDeviceNames,
+    infiniopOperatorDescriptor_t,
+)
+from enum import Enum, auto
+
+# ==============================================================================
+#  Configuration (Internal Use Only)
+# ==============================================================================
+# These are not meant to be imported from other modules
+_TEST_CASES_ = [
+    # shape, x_stride, axis, temperature, log
+    ((3, 3), None, -1, 1.0, False),
+    ((32, 512), None, -1, 1.0, False),
+    ((32, 512), (1024, 1), 1, 0.7, True),
+    ((32, 512), None, 0, 1.0, False),
+    ((4, 20, 512), None, 1, 1.0, True),
+    ((4, 20, 512), (20480, 512, 1), -1, 1.5, False),
+    # 少量长行，如对整个词表求概率
+    ((1, 151936), None, -1, 0.8, False),
+    ((2, 32000), None, -1, 1.0, True),
+]
+
+
+class Mask(Enum):
+    NONE = auto()
+    BOOL = auto()
+    ADDITIVE = auto()
+
+
+_MASKS = [Mask.NONE, Mask.BOOL, Mask.ADDITIVE]
+
+_TEST_CASES = [
+    test_case + (mask_item,) for test_case in _TEST_CASES_ for mask_item in _MASKS
+]
+
+# Data types used for testing
+_TENSOR_DTYPES = [InfiniDtype.F16, InfiniDtype.BF16, InfiniDtype.F32]
+
+# Tolerance map for different data types
+_TOLERANCE_MAP = {
+    InfiniDtype.F16: {"atol": 1e-3, "rtol": 1e-2},
+    InfiniDtype.BF16: {"atol": 5e-3, "rtol": 5e-2},
+    InfiniDtype.F32: {"atol": 1e-5, "rtol": 1e-5},
+}
+
+DEBUG = False
+PROFILE = False
+NUM_PRERUN = 10
+NUM_ITERATIONS = 1000
+
+
+def softmax(x, mask, axis, temperature, log):
+    type = x.dtype
+    logits = x.to(torch.float32) / temperature
+    if mask is not None:
+        if mask.dtype == torch.bool:
+            logits = logits.masked_fill(~mask, -torch.inf)
+        else:
+            logits = logits + mask.to(torch.float32)
+    if log:
+        ans = torch.nn.functional.log_softmax(logits, dim=axis)
+    else:
+        ans = torch.nn.functional.softmax(logits, dim=axis)
+    # 整行被掩盖时输出 0（log-softmax 为 -inf）
+    return ans.nan_to_num(nan=-torch.inf if log else 0.0).to(type)
+
+
+def test(
+    handle,
+    device,
+    shape,
+    x_stride=None,
+    axis=-1,
+    temperature=1.0,
+    log=False,
+    mask_type=Mask.NONE,
+    dtype=InfiniDtype.F16,
+    sync=None,
+):
+    print(
+        f"Testing Softmax on {InfiniDeviceNames[device]} with shape:{shape} x_stride:{x_stride} axis:{axis} temperature:{temperature} "
+        f"log:{log} mask:{mask_type} dtype:{InfiniDtypeNames[dtype]}"
+    )
+
+    x = TestTensor(shape, x_stride, dtype, device, scale=8.0, bias=-4.0)
+    y = TestTensor(shape, None, dtype, device, mode="zeros")
+    if mask_type == Mask.BOOL:
+        mask = TestTensor.from_torch(
+            torch.rand(shape) > 0.3, InfiniDtype.BOOL, device
+        )
+    elif mask_type == Mask.ADDITIVE:
+        mask = TestTensor(shape, None, dtype, device, scale=2.0, bias=-1.0)
+    else:
+        mask = None
+
+    ans = softmax(
+        x.torch_tensor(),
+        mask.torch_tensor() if mask is not None else None,
+        axis,
+        temperature,
+        log,
+    )
+
+    if sync is not None:
+        sync()
+
+    descriptor = infiniopOperatorDescriptor_t()
+    check_error(
+        LIBINFINIOP.infiniopCreateSoftmaxDescriptor(
+            handle,
+            ctypes.byref(descriptor),
+            y.descriptor,
+            x.descriptor,
+            mask.descriptor if mask is not None else None,
+            axis,
+            temperature,
+            log,
+        )
+    )
+
+    # Invalidate the shape and strides in the descriptor to prevent them from being directly used by the kernel
+    for tensor in [x, y] + ([mask] if mask is not None else []):
+        tensor.destroy_desc()
+
+    workspace_size = c_uint64(0)
+    check_error(
+        LIBINFINIOP.infiniopGetSoftmaxWorkspaceSize(
+            descriptor, ctypes.byref(workspace_size)
+        )
+    )
+    workspace = TestWorkspace(workspace_size.value, x.device)
+
+    def lib_softmax():
+        check_error(
+            LIBINFINIOP.infiniopSoftmax(
+                descriptor,
+                workspace.data(),
+                workspace_size.value,
+                y.data(),
+                x.data(),
+                mask.data() if mask is not None else None,
+                None,
+            )
+        )
+
+    lib_softmax()
+
+    if sync is not None:
+        sync()
+
+    atol, rtol = get_tolerance(_TOLERANCE_MAP, dtype)
+    if DEBUG:
+        debug(y.actual_tensor(), ans, atol=atol, rtol=rtol)
+    assert torch.allclose(y.actual_tensor(), ans, atol=atol, rtol=rtol)
+
+    # Profiling workflow
+    if PROFILE:
+        # fmt: off
+        profile_operation("PyTorch", lambda: softmax(x.torch_tensor(), mask.torch_tensor() if mask is not None else None, axis, temperature, log), device, NUM_PRERUN, NUM_ITERATIONS)
+        profile_operation("    lib", lambda: lib_softmax(), device, NUM_PRERUN, NUM_ITERATIONS)
+        # fmt: on
+
+    check_error(LIBINFINIOP.infiniopDestroySoftmaxDescriptor(descriptor))
+
+
+if __name__ == "__main__":
+    args = get_args()
+
+    # Configure testing options
+    DEBUG = args.debug
+    PROFILE = args.profile
+    NUM_PRERUN = args.num_prerun
+    NUM_ITERATIONS = args.num_iterations
+
+    for device in get_test_devices(args):
+        test_operator(device, test, _TEST_CASES, _TENSOR_DTYPES)
+
+    print("\033[92mTest passed!\033[0m")